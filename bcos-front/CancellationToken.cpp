@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cancellation of the inbound requests by their senders
+ * @file CancellationToken.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/CancellationToken.h>
+
+using namespace bcos;
+using namespace bcos::front;
+
+std::string CancellationRegistry::key(
+    const bcos::crypto::NodeIDPtr& _nodeID, const std::string& _uuid)
+{
+    auto const& data = _nodeID->data();
+    std::string key;
+    key.reserve(_uuid.size() + data.size());
+    key.append(_uuid);
+    key.append((const char*)data.data(), data.size());
+    return key;
+}
+
+CancellationToken::Ptr CancellationRegistry::add(
+    const bcos::crypto::NodeIDPtr& _nodeID, const std::string& _uuid, uint64_t _expireTime)
+{
+    auto token = std::make_shared<CancellationToken>();
+    auto now = utcSteadyTimeUs();
+    Guard l(x_tokens);
+    if (now >= m_nextSweepTime)
+    {
+        sweep(now);
+        m_nextSweepTime = now + SWEEP_INTERVAL;
+    }
+    m_tokens[key(_nodeID, _uuid)] = Entry{token, _expireTime};
+    m_size.store(m_tokens.size(), std::memory_order_relaxed);
+    return token;
+}
+
+bool CancellationRegistry::cancel(const bcos::crypto::NodeIDPtr& _nodeID, const std::string& _uuid)
+{
+    CancellationToken::Ptr token;
+    {
+        Guard l(x_tokens);
+        auto it = m_tokens.find(key(_nodeID, _uuid));
+        if (it == m_tokens.end())
+        {
+            return false;
+        }
+        token = it->second.token;
+        m_tokens.erase(it);
+        m_size.store(m_tokens.size(), std::memory_order_relaxed);
+    }
+    token->cancel();
+    return true;
+}
+
+void CancellationRegistry::remove(const bcos::crypto::NodeIDPtr& _nodeID, const std::string& _uuid)
+{
+    if (size() == 0)
+    {
+        return;
+    }
+    Guard l(x_tokens);
+    m_tokens.erase(key(_nodeID, _uuid));
+    m_size.store(m_tokens.size(), std::memory_order_relaxed);
+}
+
+void CancellationRegistry::clear()
+{
+    Guard l(x_tokens);
+    m_tokens.clear();
+    m_size.store(0, std::memory_order_relaxed);
+}
+
+void CancellationRegistry::sweep(uint64_t _now)
+{
+    for (auto it = m_tokens.begin(); it != m_tokens.end();)
+    {
+        if (it->second.expireTime <= _now)
+        {
+            it = m_tokens.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief cancellation of the inbound requests by their senders
+ * @file CancellationToken.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/crypto/KeyInterface.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace front
+{
+// checked by the cancellable dispatchers to abort the work of a cancelled request
+class CancellationToken
+{
+public:
+    using Ptr = std::shared_ptr<CancellationToken>;
+
+    bool cancelled() const { return m_cancelled.load(std::memory_order_acquire); }
+    void cancel() { m_cancelled.store(true, std::memory_order_release); }
+
+private:
+    std::atomic<bool> m_cancelled = {false};
+};
+
+/**
+ * tokens of the inbound requests of the cancellable modules, keyed by sender and uuid, removed
+ * when the request is responded, cancelled or expired
+ */
+class CancellationRegistry
+{
+public:
+    using Ptr = std::shared_ptr<CancellationRegistry>;
+
+    // tokens of the requests without deadline are kept for at most 60s
+    constexpr static uint64_t DEFAULT_EXPIRATION = 60 * 1000 * 1000;
+    // the expired tokens are swept at most once a second
+    constexpr static uint64_t SWEEP_INTERVAL = 1000 * 1000;
+
+    CancellationRegistry() = default;
+    CancellationRegistry(const CancellationRegistry&) = delete;
+    CancellationRegistry& operator=(const CancellationRegistry&) = delete;
+
+    /**
+     * @brief: register the token of a request
+     * @param _expireTime: steady time in microseconds the token can be dropped after
+     */
+    CancellationToken::Ptr add(
+        const bcos::crypto::NodeIDPtr& _nodeID, const std::string& _uuid, uint64_t _expireTime);
+
+    // cancel and remove the token, return false if not registered
+    bool cancel(const bcos::crypto::NodeIDPtr& _nodeID, const std::string& _uuid);
+
+    void remove(const bcos::crypto::NodeIDPtr& _nodeID, const std::string& _uuid);
+
+    size_t size() const { return m_size.load(std::memory_order_relaxed); }
+    void clear();
+
+private:
+    static std::string key(const bcos::crypto::NodeIDPtr& _nodeID, const std::string& _uuid);
+    // drop the expired tokens, called with x_tokens held
+    void sweep(uint64_t _now);
+
+    struct Entry
+    {
+        CancellationToken::Ptr token;
+        uint64_t expireTime;
+    };
+    mutable bcos::Mutex x_tokens;
+    std::unordered_map<std::string, Entry> m_tokens;
+    uint64_t m_nextSweepTime = 0;
+    // lets the response path skip the lock when no request is cancellable
+    std::atomic<size_t> m_size = {0};
+};
+}  // namespace front
+}  // namespace bcos
@@ -19,4 +19,27 @@
  */
 #pragma once
 
-#define FRONT_LOG(LEVEL) BCOS_LOG(LEVEL) << "[FrontService]"
\ No newline at end of file
+#define FRONT_LOG(LEVEL) BCOS_LOG(LEVEL) << "[FrontService]"
+
+#include <cstdint>
+
+namespace bcos
+{
+namespace front
+{
+// errors the front reports to the callbacks besides the CommonError ones
+enum FrontError : int32_t
+{
+    // the responder is overloaded and rejected the request
+    Overloaded = 1100,
+    // the peer left the node list or is unreachable before responding
+    PeerDisconnected = 1101,
+    // the circuit breaker of the peer is open, the request is not sent
+    CircuitOpen = 1102,
+    // the module is over its outbound rate limit, the request is not sent
+    RateLimited = 1103,
+    // the front holds more memory than its limit, the request is not sent
+    MemoryExhausted = 1104,
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief earliest-deadline-first queue of the inbound requests waiting for a dispatch thread
+ * @file DispatchQueue.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/DispatchQueue.h>
+
+using namespace bcos;
+using namespace bcos::front;
+
+void DispatchQueue::push(uint64_t _dueTime, uint64_t _deadline, Task _task, Task _onExpired)
+{
+    Guard l(x_tasks);
+    m_tasks.push(Item{_dueTime, _deadline, m_sequence++, std::move(_task), std::move(_onExpired)});
+}
+
+bool DispatchQueue::runOne()
+{
+    Item item;
+    {
+        Guard l(x_tasks);
+        if (m_tasks.empty())
+        {
+            return false;
+        }
+        // the top of priority_queue is const, the task is moved out before popping
+        item = std::move(const_cast<Item&>(m_tasks.top()));
+        m_tasks.pop();
+    }
+    if (item.deadline != NO_DEADLINE && utcSteadyTimeUs() >= item.deadline)
+    {
+        m_expired.fetch_add(1, std::memory_order_relaxed);
+        if (item.onExpired)
+        {
+            item.onExpired();
+        }
+        return true;
+    }
+    item.task();
+    return true;
+}
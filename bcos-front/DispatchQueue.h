@@ -0,0 +1,122 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief earliest-deadline-first queue of the inbound requests waiting for a dispatch thread
+ * @file DispatchQueue.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace bcos
+{
+namespace front
+{
+/**
+ * the thread pool runs one runOne() per pushed task, runOne() always takes the task with the
+ * earliest deadline and drops it without running if the deadline has passed. the tasks without
+ * a deadline are ordered as due the default deadline after their push, so the stream of the
+ * tasks with one can't starve them, but never dropped
+ */
+class DispatchQueue
+{
+public:
+    using Ptr = std::shared_ptr<DispatchQueue>;
+    using Task = std::function<void()>;
+
+    // deadline of the tasks without one
+    constexpr static uint64_t NO_DEADLINE = std::numeric_limits<uint64_t>::max();
+    constexpr static uint64_t DEFAULT_DEADLINE = 1000000;
+
+    DispatchQueue() = default;
+    DispatchQueue(const DispatchQueue&) = delete;
+    DispatchQueue& operator=(const DispatchQueue&) = delete;
+
+    /**
+     * @brief: queue a task
+     * @param _deadline: steady time in microseconds after which _task is useless, NO_DEADLINE
+     * if it never expires
+     * @param _onExpired: called instead of _task if the deadline has passed when dequeued
+     */
+    void push(uint64_t _deadline, Task _task, Task _onExpired)
+    {
+        push(dueTime(_deadline), _deadline, std::move(_task), std::move(_onExpired));
+    }
+    /**
+     * @brief: queue a task ordered by _dueTime but dropped only after _deadline, e.g. a batch
+     * due at the earliest deadline of its requests and useless after the latest one
+     */
+    void push(uint64_t _dueTime, uint64_t _deadline, Task _task, Task _onExpired);
+    // the time a task with _deadline is ordered at
+    uint64_t dueTime(uint64_t _deadline) const
+    {
+        return _deadline == NO_DEADLINE ? utcSteadyTimeUs() + defaultDeadline() : _deadline;
+    }
+
+    // run or drop the earliest deadline task, return false if the queue is empty
+    bool runOne();
+
+    size_t size() const
+    {
+        Guard l(x_tasks);
+        return m_tasks.size();
+    }
+    // number of tasks dropped for their deadline
+    uint64_t expired() const { return m_expired.load(std::memory_order_relaxed); }
+
+    // the time in microseconds after its push a task without deadline is ordered at
+    void setDefaultDeadline(uint64_t _defaultDeadline)
+    {
+        m_defaultDeadline.store(_defaultDeadline, std::memory_order_relaxed);
+    }
+    uint64_t defaultDeadline() const { return m_defaultDeadline.load(std::memory_order_relaxed); }
+
+private:
+    struct Item
+    {
+        // the order in the queue, the deadline or the implicit one
+        uint64_t dueTime;
+        uint64_t deadline;
+        // keeps the FIFO order between the tasks with the same deadline
+        uint64_t sequence;
+        Task task;
+        Task onExpired;
+    };
+    struct Later
+    {
+        bool operator()(const Item& _lhs, const Item& _rhs) const
+        {
+            if (_lhs.dueTime != _rhs.dueTime)
+            {
+                return _lhs.dueTime > _rhs.dueTime;
+            }
+            return _lhs.sequence > _rhs.sequence;
+        }
+    };
+
+    mutable bcos::Mutex x_tasks;
+    std::priority_queue<Item, std::vector<Item>, Later> m_tasks;
+    uint64_t m_sequence = 0;
+    std::atomic<uint64_t> m_expired = {0};
+    std::atomic<uint64_t> m_defaultDeadline = {DEFAULT_DEADLINE};
+};
+}  // namespace front
+}  // namespace bcos
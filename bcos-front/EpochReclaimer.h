@@ -0,0 +1,203 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief epoch based reclamation of the values published through atomic pointers
+ * @file EpochReclaimer.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace bcos
+{
+namespace front
+{
+/**
+ * the values are published as heap allocated shared_ptrs behind atomic pointers. A reader is
+ * counted in the current epoch, on a counter striped by thread, while it copies the shared_ptr
+ * out, so reading takes no lock. The writers, serialized by the owner, retire the replaced
+ * pointers instead of deleting them; each retire then frees the pointers retired before the
+ * previous epoch once no reader of that epoch is left, and moves to the next epoch.
+ */
+template <typename T>
+class EpochReclaimer
+{
+public:
+    using ValuePtr = std::shared_ptr<const T>;
+
+    // counters of the readers, a thread always counts on the same stripe
+    const static size_t READER_STRIPES = 16;
+
+    EpochReclaimer()
+    {
+        for (auto& stripe : m_readers)
+        {
+            stripe.count[0].store(0, std::memory_order_relaxed);
+            stripe.count[1].store(0, std::memory_order_relaxed);
+        }
+    }
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    ~EpochReclaimer()
+    {
+        for (auto& retired : m_retired)
+        {
+            delete retired.value;
+        }
+    }
+
+    // copy the value _slot points to, nullptr if it points to none
+    ValuePtr read(const std::atomic<const ValuePtr*>& _slot) const
+    {
+        auto& readers = m_readers[readerStripe()];
+        auto epoch = m_epoch.load(std::memory_order_seq_cst);
+        // counted in the epoch still current after the increment, a writer advancing meanwhile
+        // may have missed the increment
+        while (true)
+        {
+            readers.count[epoch & 1].fetch_add(1, std::memory_order_seq_cst);
+            auto current = m_epoch.load(std::memory_order_seq_cst);
+            if (current == epoch)
+            {
+                break;
+            }
+            readers.count[epoch & 1].fetch_sub(1, std::memory_order_release);
+            epoch = current;
+        }
+        // seq_cst against the exchange of the writers: either the writer sees the reader counted
+        // or the reader sees the new value
+        auto value = _slot.load(std::memory_order_seq_cst);
+        auto result = value ? *value : nullptr;
+        readers.count[epoch & 1].fetch_sub(1, std::memory_order_release);
+        return result;
+    }
+
+    // hand _old, exchanged out of its slot with seq_cst, over for reclamation, the writers must
+    // be serialized
+    void retire(const ValuePtr* _old)
+    {
+        if (_old)
+        {
+            m_retired.emplace_back(Retired{_old, m_epoch.load(std::memory_order_relaxed)});
+        }
+        reclaim();
+    }
+
+    // the replaced values not freed yet, the writers must be serialized with the call
+    size_t retired() const { return m_retired.size(); }
+
+private:
+    static size_t readerStripe()
+    {
+        static std::atomic<size_t> s_nextStripe = {0};
+        thread_local size_t stripe = s_nextStripe.fetch_add(1) % READER_STRIPES;
+        return stripe;
+    }
+
+    bool hasReaders(size_t _parity) const
+    {
+        for (auto const& stripe : m_readers)
+        {
+            if (stripe.count[_parity].load(std::memory_order_seq_cst) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void reclaim()
+    {
+        auto epoch = m_epoch.load(std::memory_order_relaxed);
+        // the readers of the new epoch can't reach the values retired before it
+        if (hasReaders((epoch - 1) & 1))
+        {
+            return;
+        }
+        auto it = std::remove_if(m_retired.begin(), m_retired.end(), [epoch](Retired& _retired) {
+            if (_retired.epoch >= epoch)
+            {
+                return false;
+            }
+            delete _retired.value;
+            return true;
+        });
+        m_retired.erase(it, m_retired.end());
+        m_epoch.store(epoch + 1, std::memory_order_seq_cst);
+    }
+
+    struct Retired
+    {
+        const ValuePtr* value;
+        // the epoch the value was replaced in
+        uint64_t epoch;
+    };
+    struct alignas(64) ReaderStripe
+    {
+        // the readers of the even and the odd epochs
+        std::atomic<uint64_t> count[2];
+    };
+
+    std::atomic<uint64_t> m_epoch = {1};
+    mutable std::array<ReaderStripe, READER_STRIPES> m_readers;
+    // the replaced values, may still be read
+    std::vector<Retired> m_retired;
+};
+
+/// a single value published for the lock free readers, e.g. the latest snapshot of a state
+template <typename T>
+class EpochSlot
+{
+public:
+    using ValuePtr = std::shared_ptr<const T>;
+
+    explicit EpochSlot(ValuePtr _value = nullptr)
+      : m_value(_value ? new ValuePtr(std::move(_value)) : nullptr)
+    {}
+    EpochSlot(const EpochSlot&) = delete;
+    EpochSlot& operator=(const EpochSlot&) = delete;
+
+    ~EpochSlot() { delete m_value.load(std::memory_order_relaxed); }
+
+    ValuePtr load() const { return m_reclaimer.read(m_value); }
+
+    void store(ValuePtr _value)
+    {
+        auto value = _value ? new ValuePtr(std::move(_value)) : nullptr;
+        Guard l(x_writer);
+        m_reclaimer.retire(m_value.exchange(value, std::memory_order_seq_cst));
+    }
+
+    // the replaced values not freed yet
+    size_t retired() const
+    {
+        Guard l(x_writer);
+        return m_reclaimer.retired();
+    }
+
+private:
+    std::atomic<const ValuePtr*> m_value;
+    mutable bcos::Mutex x_writer;
+    EpochReclaimer<T> m_reclaimer;
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,304 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief in-memory binary flight recorder for the front traffic
+ * @file FlightRecorder.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/Common.h>
+#include <bcos-front/FlightRecorder.h>
+#include <algorithm>
+#include <fstream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace bcos;
+using namespace bcos::front;
+
+namespace
+{
+struct DumpHeader
+{
+    uint32_t magic;
+    uint32_t recordSize;
+    uint64_t recordCount;
+    double ticksPerSecond;
+};
+
+inline void packRecord(const FlightRecord& _record, uint64_t* _words)
+{
+    _words[0] = _record.timestamp;
+    _words[1] = _record.requestID;
+    _words[2] = ((uint64_t)_record.size << 32) | (uint32_t)_record.peerIndex;
+    _words[3] = ((uint64_t)_record.moduleID << 48) | ((uint64_t)_record.event << 40) |
+                ((uint64_t)_record.reserved << 32) | _record.sequence;
+}
+
+inline void unpackRecord(const uint64_t* _words, FlightRecord& _record)
+{
+    _record.timestamp = _words[0];
+    _record.requestID = _words[1];
+    _record.size = (uint32_t)(_words[2] >> 32);
+    _record.peerIndex = (int32_t)(uint32_t)_words[2];
+    _record.moduleID = (uint16_t)(_words[3] >> 48);
+    _record.event = (FlightEvent)(uint8_t)(_words[3] >> 40);
+    _record.reserved = (uint8_t)(_words[3] >> 32);
+    _record.sequence = (uint32_t)_words[3];
+}
+}  // namespace
+
+FlightRecorder::FlightRecorder(size_t _capacity)
+{
+    size_t capacity = 1;
+    while (capacity < _capacity)
+    {
+        capacity <<= 1;
+    }
+    m_slots.reset(new Slot[capacity]);
+    m_mask = capacity - 1;
+    m_startTicks = timestamp();
+    m_startTime = std::chrono::steady_clock::now();
+}
+
+uint64_t FlightRecorder::timestamp()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+void FlightRecorder::record(FlightEvent _event, uint16_t _moduleID, int32_t _peerIndex,
+    uint64_t _requestID, uint32_t _size)
+{
+    auto ticket = m_next.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = m_slots[ticket & m_mask];
+
+    FlightRecord record;
+    record.timestamp = timestamp();
+    record.requestID = _requestID;
+    record.size = _size;
+    record.peerIndex = _peerIndex;
+    record.moduleID = _moduleID;
+    record.event = _event;
+    record.sequence = (uint32_t)ticket;
+    uint64_t words[4];
+    packRecord(record, words);
+
+    slot.sequence.store(2 * ticket + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+}
+
+std::vector<FlightRecord> FlightRecorder::snapshot() const
+{
+    auto end = m_next.load(std::memory_order_acquire);
+    auto begin = end > capacity() ? end - capacity() : 0;
+    std::vector<FlightRecord> records;
+    records.reserve(end - begin);
+    for (auto ticket = begin; ticket < end; ++ticket)
+    {
+        auto& slot = m_slots[ticket & m_mask];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * ticket + 2)
+        {
+            // being written or already overwritten
+            continue;
+        }
+        uint64_t words[4];
+        for (size_t i = 0; i < 4; ++i)
+        {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            continue;
+        }
+        FlightRecord record;
+        unpackRecord(words, record);
+        records.push_back(record);
+    }
+    return records;
+}
+
+double FlightRecorder::ticksPerSecond() const
+{
+#if defined(__x86_64__) || defined(__i386__)
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime);
+    auto ticks = timestamp() - m_startTicks;
+    if (elapsed.count() <= 0 || ticks == 0)
+    {
+        return 0;
+    }
+    return ticks / elapsed.count();
+#else
+    return 1e9;
+#endif
+}
+
+void FlightRecorder::dump(std::ostream& _out) const
+{
+    auto records = snapshot();
+    DumpHeader header;
+    header.magic = DUMP_MAGIC;
+    header.recordSize = sizeof(FlightRecord);
+    header.recordCount = records.size();
+    header.ticksPerSecond = ticksPerSecond();
+    _out.write((const char*)&header, sizeof(header));
+    for (auto const& record : records)
+    {
+        uint64_t words[4];
+        packRecord(record, words);
+        _out.write((const char*)words, sizeof(words));
+    }
+}
+
+bool FlightRecorder::dumpToFile(const std::string& _path) const
+{
+    std::ofstream out(_path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        FRONT_LOG(WARNING) << LOG_DESC("FlightRecorder dump failed") << LOG_KV("path", _path);
+        return false;
+    }
+    dump(out);
+    FRONT_LOG(INFO) << LOG_DESC("FlightRecorder dump") << LOG_KV("path", _path)
+                    << LOG_KV("written", written());
+    return true;
+}
+
+bool FlightRecorder::load(std::istream& _in, FlightDump& _dump)
+{
+    DumpHeader header;
+    if (!_in.read((char*)&header, sizeof(header)) || header.magic != DUMP_MAGIC ||
+        header.recordSize != sizeof(FlightRecord))
+    {
+        return false;
+    }
+    _dump.ticksPerSecond = header.ticksPerSecond;
+    _dump.records.clear();
+    for (uint64_t i = 0; i < header.recordCount; ++i)
+    {
+        uint64_t words[4];
+        if (!_in.read((char*)words, sizeof(words)))
+        {
+            return false;
+        }
+        FlightRecord record;
+        unpackRecord(words, record);
+        _dump.records.push_back(record);
+    }
+    return true;
+}
+
+std::map<uint64_t, std::vector<FlightRecord>> FlightRecorder::buildTimelines(
+    const std::vector<FlightRecord>& _records)
+{
+    std::map<uint64_t, std::vector<FlightRecord>> timelines;
+    for (auto const& record : _records)
+    {
+        if (record.requestID != 0)
+        {
+            timelines[record.requestID].push_back(record);
+        }
+    }
+    for (auto& timeline : timelines)
+    {
+        std::stable_sort(timeline.second.begin(), timeline.second.end(),
+            [](const FlightRecord& _lhs, const FlightRecord& _rhs) {
+                return _lhs.timestamp < _rhs.timestamp;
+            });
+    }
+    return timelines;
+}
+
+void FlightRecorder::setSlowRequestTrigger(
+    uint64_t _thresholdMs, uint64_t _minIntervalMs, SlowRequestTrigger _onSlowRequest)
+{
+    Guard l(x_slowRequest);
+    m_slowMinIntervalMs = _minIntervalMs;
+    m_onSlowRequest =
+        _onSlowRequest ? std::make_shared<const SlowRequestTrigger>(std::move(_onSlowRequest)) :
+                         nullptr;
+    m_slowThresholdMs.store(m_onSlowRequest ? _thresholdMs : 0, std::memory_order_release);
+}
+
+void FlightRecorder::onRequestFinished(uint64_t _elapsedMs, const FrontExecutor::Ptr& _executor)
+{
+    auto threshold = m_slowThresholdMs.load(std::memory_order_acquire);
+    if (threshold == 0 || _elapsedMs < threshold)
+    {
+        return;
+    }
+    std::shared_ptr<const SlowRequestTrigger> onSlowRequest;
+    uint64_t minInterval = 0;
+    {
+        Guard l(x_slowRequest);
+        onSlowRequest = m_onSlowRequest;
+        minInterval = m_slowMinIntervalMs;
+    }
+    if (!onSlowRequest)
+    {
+        return;
+    }
+    auto now = utcSteadyTime();
+    auto last = m_lastSlowTrigger.load(std::memory_order_relaxed);
+    if (last != 0 && now - last < minInterval)
+    {
+        return;
+    }
+    // only one thread triggers the dump
+    if (!m_lastSlowTrigger.compare_exchange_strong(last, now))
+    {
+        return;
+    }
+    FRONT_LOG(WARNING) << LOG_DESC("FlightRecorder slow request") << LOG_KV("elapsed", _elapsedMs)
+                       << LOG_KV("threshold", threshold);
+    // the trigger may dump the whole ring, keep it off the thread finishing the request
+    auto self = weak_from_this();
+    if (!_executor || self.expired())
+    {
+        (*onSlowRequest)(*this);
+        return;
+    }
+    _executor->enqueue([self, onSlowRequest]() {
+        auto recorder = self.lock();
+        if (recorder)
+        {
+            (*onSlowRequest)(*recorder);
+        }
+    });
+}
+
+uint64_t FlightRecorder::requestID(const std::string& _uuid)
+{
+    if (_uuid.empty())
+    {
+        return 0;
+    }
+    auto id = std::hash<std::string>()(_uuid);
+    return id == 0 ? 1 : id;
+}
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief in-memory binary flight recorder for the front traffic
+ * @file FlightRecorder.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/FrontExecutor.h>
+#include <atomic>
+#include <iosfwd>
+#include <map>
+
+namespace bcos
+{
+namespace front
+{
+enum class FlightEvent : uint8_t
+{
+    Send = 1,
+    Receive = 2,
+    DispatchStart = 3,
+    DispatchEnd = 4,
+    Response = 5,
+    Timeout = 6,
+    // inbound request dropped for its deadline
+    Expired = 7,
+    // inbound request rejected by the load shedder
+    Shed = 8,
+    // request cancelled by its sender
+    Cancel = 9,
+};
+
+/// one fixed size event record, 32 bytes
+struct FlightRecord
+{
+    // cpu timestamp counter, see FlightDump::ticksPerSecond
+    uint64_t timestamp = 0;
+    // hash of the request uuid, 0 for the messages without uuid
+    uint64_t requestID = 0;
+    // payload size
+    uint32_t size = 0;
+    // index of the peer in the nodeIDs snapshot, -1 if unknown
+    int32_t peerIndex = -1;
+    uint16_t moduleID = 0;
+    FlightEvent event = FlightEvent::Send;
+    uint8_t reserved = 0;
+    // low 32 bits of the write sequence
+    uint32_t sequence = 0;
+};
+
+/// the decoded content of a dump
+struct FlightDump
+{
+    double ticksPerSecond = 0;
+    std::vector<FlightRecord> records;
+};
+
+/**
+ * fixed size lock free ring of FlightRecord, the oldest records are overwritten.
+ * writers claim a slot with one fetch_add and publish it with a per-slot sequence, readers
+ * skip the slots being written, so recording never blocks nor allocates.
+ */
+class FlightRecorder : public std::enable_shared_from_this<FlightRecorder>
+{
+public:
+    using Ptr = std::shared_ptr<FlightRecorder>;
+
+    const static uint32_t DUMP_MAGIC = 0x31524642;  // "BFR1"
+
+    // _capacity is rounded up to a power of 2
+    explicit FlightRecorder(size_t _capacity = 1 << 16);
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    static uint64_t timestamp();
+
+    void record(FlightEvent _event, uint16_t _moduleID, int32_t _peerIndex, uint64_t _requestID,
+        uint32_t _size);
+
+    size_t capacity() const { return m_mask + 1; }
+    // number of records written since creation, including the overwritten ones
+    uint64_t written() const { return m_next.load(std::memory_order_relaxed); }
+
+    // the records currently in the ring, oldest first
+    std::vector<FlightRecord> snapshot() const;
+    // estimated timestamp ticks per second
+    double ticksPerSecond() const;
+
+    // write the binary dump: header followed by the records of snapshot()
+    void dump(std::ostream& _out) const;
+    bool dumpToFile(const std::string& _path) const;
+    static bool load(std::istream& _in, FlightDump& _dump);
+
+    // group the records by requestID, each timeline sorted by timestamp
+    static std::map<uint64_t, std::vector<FlightRecord>> buildTimelines(
+        const std::vector<FlightRecord>& _records);
+
+    using SlowRequestTrigger = std::function<void(FlightRecorder&)>;
+    /**
+     * call _onSlowRequest when a request takes more than _thresholdMs to get its response or
+     * times out, at most once every _minIntervalMs
+     */
+    void setSlowRequestTrigger(
+        uint64_t _thresholdMs, uint64_t _minIntervalMs, SlowRequestTrigger _onSlowRequest);
+    /**
+     * @brief: called by the front with the elapsed time of a finished request, the trigger runs
+     * as a task of _executor if the recorder is owned by a shared_ptr, inline otherwise
+     */
+    void onRequestFinished(uint64_t _elapsedMs, const FrontExecutor::Ptr& _executor = nullptr);
+
+    static uint64_t requestID(const std::string& _uuid);
+
+private:
+    struct Slot
+    {
+        // 2 * ticket + 1 while writing, 2 * ticket + 2 when published
+        std::atomic<uint64_t> sequence = {0};
+        std::atomic<uint64_t> words[4];
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask;
+    std::atomic<uint64_t> m_next = {0};
+
+    // for the timestamp calibration
+    uint64_t m_startTicks;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    // checked by every finished request, the trigger is only read by the slow ones
+    std::atomic<uint64_t> m_slowThresholdMs = {0};
+    std::atomic<uint64_t> m_lastSlowTrigger = {0};
+    mutable bcos::Mutex x_slowRequest;
+    uint64_t m_slowMinIntervalMs = 0;
+    std::shared_ptr<const SlowRequestTrigger> m_onSlowRequest;
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,247 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief capture the inbound frames into a memory-mapped trace file
+ * @file FrameCapture.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/libutilities/Exceptions.h>
+#include <bcos-front/Common.h>
+#include <bcos-front/FrameCapture.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::front;
+
+namespace
+{
+// record length(4) + frame length(4) + arrival time(8) + nodeID length(2)
+const size_t RECORD_HEADER_LENGTH = 18;
+
+inline uint64_t alignRecord(uint64_t _length)
+{
+    return (_length + 7) & ~(uint64_t)7;
+}
+}  // namespace
+
+FrameCapture::FrameCapture(const std::string& _path, size_t _capacity)
+  : m_path(_path), m_capacity(alignRecord(_capacity)), m_end(sizeof(FrameTraceHeader))
+{
+    if (m_capacity <= sizeof(FrameTraceHeader))
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("FrameCapture: capacity is too small"));
+    }
+    m_fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_fd < 0 || ::ftruncate(m_fd, m_capacity) != 0)
+    {
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+        }
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("FrameCapture: create file failed " + _path));
+    }
+    auto data = ::mmap(nullptr, m_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED)
+    {
+        ::close(m_fd);
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("FrameCapture: mmap failed " + _path));
+    }
+    m_data = (byte*)data;
+    m_startTime = std::chrono::steady_clock::now();
+
+    FrameTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = FrameTraceHeader::MAGIC;
+    header.version = FrameTraceHeader::VERSION;
+    header.startTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+    header.capacity = m_capacity;
+    header.end = sizeof(FrameTraceHeader);
+    memcpy(m_data, &header, sizeof(header));
+
+    FRONT_LOG(INFO) << LOG_DESC("FrameCapture start") << LOG_KV("path", _path)
+                    << LOG_KV("capacity", m_capacity);
+}
+
+FrameCapture::~FrameCapture()
+{
+    close();
+}
+
+bool FrameCapture::append(bytesConstRef _nodeID, bytesConstRef _frame)
+{
+    // seq_cst pairs with close(): either close sees this writer or this writer sees closed
+    m_writers.fetch_add(1);
+    if (m_closed.load())
+    {
+        m_writers.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+    auto length = RECORD_HEADER_LENGTH + _nodeID.size() + _frame.size();
+    auto alignedLength = alignRecord(length);
+    bool fits = _nodeID.size() <= std::numeric_limits<uint16_t>::max() &&
+                alignedLength <= std::numeric_limits<uint32_t>::max();
+    // the arrival time is taken between the load and the claim of the offset: a record claimed
+    // later loads the end after this claim, so the records are in the order of arrival
+    uint64_t offset = m_end.load(std::memory_order_acquire);
+    uint64_t arrivalTime = 0;
+    do
+    {
+        if (!fits || offset + alignedLength > m_capacity)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            m_writers.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+        arrivalTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_startTime)
+                          .count();
+    } while (!m_end.compare_exchange_weak(
+        offset, offset + alignedLength, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    auto record = m_data + offset;
+    uint32_t frameLength = _frame.size();
+    uint16_t nodeIDLength = _nodeID.size();
+    memcpy(record + 4, &frameLength, 4);
+    memcpy(record + 8, &arrivalTime, 8);
+    memcpy(record + 16, &nodeIDLength, 2);
+    memcpy(record + RECORD_HEADER_LENGTH, _nodeID.data(), _nodeID.size());
+    memcpy(record + RECORD_HEADER_LENGTH + _nodeID.size(), _frame.data(), _frame.size());
+    // publish the record by its length
+    __atomic_store_n((uint32_t*)record, (uint32_t)alignedLength, __ATOMIC_RELEASE);
+
+    m_captured.fetch_add(1, std::memory_order_relaxed);
+    m_writers.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void FrameCapture::close()
+{
+    if (m_closed.exchange(true))
+    {
+        return;
+    }
+    while (m_writers.load() > 0)
+    {
+        std::this_thread::yield();
+    }
+    uint64_t end = std::min<uint64_t>(m_end.load(), m_capacity);
+    // stop at the first hole left by the dropped records
+    uint64_t offset = sizeof(FrameTraceHeader);
+    while (offset + RECORD_HEADER_LENGTH <= end)
+    {
+        uint32_t length = 0;
+        memcpy(&length, m_data + offset, 4);
+        if (length == 0)
+        {
+            break;
+        }
+        offset += length;
+    }
+    ((FrameTraceHeader*)m_data)->end = offset;
+    ::msync(m_data, m_capacity, MS_SYNC);
+    ::munmap(m_data, m_capacity);
+    if (::ftruncate(m_fd, offset) != 0)
+    {
+        FRONT_LOG(WARNING) << LOG_DESC("FrameCapture truncate failed") << LOG_KV("path", m_path);
+    }
+    ::close(m_fd);
+    m_data = nullptr;
+    m_fd = -1;
+    FRONT_LOG(INFO) << LOG_DESC("FrameCapture closed") << LOG_KV("path", m_path)
+                    << LOG_KV("captured", capturedFrames()) << LOG_KV("dropped", droppedFrames())
+                    << LOG_KV("size", offset);
+}
+
+FrameTrace::FrameTrace(const std::string& _path)
+{
+    m_fd = ::open(_path.c_str(), O_RDONLY);
+    struct stat fileStat;
+    if (m_fd < 0 || ::fstat(m_fd, &fileStat) != 0 ||
+        (size_t)fileStat.st_size < sizeof(FrameTraceHeader))
+    {
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+        }
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("FrameTrace: invalid trace file " + _path));
+    }
+    m_size = fileStat.st_size;
+    auto data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED)
+    {
+        ::close(m_fd);
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("FrameTrace: mmap failed " + _path));
+    }
+    m_data = (const byte*)data;
+    if (header().magic != FrameTraceHeader::MAGIC ||
+        header().version != FrameTraceHeader::VERSION)
+    {
+        ::munmap((void*)m_data, m_size);
+        ::close(m_fd);
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("FrameTrace: invalid trace file " + _path));
+    }
+
+    // a trace still being captured has no valid end, scan until the first incomplete record
+    uint64_t offset = sizeof(FrameTraceHeader);
+    while (offset + RECORD_HEADER_LENGTH <= m_size)
+    {
+        auto record = m_data + offset;
+        uint32_t length = 0;
+        uint32_t frameLength = 0;
+        uint16_t nodeIDLength = 0;
+        CapturedFrame frame;
+        memcpy(&length, record, 4);
+        memcpy(&frameLength, record + 4, 4);
+        memcpy(&frame.arrivalTime, record + 8, 8);
+        memcpy(&nodeIDLength, record + 16, 2);
+        if (length == 0 || offset + length > m_size ||
+            RECORD_HEADER_LENGTH + nodeIDLength + frameLength > length)
+        {
+            break;
+        }
+        frame.nodeID = bytesConstRef(record + RECORD_HEADER_LENGTH, nodeIDLength);
+        frame.frame = bytesConstRef(record + RECORD_HEADER_LENGTH + nodeIDLength, frameLength);
+        m_frames.push_back(frame);
+        offset += length;
+    }
+    // the traces of other writers are not bound to the file order
+    std::stable_sort(m_frames.begin(), m_frames.end(),
+        [](const CapturedFrame& _lhs, const CapturedFrame& _rhs) {
+            return _lhs.arrivalTime < _rhs.arrivalTime;
+        });
+}
+
+FrameTrace::~FrameTrace()
+{
+    ::munmap((void*)m_data, m_size);
+    ::close(m_fd);
+}
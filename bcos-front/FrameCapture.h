@@ -0,0 +1,122 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief capture the inbound frames into a memory-mapped trace file
+ * @file FrameCapture.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <atomic>
+
+namespace bcos
+{
+namespace front
+{
+/// trace file header            :64 bytes
+/// records, 8 bytes aligned:
+///   record length              :4 bytes, 0 until the record is completely written
+///   frame length               :4 bytes
+///   arrival time               :8 bytes, nanoseconds since the capture started
+///   nodeID length              :2 bytes
+///   nodeID                     :nodeID length bytes
+///   frame                      :frame length bytes
+struct FrameTraceHeader
+{
+    const static uint32_t MAGIC = 0x52544642;  // "BFTR"
+    const static uint32_t VERSION = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    // utc time when the capture started, in microseconds
+    uint64_t startTime;
+    // bytes of the file including the header
+    uint64_t capacity;
+    // end of the written records, updated when the capture is closed
+    uint64_t end;
+    uint8_t reserved[32];
+};
+
+class FrameCapture
+{
+public:
+    using Ptr = std::shared_ptr<FrameCapture>;
+
+    // create(truncate) the trace file with _capacity bytes, exception thrown if failed
+    FrameCapture(const std::string& _path, size_t _capacity);
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+    ~FrameCapture();
+
+    // append a frame, return false if the trace file is full or closed
+    bool append(bytesConstRef _nodeID, bytesConstRef _frame);
+
+    // flush the records and shrink the file to the written size
+    void close();
+
+    const std::string& path() const { return m_path; }
+    uint64_t capturedFrames() const { return m_captured.load(std::memory_order_relaxed); }
+    uint64_t droppedFrames() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    std::string m_path;
+    int m_fd = -1;
+    byte* m_data = nullptr;
+    size_t m_capacity = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    std::atomic<uint64_t> m_end;
+    std::atomic<uint64_t> m_captured = {0};
+    std::atomic<uint64_t> m_dropped = {0};
+    std::atomic<bool> m_closed = {false};
+    // the appenders in flight, close waits for them
+    std::atomic<uint64_t> m_writers = {0};
+};
+
+/// one frame read from the trace file, refers to the mapped file
+struct CapturedFrame
+{
+    uint64_t arrivalTime;
+    bytesConstRef nodeID;
+    bytesConstRef frame;
+};
+
+/// read only view of a trace file
+class FrameTrace
+{
+public:
+    using Ptr = std::shared_ptr<FrameTrace>;
+
+    // map the trace file, exception thrown if not a valid trace file
+    explicit FrameTrace(const std::string& _path);
+    FrameTrace(const FrameTrace&) = delete;
+    FrameTrace& operator=(const FrameTrace&) = delete;
+    ~FrameTrace();
+
+    const FrameTraceHeader& header() const { return *(const FrameTraceHeader*)m_data; }
+    // the frames in the order of arrival
+    const std::vector<CapturedFrame>& frames() const { return m_frames; }
+
+private:
+    int m_fd = -1;
+    const byte* m_data = nullptr;
+    size_t m_size = 0;
+    std::vector<CapturedFrame> m_frames;
+};
+}  // namespace front
+}  // namespace bcos
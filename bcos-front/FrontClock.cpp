@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the clock and the timers of the front service, on the io service or in virtual time
+ * @file FrontClock.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/FrontClock.h>
+
+using namespace bcos;
+using namespace bcos::front;
+
+namespace
+{
+class AsioTimer : public FrontTimer
+{
+public:
+    AsioTimer(boost::asio::io_service& _ioService, uint64_t _delay, std::function<void()> _task)
+      : FrontTimer(std::move(_task)), m_timer(_ioService, boost::posix_time::microseconds(_delay))
+    {}
+
+    bool cancel() override
+    {
+        if (!FrontTimer::cancel())
+        {
+            return false;
+        }
+        m_timer.cancel();
+        return true;
+    }
+
+    size_t memorySize() const override { return sizeof(AsioTimer); }
+
+    void start(std::shared_ptr<AsioTimer> _self)
+    {
+        // the pending handler keeps the timer alive until it expires or is cancelled
+        m_timer.async_wait([_self](const boost::system::error_code& _error) {
+            if (!_error)
+            {
+                _self->fire();
+            }
+        });
+    }
+
+private:
+    boost::asio::deadline_timer m_timer;
+};
+}  // namespace
+
+bool FrontTimer::cancel()
+{
+    auto expected = State::Pending;
+    if (!m_state.compare_exchange_strong(expected, State::Cancelled, std::memory_order_acq_rel))
+    {
+        return false;
+    }
+    m_task = nullptr;
+    return true;
+}
+
+bool FrontTimer::fire()
+{
+    auto expected = State::Pending;
+    if (!m_state.compare_exchange_strong(expected, State::Fired, std::memory_order_acq_rel))
+    {
+        return false;
+    }
+    auto task = std::move(m_task);
+    task();
+    return true;
+}
+
+FrontTimer::Ptr AsioClock::schedule(uint64_t _delay, std::function<void()> _task)
+{
+    auto timer = std::make_shared<AsioTimer>(*m_ioService, _delay, std::move(_task));
+    timer->start(timer);
+    return timer;
+}
+
+FrontTimer::Ptr VirtualClock::schedule(uint64_t _delay, std::function<void()> _task)
+{
+    auto timer = std::make_shared<FrontTimer>(std::move(_task));
+    Guard l(x_timers);
+    m_timers.push(Entry{nowUs() + _delay, m_sequence++, timer});
+    return timer;
+}
+
+FrontTimer::Ptr VirtualClock::popDue(uint64_t _time)
+{
+    Guard l(x_timers);
+    if (m_timers.empty() || m_timers.top().time > _time)
+    {
+        return nullptr;
+    }
+    auto entry = m_timers.top();
+    m_timers.pop();
+    if (entry.time > nowUs())
+    {
+        m_now.store(entry.time, std::memory_order_release);
+    }
+    return entry.timer;
+}
+
+size_t VirtualClock::advanceTo(uint64_t _time)
+{
+    size_t fired = 0;
+    // the timers scheduled by the fired ones run too if due by _time
+    while (auto timer = popDue(_time))
+    {
+        fired += timer->fire();
+    }
+    if (_time > nowUs())
+    {
+        m_now.store(_time, std::memory_order_release);
+    }
+    return fired;
+}
+
+size_t VirtualClock::runUntilIdle(size_t _maxTimers)
+{
+    size_t fired = 0;
+    while (fired < _maxTimers)
+    {
+        auto timer = popDue(std::numeric_limits<uint64_t>::max());
+        if (!timer)
+        {
+            break;
+        }
+        fired += timer->fire();
+    }
+    return fired;
+}
+
+size_t VirtualClock::pending() const
+{
+    Guard l(x_timers);
+    return m_timers.size();
+}
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the clock and the timers of the front service, on the io service or in virtual time
+ * @file FrontClock.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <boost/asio.hpp>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace bcos
+{
+namespace front
+{
+// a task run once by its clock unless cancelled before
+class FrontTimer
+{
+public:
+    using Ptr = std::shared_ptr<FrontTimer>;
+
+    explicit FrontTimer(std::function<void()> _task) : m_task(std::move(_task)) {}
+    virtual ~FrontTimer() = default;
+    FrontTimer(const FrontTimer&) = delete;
+    FrontTimer& operator=(const FrontTimer&) = delete;
+
+    // return false if the timer has fired or been cancelled already
+    virtual bool cancel();
+    // run the task unless cancelled, called by the clock, return false if not run
+    bool fire();
+    bool pending() const { return m_state.load(std::memory_order_acquire) == State::Pending; }
+    // the bytes of the timer object, for the memory accounting of its owner
+    virtual size_t memorySize() const { return sizeof(FrontTimer); }
+
+private:
+    enum class State : uint8_t
+    {
+        Pending = 0,
+        Fired = 1,
+        Cancelled = 2,
+    };
+    std::atomic<State> m_state = {State::Pending};
+    // released once cancelled, the captures of the pending requests can be large
+    std::function<void()> m_task;
+};
+
+/**
+ * the time source and the timers of the front service: the request timeouts, the delayed sends
+ * and the round trips are measured on it, so that a virtual clock drives them deterministically
+ */
+class FrontClock
+{
+public:
+    using Ptr = std::shared_ptr<FrontClock>;
+
+    virtual ~FrontClock() = default;
+
+    // steady time in milliseconds
+    virtual uint64_t now() const { return nowUs() / 1000; }
+    // steady time in microseconds
+    virtual uint64_t nowUs() const = 0;
+    // run _task after _delay microseconds, the timer is not fired if cancelled before
+    virtual FrontTimer::Ptr schedule(uint64_t _delay, std::function<void()> _task) = 0;
+};
+
+// the steady clock of the system, the timers are run by the io thread of the front service
+class AsioClock : public FrontClock
+{
+public:
+    using Ptr = std::shared_ptr<AsioClock>;
+
+    explicit AsioClock(std::shared_ptr<boost::asio::io_service> _ioService)
+      : m_ioService(_ioService)
+    {}
+
+    uint64_t now() const override { return utcSteadyTime(); }
+    uint64_t nowUs() const override { return utcSteadyTimeUs(); }
+    FrontTimer::Ptr schedule(uint64_t _delay, std::function<void()> _task) override;
+
+private:
+    std::shared_ptr<boost::asio::io_service> m_ioService;
+};
+
+/**
+ * the time only moves when advanced: the due timers are run in (time, scheduled order) on the
+ * thread advancing the clock, so that a run is reproducible and a million timeouts take no
+ * longer than their callbacks
+ */
+class VirtualClock : public FrontClock
+{
+public:
+    using Ptr = std::shared_ptr<VirtualClock>;
+
+    explicit VirtualClock(uint64_t _start = 0) : m_now(_start) {}
+
+    uint64_t nowUs() const override { return m_now.load(std::memory_order_acquire); }
+    FrontTimer::Ptr schedule(uint64_t _delay, std::function<void()> _task) override;
+
+    // run the timers due by _time and move the clock to it, return the timers fired
+    size_t advanceTo(uint64_t _time);
+    size_t advance(uint64_t _delay) { return advanceTo(nowUs() + _delay); }
+    // jump from timer to timer until none is left or _maxTimers are fired
+    size_t runUntilIdle(size_t _maxTimers = std::numeric_limits<size_t>::max());
+    // the scheduled timers, the cancelled ones not reached yet included
+    size_t pending() const;
+
+private:
+    struct Entry
+    {
+        uint64_t time;
+        uint64_t sequence;
+        FrontTimer::Ptr timer;
+        bool operator>(const Entry& _other) const
+        {
+            return time != _other.time ? time > _other.time : sequence > _other.sequence;
+        }
+    };
+    // pop the first timer due by _time and move the clock to its time, nullptr if none
+    FrontTimer::Ptr popDue(uint64_t _time);
+
+    std::atomic<uint64_t> m_now;
+    mutable bcos::Mutex x_timers;
+    uint64_t m_sequence = 0;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> m_timers;
+};
+}  // namespace front
+}  // namespace bcos
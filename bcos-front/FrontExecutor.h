@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the executor running the dispatch and the callback tasks of the front service
+ * @file FrontExecutor.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/ThreadPool.h>
+#include <functional>
+#include <memory>
+
+namespace bcos
+{
+namespace front
+{
+class FrontExecutor
+{
+public:
+    using Ptr = std::shared_ptr<FrontExecutor>;
+    using Task = std::function<void()>;
+
+    virtual ~FrontExecutor() = default;
+
+    virtual void enqueue(Task _task) = 0;
+    // a task continuing the running one, e.g. the callback of a response, may run next on the
+    // same worker while its data is still in cache
+    virtual void enqueueContinuation(Task _task) { enqueue(std::move(_task)); }
+    virtual void stop() = 0;
+};
+
+// the generic bcos::ThreadPool, a single queue shared by all the workers
+class ThreadPoolExecutor : public FrontExecutor
+{
+public:
+    explicit ThreadPoolExecutor(bcos::ThreadPool::Ptr _threadPool) : m_threadPool(_threadPool) {}
+
+    void enqueue(Task _task) override { m_threadPool->enqueue(std::move(_task)); }
+    void stop() override { m_threadPool->stop(); }
+
+    bcos::ThreadPool::Ptr threadPool() const { return m_threadPool; }
+
+private:
+    bcos::ThreadPool::Ptr m_threadPool;
+};
+
+// the thread the callback of a request runs on, the response, the timeout or the failure
+struct Completion
+{
+    using Post = std::function<void(FrontExecutor::Task)>;
+
+    enum class Mode : uint8_t
+    {
+        // a task of the front executor, inline without one
+        Pool = 0,
+        // on the thread receiving the response or firing the timeout, the payload is only valid
+        // during the call, the callback must neither block nor throw
+        Inline = 1,
+        // posted to the executor of the caller, e.g. its strand or event loop
+        Caller = 2,
+    };
+
+    Mode mode = Mode::Pool;
+    Post post;
+
+    static Completion pool() { return Completion(); }
+    static Completion inlined()
+    {
+        Completion completion;
+        completion.mode = Mode::Inline;
+        return completion;
+    }
+    static Completion caller(Post _post)
+    {
+        Completion completion;
+        completion.mode = Mode::Caller;
+        completion.post = std::move(_post);
+        return completion;
+    }
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief a (moduleID, payload) encoded once and sent any number of times
+ * @file FrontFrame.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/FrontFrame.h>
+#include <cstring>
+
+using namespace bcos;
+using namespace bcos::front;
+
+FrontFrame::FrontFrame(uint16_t _moduleID, bytesConstRef _payload) : m_moduleID(_moduleID)
+{
+    m_buffer.reserve(HEADER_ROOM + _payload.size());
+    m_buffer.resize(HEADER_ROOM);
+    m_buffer.insert(m_buffer.end(), _payload.begin(), _payload.end());
+}
+
+void FrontFrame::send(bytesConstRef _header, const SendFunc& _send) const
+{
+    auto payloadSize = m_buffer.size() - HEADER_ROOM;
+    // the flag is not a lock: a send of the same frame from _send, e.g. a loopback gateway
+    // dispatching it to a module resending it, must not wait for the outer send
+    if (_header.size() <= HEADER_ROOM && !m_busy.test_and_set(std::memory_order_acquire))
+    {
+        auto start = m_buffer.data() + HEADER_ROOM - _header.size();
+        memcpy(start, _header.data(), _header.size());
+        m_patched++;
+        try
+        {
+            _send(bytesConstRef(start, _header.size() + payloadSize));
+        }
+        catch (...)
+        {
+            m_busy.clear(std::memory_order_release);
+            throw;
+        }
+        m_busy.clear(std::memory_order_release);
+        return;
+    }
+    bytes frame;
+    frame.reserve(_header.size() + payloadSize);
+    frame.insert(frame.end(), _header.begin(), _header.end());
+    frame.insert(frame.end(), m_buffer.begin() + HEADER_ROOM, m_buffer.end());
+    m_copied++;
+    _send(bytesConstRef(frame.data(), frame.size()));
+}
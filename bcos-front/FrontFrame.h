@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief a (moduleID, payload) encoded once and sent any number of times
+ * @file FrontFrame.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <atomic>
+#include <functional>
+
+namespace bcos
+{
+namespace front
+{
+/**
+ * the payload is copied once behind HEADER_ROOM reserved bytes, every send writes the header of
+ * its request, uuid and extension included, right before the payload and hands the contiguous
+ * frame to the gateway, which takes it before returning; a send overlapping another send of the
+ * same frame, or with a header over HEADER_ROOM, copies the frame instead
+ */
+class FrontFrame
+{
+public:
+    using Ptr = std::shared_ptr<const FrontFrame>;
+    using SendFunc = std::function<void(bytesConstRef)>;
+
+    /// moduleID(2) + uuid length(1) + uuid(36) + ext(2) + the extension fields with room to spare
+    constexpr static size_t HEADER_ROOM = 128;
+
+    FrontFrame(uint16_t _moduleID, bytesConstRef _payload);
+    FrontFrame(const FrontFrame&) = delete;
+    FrontFrame& operator=(const FrontFrame&) = delete;
+
+    uint16_t moduleID() const { return m_moduleID; }
+    bytesConstRef payload() const
+    {
+        return bytesConstRef(m_buffer.data() + HEADER_ROOM, m_buffer.size() - HEADER_ROOM);
+    }
+
+    // call _send with _header followed by the payload, valid during the call only
+    void send(bytesConstRef _header, const SendFunc& _send) const;
+
+    // the sends patched in place and the sends copying the frame
+    uint64_t patched() const { return m_patched; }
+    uint64_t copied() const { return m_copied; }
+
+private:
+    uint16_t m_moduleID;
+    // the header room followed by the payload, only the room is written after the construction
+    mutable bytes m_buffer;
+    // a send is writing the header room
+    mutable std::atomic_flag m_busy = ATOMIC_FLAG_INIT;
+    mutable std::atomic<uint64_t> m_patched = {0};
+    mutable std::atomic<uint64_t> m_copied = {0};
+};
+}  // namespace front
+}  // namespace bcos
@@ -24,6 +24,83 @@
 using namespace bcos;
 using namespace front;
 
+namespace {
+void appendUint64(bytes &_buffer, uint64_t _value) {
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    _buffer.push_back((byte)(_value >> shift));
+  }
+}
+
+uint64_t readUint(const byte *_data, size_t _length) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < _length; ++i) {
+    value = (value << 8) | _data[i];
+  }
+  return value;
+}
+} // namespace
+
+void FrontMessageExtension::encode(bytes &_buffer) const {
+  _buffer.push_back((byte)encodedLength());
+  _buffer.push_back(VERSION);
+  _buffer.push_back(fields);
+  if (hasTrace()) {
+    appendUint64(_buffer, traceID);
+    appendUint64(_buffer, sendTime);
+    _buffer.push_back(hops);
+  }
+  if (hasDeadline()) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      _buffer.push_back((byte)(ttl >> shift));
+    }
+  }
+  if (hasRelay()) {
+    appendUint64(_buffer, broadcastID);
+    appendUint64(_buffer, origin);
+    _buffer.push_back(fanout);
+  }
+}
+
+ssize_t FrontMessageExtension::decode(bytesConstRef _buffer) {
+  if (_buffer.size() < HEADER_LENGTH) {
+    return -1;
+  }
+  size_t length = _buffer[0];
+  if (length < HEADER_LENGTH || length > _buffer.size()) {
+    return -1;
+  }
+  version = _buffer[1];
+  fields = _buffer[2];
+  size_t offset = HEADER_LENGTH;
+  if (hasTrace()) {
+    if (offset + TRACE_LENGTH > length) {
+      return -1;
+    }
+    traceID = readUint(&_buffer[offset], 8);
+    sendTime = readUint(&_buffer[offset + 8], 8);
+    hops = _buffer[offset + 16];
+    offset += TRACE_LENGTH;
+  }
+  if (hasDeadline()) {
+    if (offset + DEADLINE_LENGTH > length) {
+      return -1;
+    }
+    ttl = (uint32_t)readUint(&_buffer[offset], 4);
+    offset += DEADLINE_LENGTH;
+  }
+  if (hasRelay()) {
+    if (offset + RELAY_LENGTH > length) {
+      return -1;
+    }
+    broadcastID = readUint(&_buffer[offset], 8);
+    origin = readUint(&_buffer[offset + 8], 8);
+    fanout = _buffer[offset + 16];
+    offset += RELAY_LENGTH;
+  }
+  // fields added by newer versions are skipped
+  return length;
+}
+
 bool FrontMessage::encode(bytes &_buffer) {
   _buffer.clear();
 
@@ -31,6 +108,7 @@ bool FrontMessage::encode(bytes &_buffer) {
   /// UUID length       :1 bytes
   /// UUID              :UUID length bytes
   /// ext               :2 bytes
+  /// extension         :only if ext has the Extension bit
   /// payload
 
   uint16_t moduleID =
@@ -49,6 +127,9 @@ bool FrontMessage::encode(bytes &_buffer) {
     _buffer.insert(_buffer.end(), m_uuid->begin(), m_uuid->end());
   }
   _buffer.insert(_buffer.end(), (byte *)&ext, (byte *)&ext + 2);
+  if (hasExtension()) {
+    m_extension.encode(_buffer);
+  }
 
   _buffer.insert(_buffer.end(), m_payload.begin(), m_payload.end());
   return true;
@@ -61,6 +142,7 @@ ssize_t FrontMessage::decode(bytesConstRef _buffer) {
 
   m_uuid->clear();
   m_payload.reset();
+  m_extension = FrontMessageExtension();
 
   int32_t offset = 0;
   m_moduleID = boost::asio::detail::socket_ops::network_to_host_short(
@@ -70,6 +152,11 @@ ssize_t FrontMessage::decode(bytesConstRef _buffer) {
   uint8_t uuidLength = *((uint8_t *)&_buffer[offset]);
   offset += 1;
 
+  // the uuid and ext must be in the buffer
+  if (_buffer.size() < HEADER_MIN_LENGTH + uuidLength) {
+    return MessageDecodeStatus::MESSAGE_ERROR;
+  }
+
   if (uuidLength > 0) {
     m_uuid->assign(&_buffer[offset], &_buffer[offset] + uuidLength);
     offset += uuidLength;
@@ -79,6 +166,14 @@ ssize_t FrontMessage::decode(bytesConstRef _buffer) {
       *((uint16_t *)&_buffer[offset]));
   offset += 2;
 
+  if (hasExtension()) {
+    auto length = m_extension.decode(_buffer.getCroppedData(offset));
+    if (length < 0) {
+      return MessageDecodeStatus::MESSAGE_ERROR;
+    }
+    offset += length;
+  }
+
   m_payload = _buffer.getCroppedData(offset);
 
   return MessageDecodeStatus::MESSAGE_COMPLETE;
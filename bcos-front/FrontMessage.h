@@ -33,10 +33,90 @@ enum MessageDecodeStatus
     MESSAGE_INCOMPLETE = 1
 };
 
+/**
+ * optional versioned header extension, present only when the Extension bit of ext is set
+ * length            :1 bytes, the whole extension included
+ * version           :1 bytes
+ * fields            :1 bytes, bitmap of the fields below
+ * [Trace]           :traceID(8) + sendTime(8) + hops(1)
+ * [Deadline]        :ttl(4)
+ * [Relay]           :broadcastID(8) + origin(8) + fanout(1)
+ * unknown trailing bytes are skipped, so newer versions can append fields
+ */
+struct FrontMessageExtension
+{
+    constexpr static uint8_t VERSION = 1;
+    /// length(1) + version(1) + fields(1)
+    constexpr static size_t HEADER_LENGTH = 3;
+    constexpr static size_t TRACE_LENGTH = 17;
+    constexpr static size_t DEADLINE_LENGTH = 4;
+    constexpr static size_t RELAY_LENGTH = 17;
+
+    enum Field : uint8_t
+    {
+        Trace = 0x01,
+        Deadline = 0x02,
+        // a broadcast re-forwarded by the receivers along a relay tree
+        Relay = 0x04,
+    };
+
+    uint8_t version = VERSION;
+    uint8_t fields = 0;
+    // identify the request and its response across nodes
+    uint64_t traceID = 0;
+    // the time the sender enqueued the message, in microseconds since epoch
+    uint64_t sendTime = 0;
+    // number of nodes the message has been relayed by
+    uint8_t hops = 0;
+    // the time the sender still waits for the response when sending, in milliseconds
+    uint32_t ttl = 0;
+    // identify the relayed broadcast for the dedup of every hop
+    uint64_t broadcastID = 0;
+    // hash of the nodeID of the broadcaster, the root of the relay tree
+    uint64_t origin = 0;
+    // children of every node of the relay tree
+    uint8_t fanout = 0;
+
+    bool hasTrace() const { return fields & Field::Trace; }
+    void setTrace(uint64_t _traceID, uint64_t _sendTime, uint8_t _hops = 0)
+    {
+        fields |= Field::Trace;
+        traceID = _traceID;
+        sendTime = _sendTime;
+        hops = _hops;
+    }
+
+    bool hasDeadline() const { return fields & Field::Deadline; }
+    void setDeadline(uint32_t _ttl)
+    {
+        fields |= Field::Deadline;
+        ttl = _ttl;
+    }
+
+    bool hasRelay() const { return fields & Field::Relay; }
+    void setRelay(uint64_t _broadcastID, uint64_t _origin, uint8_t _fanout)
+    {
+        fields |= Field::Relay;
+        broadcastID = _broadcastID;
+        origin = _origin;
+        fanout = _fanout;
+    }
+
+    size_t encodedLength() const
+    {
+        return HEADER_LENGTH + (hasTrace() ? TRACE_LENGTH : 0) +
+               (hasDeadline() ? DEADLINE_LENGTH : 0) + (hasRelay() ? RELAY_LENGTH : 0);
+    }
+    void encode(bytes& _buffer) const;
+    // return the length of the extension at the front of _buffer, -1 if it is malformed
+    ssize_t decode(bytesConstRef _buffer);
+};
+
 /// moduleID          :2 bytes
 /// UUID length       :1 bytes
 /// UUID              :UUID length bytes
 /// ext               :2 bytes
+/// extension         :only if ext has the Extension bit, see FrontMessageExtension
 /// payload
 class FrontMessage
 {
@@ -51,6 +131,12 @@ public:
     enum ExtFlag
     {
         Response = 0x0001,
+        // a FrontMessageExtension follows ext
+        Extension = 0x0010,
+        // the sender cancelled the request of the uuid, without payload
+        Cancel = 0x0020,
+        // response of a request rejected by an overloaded responder, without payload
+        Overloaded = 0x0040,
     };
 
 public:
@@ -78,6 +164,20 @@ public:
     virtual void setResponse() { m_ext |= ExtFlag::Response; }
     virtual bool isResponse() { return m_ext & ExtFlag::Response; }
 
+    virtual void setCancel() { m_ext |= ExtFlag::Cancel; }
+    virtual bool isCancel() { return m_ext & ExtFlag::Cancel; }
+
+    virtual void setOverloaded() { m_ext |= ExtFlag::Overloaded; }
+    virtual bool isOverloaded() { return m_ext & ExtFlag::Overloaded; }
+
+    virtual bool hasExtension() { return m_ext & ExtFlag::Extension; }
+    virtual FrontMessageExtension const& extension() { return m_extension; }
+    virtual void setExtension(FrontMessageExtension const& _extension)
+    {
+        m_extension = _extension;
+        m_ext |= ExtFlag::Extension;
+    }
+
 public:
     virtual bool encode(bytes& _buffer);
     virtual ssize_t decode(bytesConstRef _buffer);
@@ -86,9 +186,82 @@ protected:
     uint16_t m_moduleID = 0;
     std::shared_ptr<bytes> m_uuid;
     uint16_t m_ext = 0;
+    FrontMessageExtension m_extension;
     bytesConstRef m_payload;  ///< message data
 };
 
+/**
+ * non-owning view of an encoded FrontMessage, the header is parsed in place with bounds checks,
+ * uuid and payload refer to the decoded buffer which must outlive the view
+ */
+class FrontMessageView
+{
+public:
+    FrontMessageView() = default;
+
+    // parse the header of _buffer, return MESSAGE_ERROR if _buffer is truncated
+    MessageDecodeStatus decode(bytesConstRef _buffer)
+    {
+        auto size = _buffer.size();
+        auto data = _buffer.data();
+        if (size < FrontMessage::HEADER_MIN_LENGTH)
+        {
+            return MessageDecodeStatus::MESSAGE_ERROR;
+        }
+        size_t uuidLength = data[2];
+        size_t extOffset = 3 + uuidLength;
+        // ext must be in the buffer
+        if (size < extOffset + 2)
+        {
+            return MessageDecodeStatus::MESSAGE_ERROR;
+        }
+        m_moduleID = (uint16_t)((data[0] << 8) | data[1]);
+        m_uuid = bytesConstRef(data + 3, uuidLength);
+        m_ext = (uint16_t)((data[extOffset] << 8) | data[extOffset + 1]);
+        size_t payloadOffset = extOffset + 2;
+        m_extension = FrontMessageExtension();
+        m_hopsOffset = 0;
+        if (hasExtension())
+        {
+            auto length =
+                m_extension.decode(bytesConstRef(data + payloadOffset, size - payloadOffset));
+            if (length < 0)
+            {
+                return MessageDecodeStatus::MESSAGE_ERROR;
+            }
+            if (m_extension.hasTrace())
+            {
+                // the trace is the first field: traceID(8) + sendTime(8) + hops(1)
+                m_hopsOffset = payloadOffset + FrontMessageExtension::HEADER_LENGTH + 16;
+            }
+            payloadOffset += length;
+        }
+        m_payload = bytesConstRef(data + payloadOffset, size - payloadOffset);
+        return MessageDecodeStatus::MESSAGE_COMPLETE;
+    }
+
+    uint16_t moduleID() const { return m_moduleID; }
+    uint16_t ext() const { return m_ext; }
+    bytesConstRef uuid() const { return m_uuid; }
+    bytesConstRef payload() const { return m_payload; }
+    bool isResponse() const { return m_ext & FrontMessage::ExtFlag::Response; }
+    bool isCancel() const { return m_ext & FrontMessage::ExtFlag::Cancel; }
+    bool isOverloaded() const { return m_ext & FrontMessage::ExtFlag::Overloaded; }
+    bool hasExtension() const { return m_ext & FrontMessage::ExtFlag::Extension; }
+    // empty if the frame has no extension
+    FrontMessageExtension const& extension() const { return m_extension; }
+    // offset of the hops of the trace in the frame, 0 if the frame has no trace
+    size_t hopsOffset() const { return m_hopsOffset; }
+
+private:
+    uint16_t m_moduleID = 0;
+    uint16_t m_ext = 0;
+    FrontMessageExtension m_extension;
+    size_t m_hopsOffset = 0;
+    bytesConstRef m_uuid;
+    bytesConstRef m_payload;
+};
+
 class FrontMessageFactory
 {
 public:
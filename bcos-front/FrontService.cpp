@@ -18,6 +18,8 @@
  * @date 2021-04-19
  */
 
+#include <limits>
+#include <random>
 #include <thread>
 
 #include <bcos-front/Common.h>
@@ -36,6 +38,35 @@ using namespace bcos;
 using namespace front;
 using namespace protocol;
 
+namespace
+{
+// FNV-1a of the uuid, so the request and its response share the trace id on every node
+uint64_t traceIDOf(const std::string& _uuid)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (auto c : _uuid)
+    {
+        hash = (hash ^ (uint8_t)c) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t randomTraceID()
+{
+    thread_local std::mt19937_64 engine(std::random_device{}());
+    return engine();
+}
+
+void checkModuleID(int _moduleID, const std::string& _method)
+{
+    if (_moduleID < 0 || _moduleID > std::numeric_limits<uint16_t>::max())
+    {
+        BOOST_THROW_EXCEPTION(InvalidParameter() << errinfo_comment(
+                                  _method + ": invalid moduleID " + std::to_string(_moduleID)));
+    }
+}
+}  // namespace
+
 FrontService::FrontService()
 {
     FRONT_LOG(INFO) << LOG_DESC("FrontService") << LOG_KV("this", this);
@@ -81,6 +112,12 @@ void FrontService::checkParams()
             InvalidParameter() << errinfo_comment(" FrontService ioService is uninitialized"));
     }
 
+    // the real time timers of m_ioService unless the caller set a clock of its own
+    if (!m_clock)
+    {
+        m_clock = std::make_shared<AsioClock>(m_ioService);
+    }
+
     return;
 }
 
@@ -118,6 +155,11 @@ void FrontService::start()
         });
 
     m_frontServiceThread = std::make_shared<std::thread>([=]() {
+        if (!m_threadPlacement.ioCpus.empty())
+        {
+            // the timers and the sends from the io thread allocate on the node it is pinned to
+            placeCurrentThread(m_threadPlacement.ioCpus, m_threadPlacement.numaLocalMemory);
+        }
         while (m_run)
         {
             try
@@ -139,18 +181,99 @@ void FrontService::start()
         }
     });
 
+    if (m_moduleID2InlineDispatcher.size() > 0)
+    {
+        watchInlineDispatchers();
+    }
+
     FRONT_LOG(INFO) << LOG_DESC("start") << LOG_KV("nodeID", m_nodeID->hex())
                     << LOG_KV("groupID", m_groupID);
 
     FRONT_LOG(INFO) << LOG_DESC("register module")
                     << LOG_KV("count", m_moduleID2MessageDispatcher.size());
-    for (const auto& module : m_moduleID2MessageDispatcher)
+    m_moduleID2MessageDispatcher.forEach(
+        [](uint16_t _moduleID, const std::shared_ptr<const MessageDispatcher>&) {
+            FRONT_LOG(INFO) << LOG_DESC("register module") << LOG_KV("moduleID", _moduleID);
+        });
+
+    return;
+}
+void FrontService::registerModuleMessageDispatcher(int _moduleID, MessageDispatcher _dispatcher)
+{
+    checkModuleID(_moduleID, "registerModuleMessageDispatcher");
+    m_moduleID2MessageDispatcher.set(
+        _moduleID, std::make_shared<const MessageDispatcher>(std::move(_dispatcher)));
+    m_moduleID2CancellableDispatcher.remove(_moduleID);
+    m_moduleID2InlineDispatcher.remove(_moduleID);
+    FRONT_LOG(INFO) << LOG_DESC("registerModuleMessageDispatcher") << LOG_KV("moduleID", _moduleID)
+                    << LOG_KV("running", m_run);
+}
+
+void FrontService::registerModuleCancellableDispatcher(
+    int _moduleID, CancellableDispatcher _dispatcher)
+{
+    checkModuleID(_moduleID, "registerModuleCancellableDispatcher");
+    m_moduleID2CancellableDispatcher.set(
+        _moduleID, std::make_shared<const CancellableDispatcher>(std::move(_dispatcher)));
+    m_moduleID2MessageDispatcher.remove(_moduleID);
+    m_moduleID2InlineDispatcher.remove(_moduleID);
+    FRONT_LOG(INFO) << LOG_DESC("registerModuleCancellableDispatcher")
+                    << LOG_KV("moduleID", _moduleID) << LOG_KV("running", m_run);
+}
+
+void FrontService::registerModuleInlineDispatcher(
+    int _moduleID, MessageDispatcher _dispatcher, uint64_t _budget)
+{
+    checkModuleID(_moduleID, "registerModuleInlineDispatcher");
+    m_moduleID2InlineDispatcher.set(
+        _moduleID, std::make_shared<const InlineDispatcher>(
+                       InlineDispatcher{std::move(_dispatcher), _budget}));
+    m_moduleID2MessageDispatcher.remove(_moduleID);
+    m_moduleID2CancellableDispatcher.remove(_moduleID);
+    FRONT_LOG(INFO) << LOG_DESC("registerModuleInlineDispatcher") << LOG_KV("moduleID", _moduleID)
+                    << LOG_KV("budget(us)", _budget) << LOG_KV("running", m_run);
+    if (m_run)
     {
-        FRONT_LOG(INFO) << LOG_DESC("register module") << LOG_KV("moduleID", module.first);
+        watchInlineDispatchers();
     }
+}
 
-    return;
+void FrontService::watchInlineDispatchers()
+{
+    if (!m_inlineWatched.exchange(true))
+    {
+        scanInlineDispatchers();
+    }
+}
+
+void FrontService::scanInlineDispatchers()
+{
+    auto frontServiceWeakPtr = std::weak_ptr<FrontService>(shared_from_this());
+    // the handlers take real time whatever m_clock is
+    AsioClock(m_ioService).schedule(InlineWatchdog::SCAN_INTERVAL, [frontServiceWeakPtr]() {
+        auto frontService = frontServiceWeakPtr.lock();
+        if (frontService && frontService->m_run)
+        {
+            frontService->m_inlineWatchdog->scan();
+            frontService->scanInlineDispatchers();
+        }
+    });
+}
+
+bool FrontService::unregisterModuleMessageDispatcher(int _moduleID)
+{
+    if (_moduleID < 0 || _moduleID > std::numeric_limits<uint16_t>::max())
+    {
+        return false;
+    }
+    auto removed = m_moduleID2MessageDispatcher.remove(_moduleID);
+    removed = m_moduleID2CancellableDispatcher.remove(_moduleID) || removed;
+    removed = m_moduleID2InlineDispatcher.remove(_moduleID) || removed;
+    FRONT_LOG(INFO) << LOG_DESC("unregisterModuleMessageDispatcher")
+                    << LOG_KV("moduleID", _moduleID) << LOG_KV("removed", removed);
+    return removed;
 }
+
 void FrontService::stop()
 {
     if (!m_run)
@@ -159,6 +282,7 @@ void FrontService::stop()
     }
 
     m_run = false;
+    m_inlineWatched = false;
 
     try
     {
@@ -176,16 +300,18 @@ void FrontService::stop()
             }
             // clear the callback
             m_callback.clear();
+            m_peer2Callbacks.clear();
         }
+        m_cancellationRegistry->clear();
 
         if (m_ioService)
         {
             m_ioService->stop();
         }
 
-        if (m_threadPool)
+        if (m_executor)
         {
-            m_threadPool->stop();
+            m_executor->stop();
         }
 
         if (m_frontServiceThread && m_frontServiceThread->joinable())
@@ -213,17 +339,12 @@ void FrontService::stop()
  */
 void FrontService::asyncGetNodeIDs(GetNodeIDsFunc _getNodeIDsFunc)
 {
-    std::shared_ptr<const crypto::NodeIDs> nodeIDs;
-    {
-        Guard l(x_nodeIDs);
-        nodeIDs = m_nodeIDs;
-    }
-
+    auto nodeIDs = nodeIDsSnapshot()->nodeIDs();
     if (_getNodeIDsFunc)
     {
-        if (m_threadPool)
+        if (m_executor)
         {
-            m_threadPool->enqueue(
+            m_executor->enqueue(
                 [nodeIDs, _getNodeIDsFunc]() { _getNodeIDsFunc(nullptr, nodeIDs); });
         }
         else
@@ -232,8 +353,8 @@ void FrontService::asyncGetNodeIDs(GetNodeIDsFunc _getNodeIDsFunc)
         }
     }
 
-    FRONT_LOG(INFO) << LOG_DESC("asyncGetNodeIDs")
-                    << LOG_KV("nodeIDs.size()", (nodeIDs ? nodeIDs->size() : 0));
+    FRONT_LOG(TRACE) << LOG_DESC("asyncGetNodeIDs")
+                     << LOG_KV("nodeIDs.size()", (nodeIDs ? nodeIDs->size() : 0));
 
     return;
 }
@@ -243,40 +364,140 @@ void FrontService::asyncGetNodeIDs(GetNodeIDsFunc _getNodeIDsFunc)
  * @param _moduleID: moduleID
  * @param _nodeID: the receiver nodeID
  * @param _data: send message data
- * @param _timeout: timeout, in milliseconds.
+ * @param _timeout: timeout, in milliseconds, ADAPTIVE_TIMEOUT to derive it from the observed
+ * round trips
  * @param _callbackFunc: callback
  * @return void
  */
 void FrontService::asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
     bytesConstRef _data, uint32_t _timeout, CallbackFunc _callbackFunc)
 {
+    asyncSendRequest(_moduleID, _nodeID, _data, _timeout, _callbackFunc);
+}
+
+void FrontService::asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
+    bytesConstRef _data, uint32_t _timeout, CallbackFunc _callbackFunc,
+    const Completion& _completion)
+{
+    asyncSendRequest(_moduleID, _nodeID, _data, _timeout, _callbackFunc, _completion);
+}
+
+std::string FrontService::asyncSendRequest(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
+    bytesConstRef _data, uint32_t _timeout, CallbackFunc _callbackFunc,
+    const Completion& _completion)
+{
+    return sendRequest(_moduleID, _nodeID, _data, nullptr, _timeout, _callbackFunc, _completion);
+}
+
+std::string FrontService::asyncSendFrame(FrontFrame::Ptr _frame, bcos::crypto::NodeIDPtr _nodeID,
+    uint32_t _timeout, CallbackFunc _callbackFunc, const Completion& _completion)
+{
+    return sendRequest(_frame->moduleID(), _nodeID, _frame->payload(), _frame, _timeout,
+        _callbackFunc, _completion);
+}
+
+std::string FrontService::sendRequest(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
+    bytesConstRef _data, FrontFrame::Ptr _frame, uint32_t _timeout, CallbackFunc _callbackFunc,
+    const Completion& _completion)
+{
+    if (_completion.mode == Completion::Mode::Caller && !_completion.post)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("asyncSendRequest: completion without post"));
+    }
     try
     {
+        if (_timeout == ADAPTIVE_TIMEOUT)
+        {
+            _timeout = m_adaptiveTimeout->timeout(_moduleID, _nodeID);
+        }
+        if (_callbackFunc && m_circuitBreaker &&
+            !m_circuitBreaker->allowRequest(_nodeID, m_clock->now()))
+        {
+            FRONT_LOG(DEBUG) << LOG_BADGE("asyncSendMessageByNodeID")
+                             << LOG_DESC("circuit breaker open, fail fast")
+                             << LOG_KV("moduleID", _moduleID) << LOG_KV("nodeID", _nodeID->hex());
+            failRequest(_callbackFunc, _nodeID,
+                std::make_shared<Error>(FrontError::CircuitOpen, "circuit breaker open"),
+                _completion);
+            return std::string();
+        }
+        OutboundRateLimiter::Admission admission;
+        if (!m_rateLimiter->empty())
+        {
+            admission = m_rateLimiter->admit(_moduleID, _nodeID, _data.size(), m_clock->nowUs());
+        }
+        if (!admission.admitted)
+        {
+            FRONT_LOG(DEBUG) << LOG_BADGE("asyncSendMessageByNodeID")
+                             << LOG_DESC("over the rate limit, reject")
+                             << LOG_KV("moduleID", _moduleID) << LOG_KV("nodeID", _nodeID->hex());
+            if (_callbackFunc)
+            {
+                failRequest(_callbackFunc, _nodeID,
+                    std::make_shared<Error>(FrontError::RateLimited, "rate limited"), _completion);
+            }
+            return std::string();
+        }
         std::string uuid = boost::uuids::to_string(boost::uuids::random_generator()());
+        // the callback and the frame, or the copy of the payload waiting for the rate limiter;
+        // a pre-encoded frame is held by the caller
+        size_t callbackBytes = _callbackFunc ? sizeof(Callback) + uuid.size() : 0;
+        MemoryAccountant::Ticket::Ptr reservation;
+        if (m_memoryAccountant)
+        {
+            reservation = m_memoryAccountant->admit(_moduleID, MemoryDirection::Outbound,
+                callbackBytes + (_frame ? 0 : _data.size()), m_loadShedder->sheddable(_moduleID));
+        }
+        if (m_memoryAccountant && !reservation)
+        {
+            FRONT_LOG(WARNING) << LOG_BADGE("asyncSendMessageByNodeID")
+                               << LOG_DESC("over the outbound memory limit, reject")
+                               << LOG_KV("moduleID", _moduleID) << LOG_KV("used",
+                                      m_memoryAccountant->used(MemoryDirection::Outbound));
+            if (_callbackFunc)
+            {
+                failRequest(_callbackFunc, _nodeID,
+                    std::make_shared<Error>(FrontError::MemoryExhausted, "memory exhausted"),
+                    _completion);
+            }
+            return std::string();
+        }
+
         if (_callbackFunc)
         {
             auto callback = std::make_shared<Callback>();
+            callback->moduleID = _moduleID;
+            callback->nodeID = _nodeID;
             callback->callbackFunc = _callbackFunc;
+            callback->completion = _completion;
+            callback->startTime = m_clock->now();
 
             if (_timeout > 0)
             {
                 // create new timer to handle timeout
-                auto timeoutHandler = std::make_shared<boost::asio::deadline_timer>(
-                    *m_ioService, boost::posix_time::milliseconds(_timeout));
-
-                callback->timeoutHandler = timeoutHandler;
                 auto frontServiceWeakPtr = std::weak_ptr<FrontService>(shared_from_this());
-                // callback->startTime = utcSteadyTime();
-                timeoutHandler->async_wait(
-                    [frontServiceWeakPtr, _nodeID, uuid](const boost::system::error_code& e) {
+                callback->timeoutHandler = m_clock->schedule(
+                    (uint64_t)_timeout * 1000, [frontServiceWeakPtr, _nodeID, uuid]() {
                         auto frontService = frontServiceWeakPtr.lock();
                         if (frontService)
                         {
-                            frontService->onMessageTimeout(e, _nodeID, uuid);
+                            frontService->onMessageTimeout(
+                                boost::system::error_code(), _nodeID, uuid);
                         }
                     });
             }
 
+            // held until the response, the frame part of the reservation only until sent
+            if (reservation)
+            {
+                callback->memoryTicket = reservation->split(callbackBytes);
+            }
+            if (reservation && callback->timeoutHandler)
+            {
+                callback->memoryTicket->resize(
+                    callbackBytes + callback->timeoutHandler->memorySize());
+            }
             addCallback(uuid, callback);
 
             FRONT_LOG(DEBUG) << LOG_DESC("asyncSendMessageByNodeID") << LOG_KV("groupID", m_groupID)
@@ -286,8 +507,10 @@ void FrontService::asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDP
 
         }  // if (_callback)
 
-        sendMessage(_moduleID, _nodeID, uuid, _data, false,
-            [this, _moduleID, _nodeID, uuid](Error::Ptr _error) {
+        auto timeout = _callbackFunc ? _timeout : 0;
+        auto send = [this, _moduleID, _nodeID, uuid, _frame](bytesConstRef _payload,
+                        MemoryAccountant::Ticket::Ptr _reservation, uint32_t _timeout) {
+            auto onSent = [this, _moduleID, _nodeID, uuid](Error::Ptr _error) {
                 if (_error && (_error->errorCode() != CommonError::SUCCESS))
                 {
                     FRONT_LOG(ERROR) << LOG_BADGE("sendMessage callback") << LOG_KV("uuid", uuid)
@@ -295,13 +518,76 @@ void FrontService::asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDP
                                      << LOG_KV("errorMessage", _error->errorMessage());
                     handleCallback(_error, bytesConstRef(), uuid, _moduleID, _nodeID);
                 }
+            };
+            if (_frame)
+            {
+                sendFrame(_frame, _nodeID, uuid, onSent, _timeout);
+            }
+            else
+            {
+                sendMessage(
+                    _moduleID, _nodeID, uuid, _payload, false, onSent, _timeout, _reservation);
+            }
+        };
+        // the timeout of the request keeps running while it waits for the budget, the delayed
+        // send carries the remaining part as the deadline of the message
+        auto admitTime = m_clock->nowUs();
+        auto sendDelayed = [this, send, timeout, admitTime](bytesConstRef _payload) {
+            uint64_t waited = m_clock->nowUs() - admitTime;
+            if (timeout > 0 && waited + 1000 > (uint64_t)timeout * 1000)
+            {
+                // expired while delayed, the timeout handler fails the request
+                return;
+            }
+            send(_payload, nullptr, timeout > 0 ? timeout - waited / 1000 : 0);
+        };
+        if (admission.delay > 0 && _frame)
+        {
+            // the frame holds the payload
+            sendLater(admission.delay, [sendDelayed, _frame]() { sendDelayed(_frame->payload()); });
+        }
+        else if (admission.delay > 0)
+        {
+            // the reservation holds the copy and the frame is charged when encoded
+            auto buffer = std::make_shared<bytes>(_data.begin(), _data.end());
+            sendLater(admission.delay, [sendDelayed, buffer, reservation]() {
+                sendDelayed(bytesConstRef(buffer->data(), buffer->size()));
             });
+        }
+        else
+        {
+            send(_data, reservation, timeout);
+        }
+        return uuid;
     }
     catch (std::exception& e)
     {
         FRONT_LOG(ERROR) << LOG_BADGE("asyncSendMessageByNodeID")
                          << LOG_KV("error", boost::diagnostic_information(e));
     }
+    return std::string();
+}
+
+bool FrontService::cancelRequest(const std::string& _uuid)
+{
+    auto callback = getAndRemoveCallback(_uuid);
+    if (!callback)
+    {
+        return false;
+    }
+    if (callback->timeoutHandler)
+    {
+        callback->timeoutHandler->cancel();
+    }
+    recordFlight(FlightEvent::Cancel, callback->moduleID, callback->nodeID, _uuid, 0);
+    FRONT_LOG(DEBUG) << LOG_BADGE("cancelRequest") << LOG_KV("uuid", _uuid)
+                     << LOG_KV("moduleID", callback->moduleID);
+    // the legacy peers would take the cancel frame for a request
+    if (m_headerExtensionEnabled)
+    {
+        sendCancel(callback->moduleID, callback->nodeID, _uuid);
+    }
+    return true;
 }
 
 /**
@@ -313,6 +599,7 @@ void FrontService::asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDP
 void FrontService::asyncSendResponse(const std::string& _id, int _moduleID,
     bcos::crypto::NodeIDPtr _nodeID, bytesConstRef _data, ReceiveMsgFunc _receiveMsgCallback)
 {
+    m_cancellationRegistry->remove(_nodeID, _id);
     sendMessage(_moduleID, _nodeID, _id, _data, true, _receiveMsgCallback);
 }
 
@@ -340,9 +627,44 @@ void FrontService::asyncSendMessageByNodeIDs(
  */
 void FrontService::asyncSendBroadcastMessage(int _moduleID, bytesConstRef _data)
 {
+    if (!m_rateLimiter->empty())
+    {
+        auto admission =
+            m_rateLimiter->admit(_moduleID, nullptr, _data.size(), m_clock->nowUs());
+        if (!admission.admitted)
+        {
+            FRONT_LOG(DEBUG) << LOG_BADGE("asyncSendBroadcastMessage")
+                             << LOG_DESC("over the rate limit, drop")
+                             << LOG_KV("moduleID", _moduleID)
+                             << LOG_KV("data.size()", _data.size());
+            return;
+        }
+        if (admission.delay > 0)
+        {
+            auto buffer = std::make_shared<bytes>(_data.begin(), _data.end());
+            auto ticket = chargeMemory(_moduleID, MemoryDirection::Outbound, buffer->size());
+            sendLater(admission.delay, [this, _moduleID, buffer, ticket]() {
+                broadcastMessage(_moduleID, bytesConstRef(buffer->data(), buffer->size()));
+            });
+            return;
+        }
+    }
+    broadcastMessage(_moduleID, _data);
+}
+
+void FrontService::broadcastMessage(int _moduleID, bytesConstRef _data)
+{
+    auto fanout = relayBroadcastFanout(_moduleID);
+    if (fanout > 0)
+    {
+        asyncSendRelayBroadcast(_moduleID, _data, fanout);
+        return;
+    }
+
     auto message = messageFactory()->buildMessage();
     message->setModuleID(_moduleID);
     message->setPayload(_data);
+    setHeaderExtension(message, std::string(), 0);
 
     auto buffer = std::make_shared<bytes>();
     message->encode(*buffer.get());
@@ -351,6 +673,116 @@ void FrontService::asyncSendBroadcastMessage(int _moduleID, bytesConstRef _data)
         m_groupID, m_nodeID, bytesConstRef(buffer->data(), buffer->size()));
 }
 
+void FrontService::asyncSendRelayBroadcast(int _moduleID, bytesConstRef _data, uint8_t _fanout)
+{
+    auto message = messageFactory()->buildMessage();
+    message->setModuleID(_moduleID);
+    message->setPayload(_data);
+    setHeaderExtension(message, std::string(), 0);
+    auto extension = message->extension();
+    extension.setRelay(
+        randomTraceID(), RelayTree::nodeHash(m_nodeID), std::max<uint8_t>(_fanout, 1));
+    message->setExtension(extension);
+    // drop the broadcast if it is relayed back
+    m_relayDedup->insert(extension.origin, extension.broadcastID);
+
+    auto tree = relayTree(extension);
+    FRONT_LOG(TRACE) << LOG_BADGE("asyncSendRelayBroadcast") << LOG_KV("moduleID", _moduleID)
+                     << LOG_KV("broadcastID", extension.broadcastID)
+                     << LOG_KV("fanout", (int)extension.fanout) << LOG_KV("members", tree->size());
+    auto buffer = std::make_shared<bytes>();
+    message->encode(*buffer.get());
+    relayForward(tree, tree->position(), buffer);
+}
+
+size_t FrontService::asyncGossip(int _moduleID, bytesConstRef _data, size_t _fanout)
+{
+    auto snapshot = nodeIDsSnapshot();
+    bcos::crypto::NodeIDs peers;
+    // _fanout may be far beyond the group, e.g. SIZE_MAX for all the peers
+    peers.reserve(std::min(_fanout, snapshot->size()));
+    snapshot->sample(_fanout, m_nodeID, peers);
+    FRONT_LOG(TRACE) << LOG_BADGE("asyncGossip") << LOG_KV("moduleID", _moduleID)
+                     << LOG_KV("fanout", _fanout) << LOG_KV("peers", peers.size());
+    if (peers.empty())
+    {
+        return 0;
+    }
+
+    auto message = messageFactory()->buildMessage();
+    message->setModuleID(_moduleID);
+    message->setPayload(_data);
+    setHeaderExtension(message, std::string(), 0);
+    auto buffer = std::make_shared<bytes>();
+    message->encode(*buffer.get());
+    m_gatewayInterface->asyncSendMessageByNodeIDs(
+        m_groupID, m_nodeID, peers, bytesConstRef(buffer->data(), buffer->size()));
+    return peers.size();
+}
+
+std::shared_ptr<const RelayTree> FrontService::relayTree(
+    FrontMessageExtension const& _extension) const
+{
+    auto nodeIDs = nodeIDsSnapshot()->nodeIDs();
+    auto tree = std::make_shared<const RelayTree>(nodeIDs ? *nodeIDs : bcos::crypto::NodeIDs(),
+        m_nodeID, _extension.origin, _extension.broadcastID, _extension.fanout);
+    if (!tree->valid())
+    {
+        // the broadcaster is unknown to this node, the subtree misses the broadcast
+        FRONT_LOG(DEBUG) << LOG_BADGE("relayTree") << LOG_DESC("unknown broadcaster")
+                         << LOG_KV("broadcastID", _extension.broadcastID)
+                         << LOG_KV("members", tree->size());
+    }
+    return tree;
+}
+
+void FrontService::relayForward(
+    std::shared_ptr<const RelayTree> _tree, size_t _position, std::shared_ptr<const bytes> _frame)
+{
+    for (auto position : _tree->children(_position))
+    {
+        auto frontServiceWeakPtr = std::weak_ptr<FrontService>(shared_from_this());
+        m_gatewayInterface->asyncSendMessageByNodeID(m_groupID, m_nodeID, _tree->node(position),
+            bytesConstRef(_frame->data(), _frame->size()),
+            [frontServiceWeakPtr, _tree, position, _frame](Error::Ptr _error) {
+                if (!_error || _error->errorCode() == CommonError::SUCCESS)
+                {
+                    return;
+                }
+                auto frontService = frontServiceWeakPtr.lock();
+                if (!frontService)
+                {
+                    return;
+                }
+                // the dedup of the receivers drops the copies if the child did receive it
+                FRONT_LOG(DEBUG) << LOG_BADGE("relayForward")
+                                 << LOG_DESC("unreachable child, relay to its children")
+                                 << LOG_KV("nodeID", _tree->node(position)->hex())
+                                 << LOG_KV("code", _error->errorCode())
+                                 << LOG_KV("msg", _error->errorMessage());
+                frontService->relayForward(_tree, position, _frame);
+            });
+    }
+}
+
+uint8_t FrontService::relayBroadcastFanout(int _moduleID) const
+{
+    ReadGuard l(x_relayFanouts);
+    auto it = m_relayFanouts.find(_moduleID);
+    return it == m_relayFanouts.end() ? 0 : it->second;
+}
+
+void FrontService::setRelayBroadcast(int _moduleID, uint8_t _fanout)
+{
+    WriteGuard l(x_relayFanouts);
+    if (_fanout == 0)
+    {
+        m_relayFanouts.erase(_moduleID);
+        return;
+    }
+    m_relayFanouts[_moduleID] = _fanout;
+}
+
 /**
  * @brief: receive nodeIDs from gateway
  * @param _groupID: groupID
@@ -361,15 +793,30 @@ void FrontService::asyncSendBroadcastMessage(int _moduleID, bytesConstRef _data)
 void FrontService::onReceiveNodeIDs(const std::string& _groupID,
     std::shared_ptr<const crypto::NodeIDs> _nodeIDs, ReceiveMsgFunc _receiveMsgCallback)
 {
+    NodeIDsDelta::Ptr delta;
     {
         Guard l(x_nodeIDs);
-        m_nodeIDs = _nodeIDs;
+        auto previous = nodeIDsSnapshot();
+        auto snapshot = std::make_shared<const NodeIDsSnapshot>(previous->version() + 1, _nodeIDs);
+        delta = snapshot->diff(*previous);
+        m_nodeIDsSnapshot.store(snapshot);
     }
 
     FRONT_LOG(INFO) << LOG_DESC("onReceiveNodeIDs") << LOG_KV("groupID", _groupID)
-                    << LOG_KV("nodeIDs.size()", (_nodeIDs ? _nodeIDs->size() : 0));
+                    << LOG_KV("nodeIDs.size()", (_nodeIDs ? _nodeIDs->size() : 0))
+                    << LOG_KV("version", delta->version) << LOG_KV("added", delta->added.size())
+                    << LOG_KV("removed", delta->removed.size());
+
+    // copy the dispatchers out so they can register other dispatchers
+    decltype(m_moduleID2NodeIDsDispatcher) nodeIDsDispatchers;
+    decltype(m_moduleID2NodeIDsDeltaDispatcher) deltaDispatchers;
+    {
+        ReadGuard l(x_nodeIDsDispatcher);
+        nodeIDsDispatchers = m_moduleID2NodeIDsDispatcher;
+        deltaDispatchers = m_moduleID2NodeIDsDeltaDispatcher;
+    }
 
-    for (const auto& entry : m_moduleID2NodeIDsDispatcher)
+    for (const auto& entry : nodeIDsDispatchers)
     {
         auto moduleID = entry.first;
         entry.second(_nodeIDs, [_groupID, moduleID](Error::Ptr _error) {
@@ -381,11 +828,34 @@ void FrontService::onReceiveNodeIDs(const std::string& _groupID,
         });
     }
 
+    // fail fast the requests waiting for the nodes that left
+    for (auto const& nodeID : delta->removed)
+    {
+        onPeerDisconnected(nodeID);
+    }
+
+    // the delta dispatchers are only notified when the node list really changes
+    if (!delta->empty())
+    {
+        for (const auto& entry : deltaDispatchers)
+        {
+            auto moduleID = entry.first;
+            entry.second(delta, [_groupID, moduleID](Error::Ptr _error) {
+                if (_error)
+                {
+                    FRONT_LOG(ERROR) << LOG_DESC("onReceiveNodeIDs delta dispather failed")
+                                     << LOG_KV("groupID", _groupID)
+                                     << LOG_KV("moduleID", moduleID);
+                }
+            });
+        }
+    }
+
     if (_receiveMsgCallback)
     {
-        if (m_threadPool)
+        if (m_executor)
         {
-            m_threadPool->enqueue([_receiveMsgCallback]() { _receiveMsgCallback(nullptr); });
+            m_executor->enqueue([_receiveMsgCallback]() { _receiveMsgCallback(nullptr); });
         }
         else
         {
@@ -394,6 +864,53 @@ void FrontService::onReceiveNodeIDs(const std::string& _groupID,
     }
 }
 
+size_t FrontService::onPeerDisconnected(bcos::crypto::NodeIDPtr _nodeID)
+{
+    std::vector<std::pair<std::string, int>> requests;
+    {
+        RecursiveGuard l(x_callback);
+        auto it = m_peer2Callbacks.find(_nodeID);
+        if (it == m_peer2Callbacks.end())
+        {
+            return 0;
+        }
+        for (auto const& uuid : it->second)
+        {
+            auto callback = m_callback.find(uuid);
+            if (callback != m_callback.end())
+            {
+                requests.emplace_back(uuid, callback->second->moduleID);
+            }
+        }
+    }
+    FRONT_LOG(INFO) << LOG_DESC("onPeerDisconnected fail the pending requests")
+                    << LOG_KV("nodeID", _nodeID->hex()) << LOG_KV("count", requests.size());
+    auto error = std::make_shared<Error>(FrontError::PeerDisconnected, "peer disconnected");
+    for (auto const& request : requests)
+    {
+        handleCallback(error, bytesConstRef(), request.first, request.second, _nodeID);
+    }
+    return requests.size();
+}
+
+void FrontService::reportPeerOutcome(
+    const bcos::crypto::NodeIDPtr& _nodeID, const bcos::Error::Ptr& _error)
+{
+    if (!m_circuitBreaker)
+    {
+        return;
+    }
+    // an overloaded response still proves the peer is reachable
+    if (!_error || _error->errorCode() == FrontError::Overloaded)
+    {
+        m_circuitBreaker->onSuccess(_nodeID);
+    }
+    else if (_error->errorCode() != FrontError::PeerDisconnected)
+    {
+        m_circuitBreaker->onFailure(_nodeID, m_clock->now());
+    }
+}
+
 void FrontService::handleCallback(bcos::Error::Ptr _error, bytesConstRef _payLoad,
     std::string const& _uuid, int _moduleID, bcos::crypto::NodeIDPtr _nodeID)
 {
@@ -425,20 +942,61 @@ void FrontService::handleCallback(bcos::Error::Ptr _error, bytesConstRef _payLoa
     {
         callback->timeoutHandler->cancel();
     }
+    reportPeerOutcome(_nodeID, _error);
+    if (!_error)
+    {
+        m_adaptiveTimeout->addSample(
+            callback->moduleID, _nodeID, m_clock->now() - callback->startTime);
+    }
+    if (m_flightRecorder)
+    {
+        recordFlight(FlightEvent::Response, _moduleID, _nodeID, _uuid, _payLoad.size());
+        m_flightRecorder->onRequestFinished(m_clock->now() - callback->startTime, m_executor);
+    }
+
+    // the response of a request sent by a dispatch task continues it
+    complete(callback->completion, _moduleID, true, callback->callbackFunc, _error, _nodeID,
+        _payLoad, _uuid, respFunc);
+}
 
-    if (m_threadPool)
+void FrontService::complete(const Completion& _completion, int _moduleID, bool _continuation,
+    const CallbackFunc& _callbackFunc, bcos::Error::Ptr _error, bcos::crypto::NodeIDPtr _nodeID,
+    bytesConstRef _payload, const std::string& _uuid, std::function<void(bytesConstRef)> _respFunc)
+{
+    if (_completion.mode == Completion::Mode::Inline ||
+        (_completion.mode == Completion::Mode::Pool && !m_executor))
     {
-        // construct shared_ptr<bytes> from message->payload() first for
-        // thead safe
-        std::shared_ptr<bytes> buffer = std::make_shared<bytes>(_payLoad.begin(), _payLoad.end());
-        m_threadPool->enqueue([_uuid, _error, callback, buffer, _nodeID, respFunc] {
-            callback->callbackFunc(
-                _error, _nodeID, bytesConstRef(buffer->data(), buffer->size()), _uuid, respFunc);
-        });
+        _callbackFunc(_error, _nodeID, _payload, _uuid, _respFunc);
+        return;
+    }
+    FrontExecutor::Task task;
+    if (_payload.empty())
+    {
+        task = [_callbackFunc, _error, _nodeID, _uuid, _respFunc]() {
+            _callbackFunc(_error, _nodeID, bytesConstRef(), _uuid, _respFunc);
+        };
+    }
+    else
+    {
+        // the payload refers to the received frame, copy it once for the task outlives it
+        auto buffer = std::make_shared<bytes>(_payload.begin(), _payload.end());
+        auto ticket = chargeMemory(_moduleID, MemoryDirection::Inbound, buffer->size());
+        task = [_callbackFunc, _error, _nodeID, _uuid, _respFunc, buffer, ticket]() {
+            _callbackFunc(
+                _error, _nodeID, bytesConstRef(buffer->data(), buffer->size()), _uuid, _respFunc);
+        };
+    }
+    if (_completion.mode == Completion::Mode::Caller)
+    {
+        _completion.post(std::move(task));
+    }
+    else if (_continuation)
+    {
+        m_executor->enqueueContinuation(std::move(task));
     }
     else
     {
-        callback->callbackFunc(_error, _nodeID, _payLoad, _uuid, respFunc);
+        m_executor->enqueue(std::move(task));
     }
 }
 /**
@@ -451,11 +1009,68 @@ void FrontService::handleCallback(bcos::Error::Ptr _error, bytesConstRef _payLoa
  */
 void FrontService::onReceiveMessage(const std::string& _groupID, bcos::crypto::NodeIDPtr _nodeID,
     bytesConstRef _data, ReceiveMsgFunc _receiveMsgCallback)
+{
+    receiveFrame(_groupID, _nodeID, _data, nullptr);
+    acknowledge(_receiveMsgCallback);
+}
+
+void FrontService::onReceiveMessages(const std::string& _groupID,
+    const std::vector<std::pair<bcos::crypto::NodeIDPtr, bytesConstRef>>& _frames,
+    ReceiveMsgFunc _receiveMsgCallback)
+{
+    // without thread pool the messages are dispatched one by one on this thread
+    DispatchBatches batches;
+    for (auto const& frame : _frames)
+    {
+        receiveFrame(_groupID, frame.first, frame.second, m_executor ? &batches : nullptr);
+    }
+    for (auto& batch : batches)
+    {
+        try
+        {
+            dispatchBatch(batch.first, std::move(batch.second));
+        }
+        catch (const std::exception& e)
+        {
+            FRONT_LOG(ERROR) << LOG_BADGE("onReceiveMessages") << LOG_KV("moduleID", batch.first)
+                             << LOG_KV("error", boost::diagnostic_information(e));
+        }
+    }
+    FRONT_LOG(TRACE) << LOG_BADGE("onReceiveMessages") << LOG_KV("frames", _frames.size())
+                     << LOG_KV("batches", batches.size());
+    acknowledge(_receiveMsgCallback);
+}
+
+void FrontService::acknowledge(ReceiveMsgFunc _receiveMsgCallback)
+{
+    if (_receiveMsgCallback)
+    {
+        if (m_executor)
+        {
+            m_executor->enqueue([_receiveMsgCallback]() { _receiveMsgCallback(nullptr); });
+        }
+        else
+        {
+            _receiveMsgCallback(nullptr);
+        }
+    }
+}
+
+void FrontService::receiveFrame(const std::string& _groupID, bcos::crypto::NodeIDPtr _nodeID,
+    bytesConstRef _data, DispatchBatches* _batches)
 {
     try
     {
-        auto message = messageFactory()->buildMessage();
-        auto ret = message->decode(_data);
+        auto capture = m_capturing.load(std::memory_order_relaxed) ? frameCapture() : nullptr;
+        if (capture)
+        {
+            auto const& nodeData = _nodeID->data();
+            capture->append(bytesConstRef(nodeData.data(), nodeData.size()), _data);
+        }
+
+        // decode in place, the payload refers to _data
+        FrontMessageView message;
+        auto ret = message.decode(_data);
         if (MessageDecodeStatus::MESSAGE_COMPLETE != ret)
         {
             FRONT_LOG(ERROR) << LOG_DESC("onReceiveMessage") << LOG_DESC("illegal message")
@@ -463,38 +1078,193 @@ void FrontService::onReceiveMessage(const std::string& _groupID, bcos::crypto::N
             BOOST_THROW_EXCEPTION(InvalidParameter() << errinfo_comment("illegal message"));
         }
 
-        int moduleID = message->moduleID();
-        int ext = message->ext();
-        std::string uuid = std::string(message->uuid()->begin(), message->uuid()->end());
+        int moduleID = message.moduleID();
+        int ext = message.ext();
+        std::string uuid = std::string(message.uuid().begin(), message.uuid().end());
 
         FRONT_LOG(TRACE) << LOG_BADGE("onReceiveMessage") << LOG_KV("moduleID", moduleID)
                          << LOG_KV("uuid", uuid) << LOG_KV("ext", ext)
                          << LOG_KV("groupID", _groupID) << LOG_KV("nodeID", _nodeID->hex())
                          << LOG_KV("length", _data.size());
+        // resolved once for all the flight records of the message
+        auto peerIndex = flightPeerIndex(_nodeID);
+        recordFlight(FlightEvent::Receive, moduleID, peerIndex, uuid, _data.size());
+        auto const& extension = message.extension();
+        auto receiveTime = utcTimeUs();
+        if (extension.hasTrace())
+        {
+            m_latencyStats->recordOneWayDelay(
+                moduleID, _nodeID, extension.sendTime, receiveTime, extension.hops);
+        }
 
-        if (message->isResponse())
+        if (message.isCancel())
+        {
+            auto cancelled = m_cancellationRegistry->cancel(_nodeID, uuid);
+            recordFlight(FlightEvent::Cancel, moduleID, peerIndex, uuid, 0);
+            FRONT_LOG(DEBUG) << LOG_BADGE("onReceiveMessage") << LOG_DESC("request cancelled")
+                             << LOG_KV("moduleID", moduleID) << LOG_KV("uuid", uuid)
+                             << LOG_KV("pending", cancelled);
+        }
+        else if (message.isResponse())
+        {
+            Error::Ptr error = nullptr;
+            if (message.isOverloaded())
+            {
+                error = std::make_shared<Error>(FrontError::Overloaded, "peer overloaded");
+            }
+            handleCallback(error, message.payload(), uuid, moduleID, _nodeID);
+        }
+        else if (extension.hasRelay() &&
+                 !m_relayDedup->insert(extension.origin, extension.broadcastID))
         {
-            handleCallback(nullptr, message->payload(), uuid, moduleID, _nodeID);
+            FRONT_LOG(TRACE) << LOG_BADGE("onReceiveMessage")
+                             << LOG_DESC("drop the duplicated relay broadcast")
+                             << LOG_KV("moduleID", moduleID)
+                             << LOG_KV("broadcastID", extension.broadcastID)
+                             << LOG_KV("nodeID", _nodeID->hex());
         }
         else
         {
-            auto it = m_moduleID2MessageDispatcher.find(moduleID);
-            if (it != m_moduleID2MessageDispatcher.end())
+            if (extension.hasRelay())
+            {
+                // forward before dispatching, the depth of the tree adds up the delays
+                auto tree = relayTree(extension);
+                if (!tree->children(tree->position()).empty())
+                {
+                    auto frame = std::make_shared<bytes>(_data.begin(), _data.end());
+                    if (message.hopsOffset())
+                    {
+                        // the children receive the frame one more hop away from the broadcaster
+                        auto& hops = (*frame)[message.hopsOffset()];
+                        hops = (hops < 0xff) ? hops + 1 : hops;
+                    }
+                    relayForward(tree, tree->position(), frame);
+                }
+            }
+            auto inlineDispatcher = m_moduleID2InlineDispatcher.get(moduleID);
+            auto dispatcher =
+                inlineDispatcher ? nullptr : m_moduleID2MessageDispatcher.get(moduleID);
+            auto deadline = dispatchDeadline(extension, receiveTime);
+            if (!inlineDispatcher && !dispatcher)
+            {
+                dispatcher = cancellableDispatcher(moduleID, _nodeID, uuid, deadline);
+            }
+            if (inlineDispatcher)
+            {
+                // no copy, no queue: the frame outlives the dispatch on this thread
+                recordFlight(FlightEvent::DispatchStart, moduleID, peerIndex, uuid,
+                    message.payload().size());
+                {
+                    InlineWatchdog::Scope scope(
+                        *m_inlineWatchdog, moduleID, inlineDispatcher->budget);
+                    inlineDispatcher->dispatcher(_nodeID, uuid, message.payload());
+                }
+                recordFlight(
+                    FlightEvent::DispatchEnd, moduleID, peerIndex, uuid, message.payload().size());
+            }
+            else if (dispatcher)
             {
-                if (m_threadPool)
+                if (m_executor && m_loadShedder->overloaded() && m_dispatchQueue->size() == 0)
                 {
-                    auto callback = it->second;
-                    // construct shared_ptr<bytes> from message->payload() first for
+                    m_loadShedder->onIdle();
+                }
+                // the copy of the payload for the pool, reserved with the ones already buffered
+                MemoryAccountant::Ticket::Ptr ticket;
+                bool admitted = m_executor && !m_loadShedder->shouldShed(moduleID);
+                if (admitted && m_memoryAccountant)
+                {
+                    ticket = m_memoryAccountant->admit(moduleID, MemoryDirection::Inbound,
+                        message.payload().size(), m_loadShedder->sheddable(moduleID));
+                    admitted = ticket != nullptr;
+                }
+                if (m_executor && !admitted)
+                {
+                    recordFlight(
+                        FlightEvent::Shed, moduleID, peerIndex, uuid, message.payload().size());
+                    m_cancellationRegistry->remove(_nodeID, uuid);
+                    // the broadcast messages have no uuid to reply to, the legacy peers can't
+                    // tell the overloaded response from a real one and time out instead
+                    if (!uuid.empty() && m_headerExtensionEnabled)
+                    {
+                        sendOverloadedResponse(moduleID, _nodeID, uuid);
+                    }
+                }
+                else if (m_executor && _batches)
+                {
+                    // dispatched with the other messages of the module by onReceiveMessages
+                    auto& batch = (*_batches)[moduleID];
+                    batch.entries.emplace_back(DispatchBatch::Entry{_nodeID, uuid, dispatcher,
+                        batch.payloads.size(), message.payload().size(), deadline, peerIndex});
+                    batch.tickets.emplace_back(std::move(ticket));
+                    batch.payloads.insert(batch.payloads.end(), message.payload().begin(),
+                        message.payload().end());
+                }
+                else if (m_executor)
+                {
+                    // construct shared_ptr<bytes> from message.payload() first for
                     // thead safe
                     std::shared_ptr<bytes> buffer = std::make_shared<bytes>(
-                        message->payload().begin(), message->payload().end());
-                    m_threadPool->enqueue([uuid, callback, buffer, message, _nodeID] {
-                        callback(_nodeID, uuid, bytesConstRef(buffer->data(), buffer->size()));
-                    });
+                        message.payload().begin(), message.payload().end());
+                    auto recorder = m_flightRecorder;
+                    // the stats are collected along with the header extension
+                    auto latencyStats = m_headerExtensionEnabled ? m_latencyStats : nullptr;
+                    auto loadShedder = m_loadShedder;
+                    auto enqueueTime = utcSteadyTimeUs();
+                    auto onExpired = [recorder, peerIndex, loadShedder, enqueueTime, moduleID,
+                                         uuid, buffer, ticket, _nodeID]() {
+                        loadShedder->onDequeue(utcSteadyTimeUs() - enqueueTime);
+                        FRONT_LOG(DEBUG) << LOG_BADGE("onReceiveMessage")
+                                         << LOG_DESC("drop the request for its deadline")
+                                         << LOG_KV("moduleID", moduleID) << LOG_KV("uuid", uuid)
+                                         << LOG_KV("nodeID", _nodeID->hex());
+                        if (recorder)
+                        {
+                            recorder->record(FlightEvent::Expired, moduleID, peerIndex,
+                                FlightRecorder::requestID(uuid), buffer->size());
+                        }
+                    };
+                    // queued earliest deadline first, each pool task runs the most urgent one
+                    m_dispatchQueue->push(deadline,
+                        [recorder, peerIndex, latencyStats, loadShedder, enqueueTime, moduleID,
+                            uuid, dispatcher, buffer, ticket, _nodeID] {
+                            auto queueTime = utcSteadyTimeUs() - enqueueTime;
+                            if (latencyStats)
+                            {
+                                latencyStats->recordQueueTime(moduleID, _nodeID, queueTime);
+                            }
+                            loadShedder->onDequeue(queueTime);
+                            if (recorder)
+                            {
+                                recorder->record(FlightEvent::DispatchStart, moduleID, peerIndex,
+                                    FlightRecorder::requestID(uuid), buffer->size());
+                            }
+                            (*dispatcher)(
+                                _nodeID, uuid, bytesConstRef(buffer->data(), buffer->size()));
+                            if (recorder)
+                            {
+                                recorder->record(FlightEvent::DispatchEnd, moduleID, peerIndex,
+                                    FlightRecorder::requestID(uuid), buffer->size());
+                            }
+                        },
+                        onExpired);
+                    auto dispatchQueue = m_dispatchQueue;
+                    m_executor->enqueue([dispatchQueue]() { dispatchQueue->runOne(); });
+                }
+                else if (deadline != DispatchQueue::NO_DEADLINE && utcSteadyTimeUs() >= deadline)
+                {
+                    recordFlight(FlightEvent::Expired, moduleID, peerIndex, uuid,
+                        message.payload().size());
+                    FRONT_LOG(DEBUG) << LOG_BADGE("onReceiveMessage")
+                                     << LOG_DESC("drop the request for its deadline")
+                                     << LOG_KV("moduleID", moduleID) << LOG_KV("uuid", uuid);
                 }
                 else
                 {
-                    it->second(_nodeID, uuid, message->payload());
+                    recordFlight(FlightEvent::DispatchStart, moduleID, peerIndex, uuid,
+                        message.payload().size());
+                    (*dispatcher)(_nodeID, uuid, message.payload());
+                    recordFlight(FlightEvent::DispatchEnd, moduleID, peerIndex, uuid,
+                        message.payload().size());
                 }
             }
             else
@@ -508,18 +1278,71 @@ void FrontService::onReceiveMessage(const std::string& _groupID, bcos::crypto::N
     {
         FRONT_LOG(ERROR) << "onReceiveMessage" << LOG_KV("error", boost::diagnostic_information(e));
     }
+}
 
-    if (_receiveMsgCallback)
+void FrontService::dispatchBatch(uint16_t _moduleID, DispatchBatch&& _batch)
+{
+    // one buffer, one queued task and one pool task for the whole batch, charged by the
+    // tickets of its messages
+    auto batch = std::make_shared<DispatchBatch>(std::move(_batch));
+    // due at the earliest deadline, the queue drops the batch once all its messages are useless,
+    // each one is checked on its own
+    uint64_t dueTime = DispatchQueue::NO_DEADLINE;
+    uint64_t deadline = 0;
+    for (auto const& entry : batch->entries)
     {
-        if (m_threadPool)
+        dueTime = std::min(dueTime, m_dispatchQueue->dueTime(entry.deadline));
+        deadline = std::max(deadline, entry.deadline);
+    }
+    auto recorder = m_flightRecorder;
+    auto latencyStats = m_headerExtensionEnabled ? m_latencyStats : nullptr;
+    auto loadShedder = m_loadShedder;
+    auto enqueueTime = utcSteadyTimeUs();
+    auto record = [recorder, batch, _moduleID](FlightEvent _event, size_t _index) {
+        if (recorder)
         {
-            m_threadPool->enqueue([_receiveMsgCallback]() { _receiveMsgCallback(nullptr); });
+            auto const& entry = batch->entries[_index];
+            recorder->record(_event, _moduleID, entry.peerIndex,
+                FlightRecorder::requestID(entry.uuid), entry.size);
         }
-        else
+    };
+    auto onExpired = [loadShedder, enqueueTime, batch, record, _moduleID]() {
+        loadShedder->onDequeue(utcSteadyTimeUs() - enqueueTime);
+        FRONT_LOG(DEBUG) << LOG_BADGE("onReceiveMessages")
+                         << LOG_DESC("drop the batch for its deadline")
+                         << LOG_KV("moduleID", _moduleID)
+                         << LOG_KV("messages", batch->entries.size());
+        for (size_t i = 0; i < batch->entries.size(); ++i)
         {
-            _receiveMsgCallback(nullptr);
+            record(FlightEvent::Expired, i);
         }
-    }
+    };
+    m_dispatchQueue->push(dueTime, deadline,
+        [latencyStats, loadShedder, enqueueTime, batch, record, _moduleID]() {
+            auto queueTime = utcSteadyTimeUs() - enqueueTime;
+            loadShedder->onDequeue(queueTime);
+            for (size_t i = 0; i < batch->entries.size(); ++i)
+            {
+                auto const& entry = batch->entries[i];
+                if (latencyStats)
+                {
+                    latencyStats->recordQueueTime(_moduleID, entry.nodeID, queueTime);
+                }
+                if (entry.deadline != DispatchQueue::NO_DEADLINE &&
+                    utcSteadyTimeUs() >= entry.deadline)
+                {
+                    record(FlightEvent::Expired, i);
+                    continue;
+                }
+                record(FlightEvent::DispatchStart, i);
+                (*entry.dispatcher)(entry.nodeID, entry.uuid,
+                    bytesConstRef(batch->payloads.data() + entry.offset, entry.size));
+                record(FlightEvent::DispatchEnd, i);
+            }
+        },
+        onExpired);
+    auto dispatchQueue = m_dispatchQueue;
+    m_executor->enqueue([dispatchQueue]() { dispatchQueue->runOne(); });
 }
 
 /**
@@ -536,6 +1359,26 @@ void FrontService::onReceiveBroadcastMessage(const std::string& _groupID,
     onReceiveMessage(_groupID, _nodeID, _data, _receiveMsgCallback);
 }
 
+void FrontService::sendLater(uint64_t _delay, std::function<void()> _send)
+{
+    auto frontServiceWeakPtr = std::weak_ptr<FrontService>(shared_from_this());
+    m_clock->schedule(_delay, [frontServiceWeakPtr, _send]() {
+        // keep the front alive until _send returns
+        auto frontService = frontServiceWeakPtr.lock();
+        if (frontService)
+        {
+            _send();
+        }
+    });
+}
+
+void FrontService::failRequest(CallbackFunc _callbackFunc, bcos::crypto::NodeIDPtr _nodeID,
+    bcos::Error::Ptr _error, const Completion& _completion)
+{
+    complete(_completion, 0, false, _callbackFunc, _error, _nodeID, bytesConstRef(),
+        std::string(), std::function<void(bytesConstRef)>());
+}
+
 /**
  * @brief: send message
  * @param _moduleID: moduleID
@@ -544,11 +1387,13 @@ void FrontService::onReceiveBroadcastMessage(const std::string& _groupID,
  * @param _data: send data payload
  * @param isResponse: if send response message
  * @param _receiveMsgCallback: response callback
+ * @param _timeout: the time the sender waits for the response, in milliseconds, 0 if not waiting
  * @return void
  */
 void FrontService::sendMessage(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
     const std::string& _uuid, bytesConstRef _data, bool isResponse,
-    ReceiveMsgFunc _receiveMsgCallback)
+    ReceiveMsgFunc _receiveMsgCallback, uint32_t _timeout,
+    MemoryAccountant::Ticket::Ptr _reservation)
 {
     auto message = messageFactory()->buildMessage();
     message->setModuleID(_moduleID);
@@ -558,9 +1403,21 @@ void FrontService::sendMessage(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
     {
         message->setResponse();
     }
+    setHeaderExtension(message, _uuid, _timeout);
 
     auto buffer = std::make_shared<bytes>();
     message->encode(*buffer.get());
+    recordFlight(FlightEvent::Send, _moduleID, _nodeID, _uuid, _data.size());
+    // the frame is held until the gateway takes it
+    auto ticket = _reservation;
+    if (ticket)
+    {
+        ticket->resize(buffer->size());
+    }
+    else
+    {
+        ticket = chargeMemory(_moduleID, MemoryDirection::Outbound, buffer->size());
+    }
 
     // call gateway interface to send the message
     m_gatewayInterface->asyncSendMessageByNodeID(m_groupID, m_nodeID, _nodeID,
@@ -572,6 +1429,135 @@ void FrontService::sendMessage(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
         });
 }
 
+void FrontService::sendFrame(FrontFrame::Ptr _frame, bcos::crypto::NodeIDPtr _nodeID,
+    const std::string& _uuid, ReceiveMsgFunc _receiveMsgCallback, uint32_t _timeout)
+{
+    // encode the header only, the frame holds the encoded payload
+    auto message = messageFactory()->buildMessage();
+    message->setModuleID(_frame->moduleID());
+    message->setUuid(std::make_shared<bytes>(_uuid.begin(), _uuid.end()));
+    setHeaderExtension(message, _uuid, _timeout);
+    bytes header;
+    message->encode(header);
+    recordFlight(
+        FlightEvent::Send, _frame->moduleID(), _nodeID, _uuid, _frame->payload().size());
+
+    _frame->send(bytesConstRef(header.data(), header.size()), [&](bytesConstRef _encoded) {
+        m_gatewayInterface->asyncSendMessageByNodeID(
+            m_groupID, m_nodeID, _nodeID, _encoded, [_receiveMsgCallback](Error::Ptr _error) {
+                if (_receiveMsgCallback)
+                {
+                    _receiveMsgCallback(_error);
+                }
+            });
+    });
+}
+
+void FrontService::setHeaderExtension(
+    FrontMessage::Ptr _message, const std::string& _uuid, uint32_t _timeout)
+{
+    if (!m_headerExtensionEnabled)
+    {
+        return;
+    }
+    // the broadcast messages have no uuid
+    uint64_t traceID = _uuid.empty() ? randomTraceID() : traceIDOf(_uuid);
+    FrontMessageExtension extension;
+    extension.setTrace(traceID, utcTimeUs());
+    if (_timeout > 0)
+    {
+        extension.setDeadline(_timeout);
+    }
+    _message->setExtension(extension);
+}
+
+std::shared_ptr<const FrontService::MessageDispatcher> FrontService::cancellableDispatcher(
+    uint16_t _moduleID, bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid,
+    uint64_t _deadline)
+{
+    auto dispatcher = m_moduleID2CancellableDispatcher.get(_moduleID);
+    if (!dispatcher)
+    {
+        return nullptr;
+    }
+    auto expireTime = _deadline != DispatchQueue::NO_DEADLINE ?
+                          _deadline :
+                          utcSteadyTimeUs() + CancellationRegistry::DEFAULT_EXPIRATION;
+    // registered on receive so that the request can be cancelled while queued
+    auto token = m_cancellationRegistry->add(_nodeID, _uuid, expireTime);
+    return std::make_shared<const MessageDispatcher>(
+        [dispatcher, token](bcos::crypto::NodeIDPtr _nodeID, const std::string& _id,
+            bytesConstRef _data) {
+            if (!token->cancelled())
+            {
+                (*dispatcher)(_nodeID, _id, _data, token);
+            }
+        });
+}
+
+void FrontService::sendCancel(
+    int _moduleID, bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid)
+{
+    auto message = messageFactory()->buildMessage();
+    message->setModuleID(_moduleID);
+    message->setUuid(std::make_shared<bytes>(_uuid.begin(), _uuid.end()));
+    message->setCancel();
+
+    auto buffer = std::make_shared<bytes>();
+    message->encode(*buffer.get());
+    m_gatewayInterface->asyncSendMessageByNodeID(m_groupID, m_nodeID, _nodeID,
+        bytesConstRef(buffer->data(), buffer->size()), [_uuid](Error::Ptr _error) {
+            if (_error && (_error->errorCode() != CommonError::SUCCESS))
+            {
+                FRONT_LOG(WARNING) << LOG_BADGE("sendCancel callback") << LOG_KV("uuid", _uuid)
+                                   << LOG_KV("errorCode", _error->errorCode());
+            }
+        });
+}
+
+void FrontService::sendOverloadedResponse(
+    int _moduleID, bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid)
+{
+    auto message = messageFactory()->buildMessage();
+    message->setModuleID(_moduleID);
+    message->setUuid(std::make_shared<bytes>(_uuid.begin(), _uuid.end()));
+    message->setResponse();
+    message->setOverloaded();
+
+    auto buffer = std::make_shared<bytes>();
+    message->encode(*buffer.get());
+    FRONT_LOG(DEBUG) << LOG_BADGE("sendOverloadedResponse") << LOG_KV("moduleID", _moduleID)
+                     << LOG_KV("uuid", _uuid) << LOG_KV("nodeID", _nodeID->hex());
+    m_gatewayInterface->asyncSendMessageByNodeID(m_groupID, m_nodeID, _nodeID,
+        bytesConstRef(buffer->data(), buffer->size()), [_uuid](Error::Ptr _error) {
+            if (_error && (_error->errorCode() != CommonError::SUCCESS))
+            {
+                FRONT_LOG(WARNING) << LOG_BADGE("sendOverloadedResponse callback")
+                                   << LOG_KV("uuid", _uuid)
+                                   << LOG_KV("errorCode", _error->errorCode());
+            }
+        });
+}
+
+uint64_t FrontService::dispatchDeadline(
+    FrontMessageExtension const& _extension, uint64_t _receiveTime)
+{
+    if (!_extension.hasDeadline())
+    {
+        return DispatchQueue::NO_DEADLINE;
+    }
+    uint64_t remaining = (uint64_t)_extension.ttl * 1000;
+    // deduct the time spent on the way, ignored if the clocks disagree: a sender clock behind
+    // would drop all its requests on arrival
+    if (_extension.hasTrace() && _receiveTime > _extension.sendTime &&
+        _receiveTime - _extension.sendTime <= MAX_TRANSIT_TIME)
+    {
+        auto elapsed = _receiveTime - _extension.sendTime;
+        remaining = elapsed >= remaining ? 0 : remaining - elapsed;
+    }
+    return utcSteadyTimeUs() + remaining;
+}
+
 /**
  * @brief: handle message timeout
  * @param _error: boost error code
@@ -593,19 +1579,20 @@ void FrontService::onMessageTimeout(const boost::system::error_code& _error,
         Callback::Ptr callback = getAndRemoveCallback(_uuid);
         if (callback)
         {
-            auto errorPtr = std::make_shared<Error>(CommonError::TIMEOUT, "timeout");
-            if (m_threadPool)
+            if (m_circuitBreaker)
             {
-                m_threadPool->enqueue([_uuid, _nodeID, callback, errorPtr]() {
-                    callback->callbackFunc(errorPtr, _nodeID, bytesConstRef(), _uuid,
-                        std::function<void(bytesConstRef)>());
-                });
+                m_circuitBreaker->onFailure(_nodeID, m_clock->now());
             }
-            else
+            m_adaptiveTimeout->onTimeout(callback->moduleID, _nodeID);
+            if (m_flightRecorder)
             {
-                callback->callbackFunc(errorPtr, _nodeID, bytesConstRef(), _uuid,
-                    std::function<void(bytesConstRef)>());
+                recordFlight(FlightEvent::Timeout, callback->moduleID, _nodeID, _uuid, 0);
+                m_flightRecorder->onRequestFinished(
+                    m_clock->now() - callback->startTime, m_executor);
             }
+            auto errorPtr = std::make_shared<Error>(CommonError::TIMEOUT, "timeout");
+            complete(callback->completion, callback->moduleID, false, callback->callbackFunc,
+                errorPtr, _nodeID, bytesConstRef(), _uuid, std::function<void(bytesConstRef)>());
         }
 
         FRONT_LOG(WARNING) << LOG_BADGE("onMessageTimeout") << LOG_KV("uuid", _uuid);
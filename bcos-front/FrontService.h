@@ -24,8 +24,30 @@
 #include <bcos-framework/interfaces/gateway/GatewayInterface.h>
 #include <bcos-framework/libutilities/Common.h>
 #include <bcos-framework/libutilities/ThreadPool.h>
+#include <bcos-front/CancellationToken.h>
+#include <bcos-front/DispatchQueue.h>
+#include <bcos-front/EpochReclaimer.h>
+#include <bcos-front/FlightRecorder.h>
+#include <bcos-front/FrontClock.h>
+#include <bcos-front/FrameCapture.h>
+#include <bcos-front/FrontExecutor.h>
+#include <bcos-front/FrontFrame.h>
 #include <bcos-front/FrontMessage.h>
+#include <bcos-front/InlineWatchdog.h>
+#include <bcos-front/LatencyStats.h>
+#include <bcos-front/LoadShedder.h>
+#include <bcos-front/MemoryAccountant.h>
+#include <bcos-front/ModuleDispatcherTable.h>
+#include <bcos-front/NodeIDsSnapshot.h>
+#include <bcos-front/PeerCircuitBreaker.h>
+#include <bcos-front/RateLimiter.h>
+#include <bcos-front/RelayTree.h>
+#include <bcos-front/RttEstimator.h>
+#include <bcos-front/ThreadPlacement.h>
 #include <boost/asio.hpp>
+#include <limits>
+#include <map>
+#include <unordered_set>
 
 namespace bcos
 {
@@ -35,6 +57,17 @@ class FrontService : public FrontServiceInterface, public std::enable_shared_fro
 {
 public:
     using Ptr = std::shared_ptr<FrontService>;
+    using MessageDispatcher = std::function<void(
+        bcos::crypto::NodeIDPtr _nodeID, const std::string& _id, bytesConstRef _data)>;
+    // dispatcher of the modules whose requests can be cancelled by the sender
+    using CancellableDispatcher = std::function<void(bcos::crypto::NodeIDPtr _nodeID,
+        const std::string& _id, bytesConstRef _data, CancellationToken::Ptr _token)>;
+
+    // pass as _timeout to let the front compute the timeout from the round trips of the peer
+    constexpr static uint32_t ADAPTIVE_TIMEOUT = std::numeric_limits<uint32_t>::max();
+    constexpr static uint8_t DEFAULT_RELAY_FANOUT = 4;
+    // a longer way from the sender is taken as the clocks disagreeing, in microseconds
+    constexpr static uint64_t MAX_TRANSIT_TIME = 100000;
 
     FrontService();
     FrontService(const FrontService&) = delete;
@@ -64,12 +97,49 @@ public:
      * @param _moduleID: moduleID
      * @param _nodeID: the receiver nodeID
      * @param _data: send message data
-     * @param _timeout: timeout, in milliseconds.
+     * @param _timeout: timeout, in milliseconds, ADAPTIVE_TIMEOUT to derive it from the observed
+     * round trips of _nodeID and _moduleID
      * @param _callbackFunc: callback
      * @return void
      */
     void asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
         bytesConstRef _data, uint32_t _timeout, CallbackFunc _callbackFunc) override;
+    /**
+     * @brief: send message, _callbackFunc runs as _completion selects: on the front executor,
+     * inline on the receiving thread, or posted to the executor of the caller
+     */
+    void asyncSendMessageByNodeID(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
+        bytesConstRef _data, uint32_t _timeout, CallbackFunc _callbackFunc,
+        const Completion& _completion);
+
+    /**
+     * @brief: send message like asyncSendMessageByNodeID
+     * @return the uuid of the request to cancel it, empty if failed to send
+     */
+    std::string asyncSendRequest(int _moduleID, bcos::crypto::NodeIDPtr _nodeID,
+        bytesConstRef _data, uint32_t _timeout, CallbackFunc _callbackFunc,
+        const Completion& _completion = Completion());
+
+    // encode _payload of _moduleID once for asyncSendFrame
+    FrontFrame::Ptr encodeFrame(int _moduleID, bytesConstRef _payload) const
+    {
+        return std::make_shared<const FrontFrame>(_moduleID, _payload);
+    }
+    /**
+     * @brief: send the frame like asyncSendRequest, to any node and any number of times, the
+     * payload is neither encoded nor copied again
+     * @return the uuid of the request to cancel it, empty if failed to send
+     */
+    std::string asyncSendFrame(FrontFrame::Ptr _frame, bcos::crypto::NodeIDPtr _nodeID,
+        uint32_t _timeout, CallbackFunc _callbackFunc,
+        const Completion& _completion = Completion());
+
+    /**
+     * @brief: cancel a pending request, its callback will never be called
+     * @param _uuid: the uuid returned by asyncSendRequest
+     * @return false if the request is not pending
+     */
+    bool cancelRequest(const std::string& _uuid);
 
     /**
      * @brief: send response
@@ -100,6 +170,23 @@ public:
      */
     void asyncSendBroadcastMessage(int _moduleID, bytesConstRef _data) override;
 
+    /**
+     * @brief: broadcast through the relay tree, the message is sent to _fanout nodes which
+     * forward it to _fanout nodes each, until all the nodes of the group receive it
+     * @param _fanout: the children of every node of the tree, the sender egress is _fanout
+     * frames and the depth of the tree log(n) / log(_fanout). A node the gateway fails to
+     * deliver to is bypassed by its parent, which sends to its children instead
+     */
+    void asyncSendRelayBroadcast(
+        int _moduleID, bytesConstRef _data, uint8_t _fanout = DEFAULT_RELAY_FANOUT);
+
+    /**
+     * @brief: send the message to _fanout peers sampled uniformly from the group, the message
+     * is encoded once for all of them
+     * @return the number of peers the message is sent to, less than _fanout in small groups
+     */
+    size_t asyncGossip(int _moduleID, bytesConstRef _data, size_t _fanout);
+
     /**
      * @brief: receive nodeIDs from gateway
      * @param _groupID: groupID
@@ -122,6 +209,16 @@ public:
     void onReceiveMessage(const std::string& _groupID, bcos::crypto::NodeIDPtr _nodeID,
         bytesConstRef _data, ReceiveMsgFunc _receiveMsgCallback) override;
 
+    /**
+     * @brief: receive a batch of frames from gateway, the messages of a module are dispatched in
+     * the received order by one task of the thread pool
+     * @param _frames: the node each frame comes from and the frame
+     * @param _receiveMsgCallback: called once for the whole batch
+     */
+    void onReceiveMessages(const std::string& _groupID,
+        const std::vector<std::pair<bcos::crypto::NodeIDPtr, bytesConstRef>>& _frames,
+        ReceiveMsgFunc _receiveMsgCallback);
+
     /**
      * @brief: receive broadcast message from gateway
      * @param _groupID: groupID
@@ -141,10 +238,18 @@ public:
      * @param _data: send data payload
      * @param isResponse: if send response message
      * @param _receiveMsgCallback: response callback
+     * @param _timeout: the time the sender waits for the response, in milliseconds, 0 if not
+     * waiting, carried as the deadline of the request when the header extension is enabled
+     * @param _reservation: the memory admitted for the frame, resized to it, the frame is
+     * charged if nullptr
      * @return void
      */
     void sendMessage(int _moduleID, bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid,
-        bytesConstRef _data, bool isResponse, ReceiveMsgFunc _receiveMsgCallback);
+        bytesConstRef _data, bool isResponse, ReceiveMsgFunc _receiveMsgCallback,
+        uint32_t _timeout = 0, MemoryAccountant::Ticket::Ptr _reservation = nullptr);
+    // send a request of the encoded frame, only the header is encoded
+    void sendFrame(FrontFrame::Ptr _frame, bcos::crypto::NodeIDPtr _nodeID,
+        const std::string& _uuid, ReceiveMsgFunc _receiveMsgCallback, uint32_t _timeout = 0);
 
     /**
      * @brief: handle message timeout
@@ -181,53 +286,194 @@ public:
         m_ioService = _ioService;
     }
 
+    FrontClock::Ptr clock() const { return m_clock; }
+    // the timeouts, the delayed sends and the round trips run on _clock, should be set before start
+    void setClock(FrontClock::Ptr _clock) { m_clock = _clock; }
+
     bcos::ThreadPool::Ptr threadPool() const { return m_threadPool; }
-    void setThreadPool(bcos::ThreadPool::Ptr _threadPool) { m_threadPool = _threadPool; }
+    void setThreadPool(bcos::ThreadPool::Ptr _threadPool)
+    {
+        m_threadPool = _threadPool;
+        m_executor = _threadPool ? std::make_shared<ThreadPoolExecutor>(_threadPool) : nullptr;
+    }
 
-    // register message _dispatcher for module
-    void registerModuleMessageDispatcher(int _moduleID,
-        std::function<void(
-            bcos::crypto::NodeIDPtr _nodeID, const std::string& _id, bytesConstRef _data)>
-            _dispatcher)
+    FrontExecutor::Ptr executor() const { return m_executor; }
+    // run the dispatch and callback tasks on _executor instead of the thread pool
+    void setExecutor(FrontExecutor::Ptr _executor) { m_executor = _executor; }
+
+    const ThreadPlacementPolicy& threadPlacement() const { return m_threadPlacement; }
+    // pin the io thread to _placement.ioCpus when started, should be called before start
+    void setThreadPlacement(const ThreadPlacementPolicy& _placement)
+    {
+        m_threadPlacement = _placement;
+    }
+
+    FlightRecorder::Ptr flightRecorder() const { return m_flightRecorder; }
+    // enable the flight recorder, should be called before start
+    void setFlightRecorder(FlightRecorder::Ptr _flightRecorder)
+    {
+        m_flightRecorder = _flightRecorder;
+    }
+
+    FrameCapture::Ptr frameCapture() const { return std::atomic_load(&m_frameCapture); }
+    // capture the inbound frames into a trace file, nullptr to stop capturing
+    void setFrameCapture(FrameCapture::Ptr _frameCapture)
+    {
+        std::atomic_store(&m_frameCapture, _frameCapture);
+        m_capturing.store(_frameCapture != nullptr, std::memory_order_relaxed);
+    }
+
+    bool headerExtensionEnabled() const { return m_headerExtensionEnabled; }
+    /**
+     * @brief: emit the trace header extension on the outbound messages, the receivers must
+     * understand the extension, so only enable it when all the peers do
+     */
+    void setHeaderExtensionEnabled(bool _enabled) { m_headerExtensionEnabled = _enabled; }
+
+    // latency of the inbound messages per module and peer, collected only with the header
+    // extension enabled
+    LatencyStats::Ptr latencyStats() const { return m_latencyStats; }
+    // inbound requests waiting for a dispatch thread
+    DispatchQueue::Ptr dispatchQueue() const { return m_dispatchQueue; }
+
+    // round trip estimates and policies of the ADAPTIVE_TIMEOUT requests
+    AdaptiveTimeout::Ptr adaptiveTimeout() const { return m_adaptiveTimeout; }
+
+    PeerCircuitBreaker::Ptr circuitBreaker() const { return m_circuitBreaker; }
+    /**
+     * @brief: enable the per peer circuit breaker, should be called before start, the requests
+     * to a peer whose breaker is open fail with FrontError::CircuitOpen without being sent
+     */
+    void setCircuitBreaker(PeerCircuitBreaker::Ptr _circuitBreaker)
     {
-        m_moduleID2MessageDispatcher[_moduleID] = _dispatcher;
+        m_circuitBreaker = _circuitBreaker;
     }
 
+    // the fanout asyncSendBroadcastMessage of _moduleID relays with, 0 for a direct broadcast
+    uint8_t relayBroadcastFanout(int _moduleID) const;
+    /**
+     * @brief: broadcast the messages of _moduleID through the relay tree, 0 to broadcast them
+     * directly again. The peers must decode the header extension.
+     */
+    void setRelayBroadcast(int _moduleID, uint8_t _fanout);
+    // the relayed broadcasts seen by the node
+    RelayDedup::Ptr relayDedup() const { return m_relayDedup; }
+
+    // shapes the requests and broadcasts of the modules with a RateLimit, the requests over the
+    // budget fail with FrontError::RateLimited or are delayed, see RateLimit::Overflow
+    OutboundRateLimiter::Ptr rateLimiter() const { return m_rateLimiter; }
+
+    /**
+     * @brief: the bytes held by the front per module and direction, the requests above the limits
+     * set on it are rejected: the inbound ones are shed as by the load shedder, the outbound ones
+     * fail with FrontError::MemoryExhausted. The sheddable modules give way at the high-water mark
+     */
+    MemoryAccountant::Ptr memoryAccountant() const { return m_memoryAccountant; }
+    // nullptr runs the front without memory accounting nor limits, should be called before start
+    void setMemoryAccountant(MemoryAccountant::Ptr _memoryAccountant)
+    {
+        m_memoryAccountant = _memoryAccountant;
+    }
+
+    LoadShedder::Ptr loadShedder() const { return m_loadShedder; }
+    // replace the load shedder to change the target and interval, should be called before start
+    void setLoadShedder(LoadShedder::Ptr _loadShedder) { m_loadShedder = _loadShedder; }
+
+    // register message _dispatcher for module, safe to be called after start
+    void registerModuleMessageDispatcher(int _moduleID, MessageDispatcher _dispatcher);
+
+    /**
+     * @brief: register the dispatcher of a module whose requests can be cancelled, the token
+     * passed to _dispatcher is cancelled when the cancel frame of the request arrives
+     */
+    void registerModuleCancellableDispatcher(int _moduleID, CancellableDispatcher _dispatcher);
+
+    /**
+     * @brief: register a dispatcher run on the receiving thread of the gateway against the
+     * received frame, without copying the payload nor hopping to the thread pool; for the tiny
+     * non-blocking handlers only, they are neither shed nor queued by deadline
+     * @param _budget: microseconds a dispatch may take before the watchdog warns about it
+     */
+    void registerModuleInlineDispatcher(int _moduleID, MessageDispatcher _dispatcher,
+        uint64_t _budget = InlineWatchdog::DEFAULT_BUDGET);
+
+    // unregister message dispatcher for module, return false if not registered
+    bool unregisterModuleMessageDispatcher(int _moduleID);
+
+    InlineWatchdog::Ptr inlineWatchdog() const { return m_inlineWatchdog; }
+
+    // tokens of the pending inbound requests of the cancellable modules
+    CancellationRegistry::Ptr cancellationRegistry() const { return m_cancellationRegistry; }
+
     // register nodeIDs _dispatcher for module
     void registerModuleNodeIDsDispatcher(int _moduleID,
         std::function<void(
             std::shared_ptr<const crypto::NodeIDs> _nodeIDs, ReceiveMsgFunc _receiveMsgCallback)>
             _dispatcher)
     {
+        WriteGuard l(x_nodeIDsDispatcher);
         m_moduleID2NodeIDsDispatcher[_moduleID] = _dispatcher;
     }
 
+    // register nodeIDs delta _dispatcher for module, only called when the node list changes
+    void registerModuleNodeIDsDeltaDispatcher(int _moduleID,
+        std::function<void(NodeIDsDelta::Ptr _delta, ReceiveMsgFunc _receiveMsgCallback)>
+            _dispatcher)
+    {
+        WriteGuard l(x_nodeIDsDispatcher);
+        m_moduleID2NodeIDsDeltaDispatcher[_moduleID] = _dispatcher;
+    }
+
+    // the latest nodeIDs snapshot, lock free
+    NodeIDsSnapshot::Ptr nodeIDsSnapshot() const { return m_nodeIDsSnapshot.load(); }
+
+    // check if the node is in the latest nodeIDs pushed by the gateway
+    bool isConnected(bcos::crypto::NodeIDPtr _nodeID) const
+    {
+        return nodeIDsSnapshot()->contains(_nodeID);
+    }
+
 public:
     struct Callback : public std::enable_shared_from_this<Callback>
     {
         using Ptr = std::shared_ptr<Callback>;
-        uint64_t startTime = utcSteadyTime();
+        // steady time of the front clock in milliseconds
+        uint64_t startTime = 0;
+        int moduleID = 0;
+        bcos::crypto::NodeIDPtr nodeID;
         CallbackFunc callbackFunc;
-        std::shared_ptr<boost::asio::deadline_timer> timeoutHandler;
+        Completion completion;
+        FrontTimer::Ptr timeoutHandler;
+        // the memory of the pending request
+        MemoryAccountant::Ticket::Ptr memoryTicket;
     };
     // lock m_callback
     mutable bcos::RecursiveMutex x_callback;
     // uuid to callback
     std::unordered_map<std::string, Callback::Ptr> m_callback;
+    // nodeID to the uuids of m_callback sent to it, locked by x_callback
+    std::unordered_map<bcos::crypto::NodeIDPtr, std::unordered_set<std::string>, NodeIDHasher,
+        NodeIDEqual>
+        m_peer2Callbacks;
 
     const std::unordered_map<std::string, Callback::Ptr>& callback() const { return m_callback; }
 
-    const std::unordered_map<int, std::function<void(bcos::crypto::NodeIDPtr _nodeID,
-                                      const std::string& _id, bytesConstRef _data)>>
-    moduleID2MessageDispatcher() const
+    // copy of the registered message dispatchers, not for the hot path
+    const std::unordered_map<int, MessageDispatcher> moduleID2MessageDispatcher() const
     {
-        return m_moduleID2MessageDispatcher;
+        std::unordered_map<int, MessageDispatcher> dispatchers;
+        m_moduleID2MessageDispatcher.forEach(
+            [&dispatchers](uint16_t _moduleID, const std::shared_ptr<const MessageDispatcher>& _d) {
+                dispatchers[_moduleID] = *_d;
+            });
+        return dispatchers;
     }
 
     std::unordered_map<int, std::function<void(std::shared_ptr<const crypto::NodeIDs> _nodeIDs,
                                 ReceiveMsgFunc _receiveMsgCallback)>>
     moduleID2NodeIDsDispatcher() const
     {
+        ReadGuard l(x_nodeIDsDispatcher);
         return m_moduleID2NodeIDsDispatcher;
     }
 
@@ -242,6 +488,7 @@ public:
             {
                 callback = it->second;
                 m_callback.erase(it);
+                removePeerCallback(callback->nodeID, _uuid);
             }
         }
 
@@ -251,43 +498,239 @@ public:
     void addCallback(const std::string& _uuid, Callback::Ptr _callback)
     {
         RecursiveGuard l(x_callback);
-        m_callback[_uuid] = _callback;
+        auto& callback = m_callback[_uuid];
+        if (callback)
+        {
+            removePeerCallback(callback->nodeID, _uuid);
+        }
+        callback = _callback;
+        if (_callback->nodeID)
+        {
+            m_peer2Callbacks[_callback->nodeID].insert(_uuid);
+        }
     }
 
+    // uuids of the pending requests sent to _nodeID
+    std::vector<std::string> pendingRequests(bcos::crypto::NodeIDPtr _nodeID) const
+    {
+        RecursiveGuard l(x_callback);
+        auto it = m_peer2Callbacks.find(_nodeID);
+        if (it == m_peer2Callbacks.end())
+        {
+            return std::vector<std::string>();
+        }
+        return std::vector<std::string>(it->second.begin(), it->second.end());
+    }
+
+    /**
+     * @brief: fail all the pending requests sent to _nodeID with FrontError::PeerDisconnected,
+     * called when the gateway reports the peer unreachable and when it leaves the node list
+     * @return the number of failed requests
+     */
+    size_t onPeerDisconnected(bcos::crypto::NodeIDPtr _nodeID);
+
 protected:
+    // called with x_callback held
+    void removePeerCallback(const bcos::crypto::NodeIDPtr& _nodeID, const std::string& _uuid)
+    {
+        if (!_nodeID)
+        {
+            return;
+        }
+        auto it = m_peer2Callbacks.find(_nodeID);
+        if (it != m_peer2Callbacks.end())
+        {
+            it->second.erase(_uuid);
+            if (it->second.empty())
+            {
+                m_peer2Callbacks.erase(it);
+            }
+        }
+    }
+
+    // charge _bytes to the accountant if any
+    MemoryAccountant::Ticket::Ptr chargeMemory(
+        uint16_t _moduleID, MemoryDirection _direction, size_t _bytes)
+    {
+        return m_memoryAccountant ? m_memoryAccountant->charge(_moduleID, _direction, _bytes) :
+                                    nullptr;
+    }
+
+    // index of _nodeID for the flight records, only looked up with the flight recorder enabled
+    int64_t flightPeerIndex(const bcos::crypto::NodeIDPtr& _nodeID) const
+    {
+        return m_flightRecorder ? nodeIDsSnapshot()->indexOf(_nodeID) : -1;
+    }
+
+    void recordFlight(FlightEvent _event, int _moduleID, int64_t _peerIndex,
+        const std::string& _uuid, size_t _size)
+    {
+        if (m_flightRecorder)
+        {
+            m_flightRecorder->record(
+                _event, _moduleID, _peerIndex, FlightRecorder::requestID(_uuid), _size);
+        }
+    }
+
+    void recordFlight(FlightEvent _event, int _moduleID, const bcos::crypto::NodeIDPtr& _nodeID,
+        const std::string& _uuid, size_t _size)
+    {
+        if (m_flightRecorder)
+        {
+            recordFlight(_event, _moduleID, flightPeerIndex(_nodeID), _uuid, _size);
+        }
+    }
+
     virtual void handleCallback(bcos::Error::Ptr _error, bytesConstRef _payLoad,
         std::string const& _uuid, int _moduleID, bcos::crypto::NodeIDPtr _nodeID);
 
+    // add the trace and deadline extension to _message if enabled
+    void setHeaderExtension(
+        FrontMessage::Ptr _message, const std::string& _uuid, uint32_t _timeout);
+    // wrap the cancellable dispatcher of _moduleID with the token of the request
+    std::shared_ptr<const MessageDispatcher> cancellableDispatcher(uint16_t _moduleID,
+        bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid, uint64_t _deadline);
+    // broadcast without the rate limiter
+    void broadcastMessage(int _moduleID, bytesConstRef _data);
+
+    // the messages of a module received by one onReceiveMessages call
+    struct DispatchBatch
+    {
+        struct Entry
+        {
+            bcos::crypto::NodeIDPtr nodeID;
+            std::string uuid;
+            std::shared_ptr<const MessageDispatcher> dispatcher;
+            // the payload in payloads
+            size_t offset;
+            size_t size;
+            uint64_t deadline;
+            // see flightPeerIndex
+            int64_t peerIndex;
+        };
+        std::vector<Entry> entries;
+        // the payloads back to back
+        bytes payloads;
+        // the memory admitted for the payloads
+        std::vector<MemoryAccountant::Ticket::Ptr> tickets;
+    };
+    using DispatchBatches = std::map<uint16_t, DispatchBatch>;
+    /**
+     * @brief: decode and handle a frame, the messages for the thread pool are added to _batches
+     * if not nullptr, queued one by one otherwise
+     */
+    void receiveFrame(const std::string& _groupID, bcos::crypto::NodeIDPtr _nodeID,
+        bytesConstRef _data, DispatchBatches* _batches);
+    void dispatchBatch(uint16_t _moduleID, DispatchBatch&& _batch);
+    // ack the frames to the gateway, on the thread pool if any
+    void acknowledge(ReceiveMsgFunc _receiveMsgCallback);
+    // scan the running inline dispatches every SCAN_INTERVAL on the io thread while running
+    void watchInlineDispatchers();
+    void scanInlineDispatchers();
+    // run _send on the io thread after _delay microseconds, unless the front is destroyed
+    void sendLater(uint64_t _delay, std::function<void()> _send);
+    // the request of asyncSendRequest and asyncSendFrame, _frame holds _data if not null
+    std::string sendRequest(int _moduleID, bcos::crypto::NodeIDPtr _nodeID, bytesConstRef _data,
+        FrontFrame::Ptr _frame, uint32_t _timeout, CallbackFunc _callbackFunc,
+        const Completion& _completion);
+    // fail the request without sending it, as _completion selects
+    void failRequest(CallbackFunc _callbackFunc, bcos::crypto::NodeIDPtr _nodeID,
+        bcos::Error::Ptr _error, const Completion& _completion);
+    // run the callback of a request as _completion selects, _payload is copied once if the
+    // callback runs after the return, _continuation for the responses
+    void complete(const Completion& _completion, int _moduleID, bool _continuation,
+        const CallbackFunc& _callbackFunc, bcos::Error::Ptr _error,
+        bcos::crypto::NodeIDPtr _nodeID, bytesConstRef _payload, const std::string& _uuid,
+        std::function<void(bytesConstRef)> _respFunc);
+    // feed the outcome of a request to the circuit breaker
+    void reportPeerOutcome(const bcos::crypto::NodeIDPtr& _nodeID, const bcos::Error::Ptr& _error);
+    // tell the responder the request is cancelled
+    void sendCancel(int _moduleID, bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid);
+    // reply a request rejected by the load shedder without dispatching it
+    void sendOverloadedResponse(
+        int _moduleID, bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid);
+    // the relay tree of the broadcast over the nodeIDs known to this node
+    std::shared_ptr<const RelayTree> relayTree(FrontMessageExtension const& _extension) const;
+    /**
+     * @brief: send _frame to the children of the node at _position one by one, the subtree of a
+     * child failing to receive it is taken over: its children are sent to instead
+     */
+    void relayForward(std::shared_ptr<const RelayTree> _tree, size_t _position,
+        std::shared_ptr<const bytes> _frame);
+    // steady time in microseconds the request is useless after, NO_DEADLINE if it has none
+    uint64_t dispatchDeadline(FrontMessageExtension const& _extension, uint64_t _receiveTime);
+
 private:
     // thread pool
     bcos::ThreadPool::Ptr m_threadPool;
+    // runs the tasks, on m_threadPool unless set otherwise, everything inline if nullptr
+    FrontExecutor::Ptr m_executor;
     // timer
     std::shared_ptr<boost::asio::io_service> m_ioService;
+    // the time source of the timers, an AsioClock on m_ioService by default
+    FrontClock::Ptr m_clock;
     /// gateway interface
     std::shared_ptr<bcos::gateway::GatewayInterface> m_gatewayInterface;
 
     FrontMessageFactory::Ptr m_messageFactory;
+    // records the front traffic, disabled if nullptr
+    FlightRecorder::Ptr m_flightRecorder;
+    // captures the inbound frames, disabled if nullptr
+    FrameCapture::Ptr m_frameCapture;
+    // checked on every inbound frame before loading m_frameCapture, which may take a lock
+    std::atomic<bool> m_capturing = {false};
+    // emit the header extension on the outbound messages
+    bool m_headerExtensionEnabled = false;
+    LatencyStats::Ptr m_latencyStats = std::make_shared<LatencyStats>();
+    DispatchQueue::Ptr m_dispatchQueue = std::make_shared<DispatchQueue>();
+    AdaptiveTimeout::Ptr m_adaptiveTimeout = std::make_shared<AdaptiveTimeout>();
+    // fails fast the requests to the failing peers, disabled if nullptr
+    PeerCircuitBreaker::Ptr m_circuitBreaker;
+    // sheds the requests of the sheddable modules once the dispatch queue delay is too long
+    LoadShedder::Ptr m_loadShedder = std::make_shared<LoadShedder>();
+    RelayDedup::Ptr m_relayDedup = std::make_shared<RelayDedup>();
+    OutboundRateLimiter::Ptr m_rateLimiter = std::make_shared<OutboundRateLimiter>();
+    MemoryAccountant::Ptr m_memoryAccountant = std::make_shared<MemoryAccountant>();
+    // moduleID => fanout of the relayed broadcasts
+    mutable bcos::SharedMutex x_relayFanouts;
+    std::unordered_map<int, uint8_t> m_relayFanouts;
+
+    // moduleID => message dispatcher, lock free lookup for the receive path
+    ModuleDispatcherTable<MessageDispatcher> m_moduleID2MessageDispatcher;
+    ModuleDispatcherTable<CancellableDispatcher> m_moduleID2CancellableDispatcher;
+    struct InlineDispatcher
+    {
+        MessageDispatcher dispatcher;
+        uint64_t budget;
+    };
+    ModuleDispatcherTable<InlineDispatcher> m_moduleID2InlineDispatcher;
+    InlineWatchdog::Ptr m_inlineWatchdog = std::make_shared<InlineWatchdog>();
+    std::atomic<bool> m_inlineWatched = {false};
+    CancellationRegistry::Ptr m_cancellationRegistry = std::make_shared<CancellationRegistry>();
 
-    std::unordered_map<int, std::function<void(bcos::crypto::NodeIDPtr _nodeID,
-                                const std::string& _id, bytesConstRef _data)>>
-        m_moduleID2MessageDispatcher;
-
+    // lock m_moduleID2NodeIDsDispatcher and m_moduleID2NodeIDsDeltaDispatcher
+    mutable bcos::SharedMutex x_nodeIDsDispatcher;
     std::unordered_map<int, std::function<void(std::shared_ptr<const crypto::NodeIDs> _nodeIDs,
                                 ReceiveMsgFunc _receiveMsgCallback)>>
         m_moduleID2NodeIDsDispatcher;
 
+    std::unordered_map<int,
+        std::function<void(NodeIDsDelta::Ptr _delta, ReceiveMsgFunc _receiveMsgCallback)>>
+        m_moduleID2NodeIDsDeltaDispatcher;
+
     // service is running or not
     bool m_run = false;
     //
     std::shared_ptr<std::thread> m_frontServiceThread;
+    ThreadPlacementPolicy m_threadPlacement;
     // NodeID
     bcos::crypto::NodeIDPtr m_nodeID;
     // GroupID
     std::string m_groupID;
-    // lock m_callback
+    // serialize the updates of m_nodeIDsSnapshot, readers are lock free
     mutable bcos::Mutex x_nodeIDs;
-    // nodeIDs pushed by the gateway
-    std::shared_ptr<const bcos::crypto::NodeIDs> m_nodeIDs;
+    // nodeIDs pushed by the gateway, the replaced snapshots are reclaimed by epoch
+    EpochSlot<NodeIDsSnapshot> m_nodeIDsSnapshot{std::make_shared<const NodeIDsSnapshot>()};
 };
 }  // namespace front
 }  // namespace bcos
\ No newline at end of file
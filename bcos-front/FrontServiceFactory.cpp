@@ -46,6 +46,8 @@ FrontService::Ptr FrontServiceFactory::buildFrontService(
     FRONT_LOG(INFO) << LOG_DESC("FrontServiceFactory::buildFrontService")
                     << LOG_KV("groupID", _groupID) << LOG_KV("nodeID", _nodeID->hex());
 
+    placeThreadPool();
+
     auto factory = std::make_shared<FrontMessageFactory>();
     auto ioService = std::make_shared<boost::asio::io_service>();
     auto frontService = std::make_shared<FrontService>();
@@ -54,8 +56,41 @@ FrontService::Ptr FrontServiceFactory::buildFrontService(
     frontService->setGroupID(_groupID);
     frontService->setNodeID(_nodeID);
     frontService->setIoService(ioService);
+    frontService->setClock(m_clock ? m_clock : std::make_shared<AsioClock>(ioService));
     frontService->setGatewayInterface(m_gatewayInterface);
     frontService->setThreadPool(m_threadPool);
+    if (m_executor)
+    {
+        frontService->setExecutor(m_executor);
+    }
+    frontService->setHeaderExtensionEnabled(m_headerExtensionEnabled);
+    if (!m_memoryAccountingEnabled)
+    {
+        frontService->setMemoryAccountant(nullptr);
+    }
+    frontService->setThreadPlacement(m_threadPlacement);
 
     return frontService;
-}
\ No newline at end of file
+}
+
+void FrontServiceFactory::placeThreadPool()
+{
+    auto const& workerCpus = m_threadPlacement.workerCpus;
+    // the executor is placed by its creator
+    if (workerCpus.empty() || m_threadPoolPlaced || m_executor)
+    {
+        return;
+    }
+    auto workerThreads =
+        m_threadPlacement.workerThreads ? m_threadPlacement.workerThreads : workerCpus.size();
+    if (!m_threadPool)
+    {
+        m_threadPool = std::make_shared<bcos::ThreadPool>("frontService", workerThreads);
+    }
+    auto placed = bcos::front::placeThreadPool(
+        m_threadPool, workerThreads, workerCpus, m_threadPlacement.numaLocalMemory);
+    m_threadPoolPlaced = true;
+    FRONT_LOG(INFO) << LOG_DESC("FrontServiceFactory::placeThreadPool")
+                    << LOG_KV("workerThreads", workerThreads) << LOG_KV("placed", placed)
+                    << LOG_KV("numaNode", numaNodeOfCpu(workerCpus.front()));
+}
@@ -49,11 +49,47 @@ public:
         m_threadPool = _threadPool;
     }
 
+    FrontClock::Ptr clock() const { return m_clock; }
+    // share _clock between the built front services, each runs on its own io service otherwise
+    void setClock(FrontClock::Ptr _clock) { m_clock = _clock; }
+
+    FrontExecutor::Ptr executor() const { return m_executor; }
+    // run the tasks of the built front services on _executor instead of the thread pool
+    void setExecutor(FrontExecutor::Ptr _executor) { m_executor = _executor; }
+
+    bool headerExtensionEnabled() const { return m_headerExtensionEnabled; }
+    // emit the trace header extension on the messages of the built front services
+    void setHeaderExtensionEnabled(bool _enabled) { m_headerExtensionEnabled = _enabled; }
+
+    bool memoryAccountingEnabled() const { return m_memoryAccountingEnabled; }
+    // account the memory held by the built front services, may be disabled if no limit is set
+    void setMemoryAccountingEnabled(bool _enabled) { m_memoryAccountingEnabled = _enabled; }
+
+    const ThreadPlacementPolicy& threadPlacement() const { return m_threadPlacement; }
+    /**
+     * @brief: pin the io threads of the built front services and the dispatch workers, a
+     * thread pool of placement.workerThreads workers is created if none is set
+     */
+    void setThreadPlacement(const ThreadPlacementPolicy& _placement)
+    {
+        m_threadPlacement = _placement;
+        m_threadPoolPlaced = false;
+    }
+
 private:
+    void placeThreadPool();
+
     // gatewayInterface
     bcos::gateway::GatewayInterface::Ptr m_gatewayInterface;
     // threadpool
     std::shared_ptr<bcos::ThreadPool> m_threadPool;
+    FrontExecutor::Ptr m_executor;
+    bool m_headerExtensionEnabled = false;
+    bool m_memoryAccountingEnabled = true;
+    FrontClock::Ptr m_clock;
+    ThreadPlacementPolicy m_threadPlacement;
+    // the workers of m_threadPool are shared by the built front services, place them once
+    bool m_threadPoolPlaced = false;
 };
 
 }  // namespace front
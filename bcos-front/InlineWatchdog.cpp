@@ -0,0 +1,125 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief watch the inline dispatchers running on the receiving threads against their budget
+ * @file InlineWatchdog.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/Common.h>
+#include <bcos-front/InlineWatchdog.h>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::front;
+
+InlineWatchdog::Scope::Scope(InlineWatchdog& _watchdog, uint16_t _moduleID, uint64_t _budget)
+  : m_watchdog(_watchdog),
+    m_moduleID(_moduleID),
+    m_budget(_budget),
+    m_startTime(utcSteadyTimeUs()),
+    m_slot(_watchdog.acquire(_moduleID, _budget, m_startTime))
+{}
+
+InlineWatchdog::Scope::~Scope()
+{
+    m_watchdog.release(m_slot, m_moduleID, m_budget, utcSteadyTimeUs() - m_startTime);
+}
+
+size_t InlineWatchdog::acquire(uint16_t _moduleID, uint64_t _budget, uint64_t _startTime)
+{
+    // start from a slot of the thread, the receiving threads rarely collide
+    thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+    for (size_t i = 0; i < SLOT_COUNT; ++i)
+    {
+        auto index = (hint + i) % SLOT_COUNT;
+        auto& slot = m_slots[index];
+        bool expected = false;
+        if (!slot.busy.load(std::memory_order_relaxed) &&
+            slot.busy.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            slot.moduleID.store(_moduleID, std::memory_order_relaxed);
+            slot.budget.store(_budget, std::memory_order_relaxed);
+            slot.reported.store(false, std::memory_order_relaxed);
+            // publish the slot to scan()
+            slot.startTime.store(_startTime, std::memory_order_release);
+            return index;
+        }
+    }
+    return NO_SLOT;
+}
+
+void InlineWatchdog::release(size_t _slot, uint16_t _moduleID, uint64_t _budget, uint64_t _elapsed)
+{
+    if (_slot != NO_SLOT)
+    {
+        auto& slot = m_slots[_slot];
+        slot.startTime.store(0, std::memory_order_relaxed);
+        slot.busy.store(false, std::memory_order_release);
+    }
+    if (_elapsed <= _budget)
+    {
+        return;
+    }
+    m_overruns.fetch_add(1, std::memory_order_relaxed);
+    {
+        Guard l(x_modules);
+        auto& overrun = m_modules.emplace(_moduleID, InlineOverrun{_moduleID, 0, 0}).first->second;
+        overrun.count++;
+        overrun.maxElapsed = std::max(overrun.maxElapsed, _elapsed);
+    }
+    FRONT_LOG(WARNING) << LOG_BADGE("InlineWatchdog")
+                       << LOG_DESC("inline dispatcher over its budget, dispatch it to the pool")
+                       << LOG_KV("moduleID", _moduleID) << LOG_KV("elapsed(us)", _elapsed)
+                       << LOG_KV("budget(us)", _budget);
+}
+
+size_t InlineWatchdog::scan(uint64_t _now)
+{
+    size_t found = 0;
+    for (auto& slot : m_slots)
+    {
+        auto startTime = slot.startTime.load(std::memory_order_acquire);
+        if (startTime == 0 || _now <= startTime)
+        {
+            continue;
+        }
+        auto budget = slot.budget.load(std::memory_order_relaxed);
+        if (_now - startTime <= budget || slot.reported.exchange(true, std::memory_order_relaxed))
+        {
+            continue;
+        }
+        found++;
+        FRONT_LOG(WARNING) << LOG_BADGE("InlineWatchdog")
+                           << LOG_DESC("inline dispatcher still running over its budget")
+                           << LOG_KV("moduleID", slot.moduleID.load(std::memory_order_relaxed))
+                           << LOG_KV("running(us)", _now - startTime)
+                           << LOG_KV("budget(us)", budget);
+    }
+    return found;
+}
+
+std::vector<InlineOverrun> InlineWatchdog::snapshot() const
+{
+    std::vector<InlineOverrun> overruns;
+    Guard l(x_modules);
+    for (auto const& entry : m_modules)
+    {
+        overruns.emplace_back(entry.second);
+    }
+    return overruns;
+}
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief watch the inline dispatchers running on the receiving threads against their budget
+ * @file InlineWatchdog.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <array>
+#include <atomic>
+#include <map>
+
+namespace bcos
+{
+namespace front
+{
+struct InlineOverrun
+{
+    uint16_t moduleID;
+    // number of dispatches over the budget
+    uint64_t count;
+    // the longest of them, in microseconds
+    uint64_t maxElapsed;
+};
+
+/**
+ * the inline dispatchers hold the receiving thread of the gateway: each dispatch occupies a slot
+ * while running, scan() warns about the ones still running past their budget (a blocked handler
+ * never returns to be measured), the finished ones are checked when leaving the slot
+ */
+class InlineWatchdog
+{
+public:
+    using Ptr = std::shared_ptr<InlineWatchdog>;
+
+    // the dispatches watched concurrently, the others are only measured once finished
+    constexpr static size_t SLOT_COUNT = 64;
+    // budget of an inline dispatch in microseconds
+    constexpr static uint64_t DEFAULT_BUDGET = 100;
+    // interval of scan() in microseconds
+    constexpr static uint64_t SCAN_INTERVAL = 10 * 1000;
+
+    InlineWatchdog() = default;
+    InlineWatchdog(const InlineWatchdog&) = delete;
+    InlineWatchdog& operator=(const InlineWatchdog&) = delete;
+
+    // watches an inline dispatch for its lifetime
+    class Scope
+    {
+    public:
+        Scope(InlineWatchdog& _watchdog, uint16_t _moduleID, uint64_t _budget);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        InlineWatchdog& m_watchdog;
+        uint16_t m_moduleID;
+        uint64_t m_budget;
+        uint64_t m_startTime;
+        size_t m_slot;
+    };
+
+    /**
+     * @brief: warn about the dispatches running past their budget, once per dispatch
+     * @param _now: the steady time in microseconds
+     * @return the number of dispatches found
+     */
+    size_t scan(uint64_t _now);
+    size_t scan() { return scan(utcSteadyTimeUs()); }
+
+    // number of the finished dispatches over their budget
+    uint64_t overruns() const { return m_overruns.load(std::memory_order_relaxed); }
+    // the modules with overruns, sorted by moduleID
+    std::vector<InlineOverrun> snapshot() const;
+
+private:
+    constexpr static size_t NO_SLOT = SLOT_COUNT;
+
+    struct Slot
+    {
+        std::atomic<bool> busy = {false};
+        // 0 if the slot is not published yet
+        std::atomic<uint64_t> startTime = {0};
+        std::atomic<uint64_t> budget = {0};
+        std::atomic<uint16_t> moduleID = {0};
+        std::atomic<bool> reported = {false};
+    };
+
+    size_t acquire(uint16_t _moduleID, uint64_t _budget, uint64_t _startTime);
+    void release(size_t _slot, uint16_t _moduleID, uint64_t _budget, uint64_t _elapsed);
+
+    std::array<Slot, SLOT_COUNT> m_slots;
+    std::atomic<uint64_t> m_overruns = {0};
+    mutable bcos::Mutex x_modules;
+    std::map<uint16_t, InlineOverrun> m_modules;
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief one-way delay and queueing time of the inbound messages, per module and peer
+ * @file LatencyStats.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/LatencyStats.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::front;
+
+LatencyEntry& LatencyStats::entry(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID)
+{
+    auto it = m_entries.find(Key(_moduleID, _nodeID));
+    if (it == m_entries.end())
+    {
+        LatencyEntry entry;
+        entry.moduleID = _moduleID;
+        entry.nodeID = _nodeID;
+        it = m_entries.emplace(Key(_moduleID, _nodeID), entry).first;
+    }
+    return it->second;
+}
+
+void LatencyStats::recordOneWayDelay(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID,
+    uint64_t _sendTime, uint64_t _receiveTime, uint8_t _hops)
+{
+    Guard l(x_entries);
+    auto& latency = entry(_moduleID, _nodeID);
+    if (_receiveTime >= _sendTime)
+    {
+        latency.oneWayDelay.add(_receiveTime - _sendTime);
+    }
+    else
+    {
+        latency.skewed++;
+        latency.oneWayDelay.add(0);
+    }
+    latency.maxHops = std::max(latency.maxHops, _hops);
+}
+
+void LatencyStats::recordQueueTime(
+    uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID, uint64_t _queueTime)
+{
+    Guard l(x_entries);
+    entry(_moduleID, _nodeID).queueTime.add(_queueTime);
+}
+
+std::vector<LatencyEntry> LatencyStats::snapshot() const
+{
+    std::vector<LatencyEntry> entries;
+    {
+        Guard l(x_entries);
+        entries.reserve(m_entries.size());
+        for (auto const& it : m_entries)
+        {
+            entries.push_back(it.second);
+        }
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const LatencyEntry& _lhs, const LatencyEntry& _rhs) {
+            return _lhs.moduleID < _rhs.moduleID;
+        });
+    return entries;
+}
+
+void LatencyStats::reset()
+{
+    Guard l(x_entries);
+    m_entries.clear();
+}
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief one-way delay and queueing time of the inbound messages, per module and peer
+ * @file LatencyStats.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/NodeIDsSnapshot.h>
+
+namespace bcos
+{
+namespace front
+{
+/// count, sum and max of a latency, in microseconds
+struct LatencyStat
+{
+    uint64_t count = 0;
+    uint64_t total = 0;
+    uint64_t max = 0;
+    uint64_t last = 0;
+
+    void add(uint64_t _value)
+    {
+        count++;
+        total += _value;
+        max = std::max(max, _value);
+        last = _value;
+    }
+    uint64_t mean() const { return count ? total / count : 0; }
+};
+
+struct LatencyEntry
+{
+    uint16_t moduleID = 0;
+    bcos::crypto::NodeIDPtr nodeID;
+    // receive time minus the sender's enqueue time, includes the clock skew of the two nodes
+    LatencyStat oneWayDelay;
+    // time the message waited for a dispatch thread on this node
+    LatencyStat queueTime;
+    // messages whose send time is later than the receive time, counted as 0 delay
+    uint64_t skewed = 0;
+    uint8_t maxHops = 0;
+};
+
+class LatencyStats
+{
+public:
+    using Ptr = std::shared_ptr<LatencyStats>;
+
+    LatencyStats() = default;
+    LatencyStats(const LatencyStats&) = delete;
+    LatencyStats& operator=(const LatencyStats&) = delete;
+
+    /**
+     * @brief: record the one-way delay of a message carrying a trace extension
+     * @param _sendTime: the sender's enqueue time, in microseconds since epoch
+     * @param _receiveTime: the local receive time, in microseconds since epoch
+     */
+    void recordOneWayDelay(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID,
+        uint64_t _sendTime, uint64_t _receiveTime, uint8_t _hops);
+
+    // record the time a message waited between receive and dispatch, in microseconds
+    void recordQueueTime(
+        uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID, uint64_t _queueTime);
+
+    // copy of the stats, ordered by moduleID
+    std::vector<LatencyEntry> snapshot() const;
+    void reset();
+
+private:
+    using Key = std::pair<uint16_t, bcos::crypto::NodeIDPtr>;
+    struct KeyHasher
+    {
+        size_t operator()(const Key& _key) const
+        {
+            return NodeIDHasher()(_key.second) * 31 + _key.first;
+        }
+    };
+    struct KeyEqual
+    {
+        bool operator()(const Key& _lhs, const Key& _rhs) const
+        {
+            return _lhs.first == _rhs.first && NodeIDEqual()(_lhs.second, _rhs.second);
+        }
+    };
+
+    LatencyEntry& entry(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID);
+
+    mutable bcos::Mutex x_entries;
+    std::unordered_map<Key, LatencyEntry, KeyHasher, KeyEqual> m_entries;
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief CoDel style overload detection on the dispatch queue delay
+ * @file LoadShedder.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/Common.h>
+#include <bcos-front/LoadShedder.h>
+
+using namespace bcos;
+using namespace bcos::front;
+
+LoadShedder::LoadShedder(uint64_t _target, uint64_t _interval)
+  : m_target(_target), m_interval(_interval)
+{
+    for (auto& bits : m_sheddable)
+    {
+        bits.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LoadShedder::onDequeue(uint64_t _sojournTime, uint64_t _now)
+{
+    Guard l(x_state);
+    m_lastDequeueTime = _now;
+    if (_sojournTime < m_target)
+    {
+        m_firstAboveTime = 0;
+        if (m_overloaded.exchange(false, std::memory_order_relaxed))
+        {
+            FRONT_LOG(INFO) << LOG_BADGE("LoadShedder") << LOG_DESC("recovered from overload")
+                            << LOG_KV("sojournTime(us)", _sojournTime)
+                            << LOG_KV("shed", shed());
+        }
+        return;
+    }
+    if (m_firstAboveTime == 0)
+    {
+        m_firstAboveTime = _now + m_interval;
+        return;
+    }
+    if (_now >= m_firstAboveTime && !m_overloaded.exchange(true, std::memory_order_relaxed))
+    {
+        FRONT_LOG(WARNING) << LOG_BADGE("LoadShedder") << LOG_DESC("overloaded, start shedding")
+                           << LOG_KV("sojournTime(us)", _sojournTime)
+                           << LOG_KV("target(us)", m_target);
+    }
+}
+
+void LoadShedder::onIdle(uint64_t _now)
+{
+    Guard l(x_state);
+    if (_now < m_lastDequeueTime + m_interval)
+    {
+        return;
+    }
+    m_firstAboveTime = 0;
+    if (m_overloaded.exchange(false, std::memory_order_relaxed))
+    {
+        FRONT_LOG(INFO) << LOG_BADGE("LoadShedder") << LOG_DESC("recovered from overload, idle")
+                        << LOG_KV("shed", shed());
+    }
+}
+
+void LoadShedder::setSheddable(uint16_t _moduleID, bool _sheddable)
+{
+    auto bit = 1ULL << (_moduleID % 64);
+    if (_sheddable)
+    {
+        m_sheddable[_moduleID / 64].fetch_or(bit);
+    }
+    else
+    {
+        m_sheddable[_moduleID / 64].fetch_and(~bit);
+    }
+}
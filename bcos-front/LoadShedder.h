@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief CoDel style overload detection on the dispatch queue delay
+ * @file LoadShedder.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <array>
+
+namespace bcos
+{
+namespace front
+{
+/**
+ * the front is overloaded once the queue delay of the dispatched requests stays above the target
+ * for a whole interval, and recovers as soon as one request is dequeued below the target or the
+ * dispatch queue stays empty for an interval.
+ * while overloaded the inbound requests of the sheddable modules are rejected on receive, the
+ * modules not marked sheddable are critical and never shed
+ */
+class LoadShedder
+{
+public:
+    using Ptr = std::shared_ptr<LoadShedder>;
+
+    // 5ms target and 100ms interval as recommended by CoDel
+    constexpr static uint64_t DEFAULT_TARGET = 5000;
+    constexpr static uint64_t DEFAULT_INTERVAL = 100000;
+
+    /**
+     * @param _target: acceptable queue delay, in microseconds
+     * @param _interval: time the delay must stay above the target before shedding, in
+     * microseconds
+     */
+    LoadShedder(uint64_t _target = DEFAULT_TARGET, uint64_t _interval = DEFAULT_INTERVAL);
+    LoadShedder(const LoadShedder&) = delete;
+    LoadShedder& operator=(const LoadShedder&) = delete;
+
+    uint64_t target() const { return m_target; }
+    uint64_t interval() const { return m_interval; }
+
+    // called with the queue delay of each dequeued request, _now is the steady time in us
+    void onDequeue(uint64_t _sojournTime, uint64_t _now);
+    void onDequeue(uint64_t _sojournTime) { onDequeue(_sojournTime, utcSteadyTimeUs()); }
+    // called with the dispatch queue empty: with only the sheddable requests arriving nothing is
+    // dequeued any more, the overload ends one interval after the last dequeue
+    void onIdle(uint64_t _now);
+    void onIdle() { onIdle(utcSteadyTimeUs()); }
+
+    bool overloaded() const { return m_overloaded.load(std::memory_order_relaxed); }
+
+    void setSheddable(uint16_t _moduleID, bool _sheddable);
+    bool sheddable(uint16_t _moduleID) const
+    {
+        return m_sheddable[_moduleID / 64].load(std::memory_order_relaxed) &
+               (1ULL << (_moduleID % 64));
+    }
+
+    // check if a request of _moduleID should be rejected, counted as shed if true
+    bool shouldShed(uint16_t _moduleID)
+    {
+        if (!overloaded() || !sheddable(_moduleID))
+        {
+            return false;
+        }
+        m_shed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    // number of rejected requests
+    uint64_t shed() const { return m_shed.load(std::memory_order_relaxed); }
+
+private:
+    const uint64_t m_target;
+    const uint64_t m_interval;
+
+    mutable bcos::Mutex x_state;
+    // the time the delay has to stay above the target until, 0 if below the target
+    uint64_t m_firstAboveTime = 0;
+    uint64_t m_lastDequeueTime = 0;
+    std::atomic<bool> m_overloaded = {false};
+    std::atomic<uint64_t> m_shed = {0};
+
+    // one bit per moduleID
+    std::array<std::atomic<uint64_t>, 1024> m_sheddable;
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,196 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief accounting of the memory held by the front per module and direction
+ * @file MemoryAccountant.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/MemoryAccountant.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::front;
+
+MemoryAccountant::Page::Page()
+{
+    for (auto& module : modules)
+    {
+        module[0].store(0, std::memory_order_relaxed);
+        module[1].store(0, std::memory_order_relaxed);
+    }
+}
+
+MemoryAccountant::MemoryAccountant()
+{
+    for (auto& page : m_pages)
+    {
+        page.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+MemoryAccountant::~MemoryAccountant()
+{
+    for (auto& page : m_pages)
+    {
+        delete page.load(std::memory_order_relaxed);
+    }
+}
+
+std::atomic<size_t>& MemoryAccountant::moduleBytes(uint16_t _moduleID, MemoryDirection _direction)
+{
+    auto& slot = m_pages[_moduleID >> PAGE_BITS];
+    auto page = slot.load(std::memory_order_acquire);
+    if (!page)
+    {
+        // the racing allocations keep the first one published
+        auto allocated = new Page();
+        if (slot.compare_exchange_strong(page, allocated, std::memory_order_acq_rel))
+        {
+            page = allocated;
+        }
+        else
+        {
+            delete allocated;
+        }
+    }
+    return page->modules[_moduleID & (PAGE_SIZE - 1)][index(_direction)];
+}
+
+MemoryAccountant::Ticket::Ptr MemoryAccountant::Ticket::split(size_t _bytes)
+{
+    _bytes = std::min(_bytes, m_bytes);
+    m_bytes -= _bytes;
+    return std::make_shared<Ticket>(m_accountant, m_moduleID, m_direction, _bytes);
+}
+
+void MemoryAccountant::Ticket::resize(size_t _bytes)
+{
+    if (_bytes > m_bytes)
+    {
+        auto added = _bytes - m_bytes;
+        auto i = index(m_direction);
+        auto used = m_accountant->m_used[i].fetch_add(added, std::memory_order_relaxed) + added;
+        m_accountant->account(m_moduleID, m_direction, added, used);
+    }
+    else if (_bytes < m_bytes)
+    {
+        m_accountant->release(m_moduleID, m_direction, m_bytes - _bytes);
+    }
+    m_bytes = _bytes;
+}
+
+MemoryAccountant::Ticket::Ptr MemoryAccountant::charge(
+    uint16_t _moduleID, MemoryDirection _direction, size_t _bytes)
+{
+    auto i = index(_direction);
+    auto used = m_used[i].fetch_add(_bytes, std::memory_order_relaxed) + _bytes;
+    account(_moduleID, _direction, _bytes, used);
+    return std::make_shared<Ticket>(shared_from_this(), _moduleID, _direction, _bytes);
+}
+
+void MemoryAccountant::account(
+    uint16_t _moduleID, MemoryDirection _direction, size_t _bytes, size_t _used)
+{
+    auto i = index(_direction);
+    auto peak = m_peak[i].load(std::memory_order_relaxed);
+    while (_used > peak && !m_peak[i].compare_exchange_weak(peak, _used))
+    {
+    }
+    moduleBytes(_moduleID, _direction).fetch_add(_bytes, std::memory_order_relaxed);
+}
+
+void MemoryAccountant::release(uint16_t _moduleID, MemoryDirection _direction, size_t _bytes)
+{
+    m_used[index(_direction)].fetch_sub(_bytes, std::memory_order_relaxed);
+    // charged before, the page exists
+    moduleBytes(_moduleID, _direction).fetch_sub(_bytes, std::memory_order_relaxed);
+}
+
+void MemoryAccountant::setLimit(MemoryDirection _direction, const MemoryLimit& _limit)
+{
+    m_highWaterMarks[index(_direction)] = _limit.highWaterMark;
+    m_hardLimits[index(_direction)] = _limit.hardLimit;
+}
+
+MemoryLimit MemoryAccountant::limit(MemoryDirection _direction) const
+{
+    MemoryLimit limit;
+    limit.highWaterMark = m_highWaterMarks[index(_direction)];
+    limit.hardLimit = m_hardLimits[index(_direction)];
+    return limit;
+}
+
+MemoryAccountant::Ticket::Ptr MemoryAccountant::admit(
+    uint16_t _moduleID, MemoryDirection _direction, size_t _bytes, bool _sheddable)
+{
+    auto i = index(_direction);
+    auto hardLimit = m_hardLimits[i].load(std::memory_order_relaxed);
+    auto highWaterMark = m_highWaterMarks[i].load(std::memory_order_relaxed);
+    auto limit = _sheddable && highWaterMark > 0 ? highWaterMark : hardLimit;
+    if (_sheddable && hardLimit > 0 && highWaterMark > 0)
+    {
+        limit = std::min(hardLimit, highWaterMark);
+    }
+    auto used = m_used[i].load(std::memory_order_relaxed);
+    do
+    {
+        if (limit > 0 && used + _bytes > limit)
+        {
+            m_rejected[i].fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    } while (!m_used[i].compare_exchange_weak(used, used + _bytes, std::memory_order_relaxed));
+    account(_moduleID, _direction, _bytes, used + _bytes);
+    return std::make_shared<Ticket>(shared_from_this(), _moduleID, _direction, _bytes);
+}
+
+size_t MemoryAccountant::used(uint16_t _moduleID, MemoryDirection _direction) const
+{
+    auto page = m_pages[_moduleID >> PAGE_BITS].load(std::memory_order_acquire);
+    if (!page)
+    {
+        return 0;
+    }
+    return page->modules[_moduleID & (PAGE_SIZE - 1)][index(_direction)].load(
+        std::memory_order_relaxed);
+}
+
+std::vector<ModuleMemory> MemoryAccountant::snapshot() const
+{
+    // the pages in moduleID order, each module read on its own
+    std::vector<ModuleMemory> modules;
+    for (size_t i = 0; i < PAGE_COUNT; ++i)
+    {
+        auto page = m_pages[i].load(std::memory_order_acquire);
+        if (!page)
+        {
+            continue;
+        }
+        for (size_t j = 0; j < PAGE_SIZE; ++j)
+        {
+            ModuleMemory memory;
+            memory.moduleID = (uint16_t)((i << PAGE_BITS) | j);
+            memory.inbound = page->modules[j][0].load(std::memory_order_relaxed);
+            memory.outbound = page->modules[j][1].load(std::memory_order_relaxed);
+            if (memory.inbound != 0 || memory.outbound != 0)
+            {
+                modules.emplace_back(memory);
+            }
+        }
+    }
+    return modules;
+}
@@ -0,0 +1,164 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief accounting of the memory held by the front per module and direction
+ * @file MemoryAccountant.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <array>
+#include <atomic>
+
+namespace bcos
+{
+namespace front
+{
+enum class MemoryDirection : uint8_t
+{
+    // payload copies of the received requests and responses waiting for a thread
+    Inbound = 0,
+    // pending requests and the frames waiting to be sent
+    Outbound = 1,
+};
+
+struct MemoryLimit
+{
+    // above it the messages of the sheddable modules are rejected, 0 for no limit
+    size_t highWaterMark = 0;
+    // above it the messages of every module are rejected, 0 for no limit
+    size_t hardLimit = 0;
+};
+
+struct ModuleMemory
+{
+    uint16_t moduleID = 0;
+    size_t inbound = 0;
+    size_t outbound = 0;
+};
+
+/**
+ * the bytes the front holds are charged with a Ticket, released when the ticket is destroyed.
+ * the tickets travel with the buffers they account, in the captures of the tasks, so that the
+ * accounting follows the lifetime of the buffers without explicit release calls.
+ * the per module bytes are atomic counters in pages of 256 modules allocated on the first
+ * charge, nothing on the charge and release path takes a lock
+ */
+class MemoryAccountant : public std::enable_shared_from_this<MemoryAccountant>
+{
+public:
+    using Ptr = std::shared_ptr<MemoryAccountant>;
+
+    class Ticket
+    {
+    public:
+        using Ptr = std::shared_ptr<Ticket>;
+        Ticket(std::shared_ptr<MemoryAccountant> _accountant, uint16_t _moduleID,
+            MemoryDirection _direction, size_t _bytes)
+          : m_accountant(std::move(_accountant)),
+            m_moduleID(_moduleID),
+            m_direction(_direction),
+            m_bytes(_bytes)
+        {}
+        ~Ticket() { m_accountant->release(m_moduleID, m_direction, m_bytes); }
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+
+        size_t bytes() const { return m_bytes; }
+
+        /// not thread safe, called by the owner of the ticket before sharing it
+        // move _bytes of this ticket to a new one, e.g. a part of a reservation held longer
+        Ptr split(size_t _bytes);
+        // charge or release the difference, e.g. once the size held is known
+        void resize(size_t _bytes);
+
+    private:
+        std::shared_ptr<MemoryAccountant> m_accountant;
+        uint16_t m_moduleID;
+        MemoryDirection m_direction;
+        size_t m_bytes;
+    };
+
+    const static size_t PAGE_BITS = 8;
+    const static size_t PAGE_SIZE = 1 << PAGE_BITS;
+    const static size_t PAGE_COUNT = (1 << 16) / PAGE_SIZE;
+
+    MemoryAccountant();
+    ~MemoryAccountant();
+    MemoryAccountant(const MemoryAccountant&) = delete;
+    MemoryAccountant& operator=(const MemoryAccountant&) = delete;
+
+    // charge _bytes held until the returned ticket is destroyed
+    Ticket::Ptr charge(uint16_t _moduleID, MemoryDirection _direction, size_t _bytes);
+
+    void setLimit(MemoryDirection _direction, const MemoryLimit& _limit);
+    MemoryLimit limit(MemoryDirection _direction) const;
+
+    /**
+     * @brief: reserve _bytes of _direction if they stay within the limits, the check and the
+     * charge are one atomic step so that the concurrent admits can't overshoot the limits
+     * @param _sheddable: the module gives way at the high-water mark, the others at the hard
+     * limit only
+     * @return the ticket of the reservation, nullptr and counted as rejected if over the limits
+     */
+    Ticket::Ptr admit(
+        uint16_t _moduleID, MemoryDirection _direction, size_t _bytes, bool _sheddable);
+
+    size_t used(MemoryDirection _direction) const
+    {
+        return m_used[index(_direction)].load(std::memory_order_relaxed);
+    }
+    size_t used(uint16_t _moduleID, MemoryDirection _direction) const;
+    // the highest usage of _direction since created
+    size_t peak(MemoryDirection _direction) const
+    {
+        return m_peak[index(_direction)].load(std::memory_order_relaxed);
+    }
+    uint64_t rejected(MemoryDirection _direction) const
+    {
+        return m_rejected[index(_direction)].load(std::memory_order_relaxed);
+    }
+    // the modules holding memory, sorted by moduleID
+    std::vector<ModuleMemory> snapshot() const;
+
+private:
+    static size_t index(MemoryDirection _direction) { return (size_t)_direction; }
+    // the bookkeeping of _bytes added to m_used, _used is the usage after
+    void account(uint16_t _moduleID, MemoryDirection _direction, size_t _bytes, size_t _used);
+    void release(uint16_t _moduleID, MemoryDirection _direction, size_t _bytes);
+
+    struct Page
+    {
+        Page();
+        // the inbound and outbound bytes of the modules of the page
+        std::array<std::array<std::atomic<size_t>, 2>, PAGE_SIZE> modules;
+    };
+    // the counter of _moduleID, the page is allocated if missing
+    std::atomic<size_t>& moduleBytes(uint16_t _moduleID, MemoryDirection _direction);
+
+    std::array<std::atomic<size_t>, 2> m_used = {{{0}, {0}}};
+    std::array<std::atomic<size_t>, 2> m_peak = {{{0}, {0}}};
+    std::array<std::atomic<uint64_t>, 2> m_rejected = {{{0}, {0}}};
+    std::array<std::atomic<size_t>, 2> m_highWaterMarks = {{{0}, {0}}};
+    std::array<std::atomic<size_t>, 2> m_hardLimits = {{{0}, {0}}};
+
+    // published once, freed with the accountant
+    std::array<std::atomic<Page*>, PAGE_COUNT> m_pages;
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,186 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief flat dispatch table indexed by the 16-bit moduleID
+ * @file ModuleDispatcherTable.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-front/EpochReclaimer.h>
+
+namespace bcos
+{
+namespace front
+{
+/**
+ * the moduleID space(2 bytes on the wire) is split into 256 lazily allocated pages of 256 slots,
+ * each slot holds an atomic pointer to the published handler.
+ * lookup takes no lock, the replaced handlers are reclaimed by epoch, see EpochReclaimer.
+ * writers are serialized by a mutex.
+ */
+template <typename T>
+class ModuleDispatcherTable
+{
+public:
+    using ValuePtr = std::shared_ptr<const T>;
+
+    const static size_t PAGE_BITS = 8;
+    const static size_t PAGE_SIZE = 1 << PAGE_BITS;
+    const static size_t PAGE_COUNT = (1 << 16) / PAGE_SIZE;
+
+    ModuleDispatcherTable()
+    {
+        for (auto& page : m_pages)
+        {
+            page.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    ModuleDispatcherTable(const ModuleDispatcherTable&) = delete;
+    ModuleDispatcherTable& operator=(const ModuleDispatcherTable&) = delete;
+
+    ~ModuleDispatcherTable()
+    {
+        for (auto& page : m_pages)
+        {
+            auto pagePtr = page.load(std::memory_order_relaxed);
+            if (!pagePtr)
+            {
+                continue;
+            }
+            for (auto& slot : pagePtr->slots)
+            {
+                delete slot.load(std::memory_order_relaxed);
+            }
+            delete pagePtr;
+        }
+    }
+
+    // the handler of _moduleID, nullptr if not registered
+    ValuePtr get(uint16_t _moduleID) const
+    {
+        auto page = m_pages[_moduleID >> PAGE_BITS].load(std::memory_order_acquire);
+        if (!page)
+        {
+            return nullptr;
+        }
+        return m_reclaimer.read(page->slots[_moduleID & (PAGE_SIZE - 1)]);
+    }
+
+    // publish _value for _moduleID, replace the old one if exists
+    void set(uint16_t _moduleID, ValuePtr _value)
+    {
+        Guard l(x_writer);
+        auto& slot = allocatePage(_moduleID >> PAGE_BITS)->slots[_moduleID & (PAGE_SIZE - 1)];
+        auto value = _value ? new ValuePtr(std::move(_value)) : nullptr;
+        retire(slot.exchange(value, std::memory_order_seq_cst), value != nullptr);
+    }
+
+    // remove the handler of _moduleID, return false if not registered
+    bool remove(uint16_t _moduleID)
+    {
+        Guard l(x_writer);
+        auto page = m_pages[_moduleID >> PAGE_BITS].load(std::memory_order_acquire);
+        if (!page)
+        {
+            return false;
+        }
+        auto& slot = page->slots[_moduleID & (PAGE_SIZE - 1)];
+        return retire(slot.exchange(nullptr, std::memory_order_seq_cst), false);
+    }
+
+    size_t size() const { return m_size.load(std::memory_order_relaxed); }
+    // the replaced handlers not freed yet
+    size_t retired() const
+    {
+        Guard l(x_writer);
+        return m_reclaimer.retired();
+    }
+
+    // visit all the registered handlers under the writer lock, _f must not write the table
+    template <typename F>
+    void forEach(F _f) const
+    {
+        Guard l(x_writer);
+        for (size_t i = 0; i < PAGE_COUNT; ++i)
+        {
+            auto page = m_pages[i].load(std::memory_order_acquire);
+            if (!page)
+            {
+                continue;
+            }
+            for (size_t j = 0; j < PAGE_SIZE; ++j)
+            {
+                auto value = page->slots[j].load(std::memory_order_acquire);
+                if (value)
+                {
+                    _f((uint16_t)((i << PAGE_BITS) | j), *value);
+                }
+            }
+        }
+    }
+
+private:
+    struct Page
+    {
+        Page()
+        {
+            for (auto& slot : slots)
+            {
+                slot.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        std::array<std::atomic<const ValuePtr*>, PAGE_SIZE> slots;
+    };
+
+    // must be called with x_writer held
+    Page* allocatePage(size_t _index)
+    {
+        auto page = m_pages[_index].load(std::memory_order_acquire);
+        if (!page)
+        {
+            page = new Page();
+            m_pages[_index].store(page, std::memory_order_release);
+        }
+        return page;
+    }
+
+    // must be called with x_writer held
+    bool retire(const ValuePtr* _old, bool _inserted)
+    {
+        m_reclaimer.retire(_old);
+        if (_inserted && !_old)
+        {
+            m_size.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (!_inserted && _old)
+        {
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return _old != nullptr;
+    }
+
+    std::array<std::atomic<Page*>, PAGE_COUNT> m_pages;
+    std::atomic<size_t> m_size = {0};
+
+    // serialize the writers
+    mutable bcos::Mutex x_writer;
+    // frees the replaced handlers once the receive path can't read them
+    EpochReclaimer<T> m_reclaimer;
+};
+}  // namespace front
+}  // namespace bcos
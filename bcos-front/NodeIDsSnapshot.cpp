@@ -0,0 +1,125 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief immutable, versioned view of the nodeIDs pushed by the gateway
+ * @file NodeIDsSnapshot.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/NodeIDsSnapshot.h>
+#include <random>
+#include <string_view>
+
+using namespace bcos;
+using namespace bcos::front;
+
+size_t NodeIDHasher::operator()(const bcos::crypto::NodeIDPtr& _nodeID) const
+{
+    auto const& data = _nodeID->data();
+    return std::hash<std::string_view>()(
+        std::string_view((const char*)data.data(), data.size()));
+}
+
+NodeIDsSnapshot::NodeIDsSnapshot(
+    uint64_t _version, std::shared_ptr<const bcos::crypto::NodeIDs> _nodeIDs)
+  : m_version(_version), m_nodeIDs(_nodeIDs)
+{
+    if (!m_nodeIDs)
+    {
+        m_nodeIDs = std::make_shared<const bcos::crypto::NodeIDs>();
+    }
+    m_index.reserve(m_nodeIDs->size());
+    m_distinct.reserve(m_nodeIDs->size());
+    for (uint32_t i = 0; i < m_nodeIDs->size(); ++i)
+    {
+        auto const& nodeID = (*m_nodeIDs)[i];
+        // keep the first occurrence
+        if (nodeID && m_index.emplace(nodeID, i).second)
+        {
+            m_distinct.push_back(i);
+        }
+    }
+}
+
+int64_t NodeIDsSnapshot::indexOf(const bcos::crypto::NodeIDPtr& _nodeID) const
+{
+    if (!_nodeID)
+    {
+        return -1;
+    }
+    auto it = m_index.find(_nodeID);
+    if (it == m_index.end())
+    {
+        return -1;
+    }
+    return it->second;
+}
+
+size_t NodeIDsSnapshot::sample(size_t _count, const bcos::crypto::NodeIDPtr& _exclude,
+    bcos::crypto::NodeIDs& _sampled) const
+{
+    thread_local std::mt19937_64 random(std::random_device{}());
+    auto excluded = indexOf(_exclude);
+    size_t remaining = m_distinct.size() - (excluded >= 0 ? 1 : 0);
+    size_t needed = std::min(_count, remaining);
+    auto sampled = needed;
+    for (auto index : m_distinct)
+    {
+        if (needed == 0)
+        {
+            break;
+        }
+        if (index == excluded)
+        {
+            continue;
+        }
+        // select with probability needed / remaining, the multiply-shift maps the random
+        // 64 bits to [0, remaining) without a division, its bias is below remaining / 2^64
+        auto draw = (uint64_t)(((unsigned __int128)random() * remaining) >> 64);
+        if (draw < needed)
+        {
+            _sampled.push_back((*m_nodeIDs)[index]);
+            needed--;
+        }
+        remaining--;
+    }
+    return sampled;
+}
+
+NodeIDsDelta::Ptr NodeIDsSnapshot::diff(const NodeIDsSnapshot& _previous) const
+{
+    auto delta = std::make_shared<NodeIDsDelta>();
+    delta->version = m_version;
+    // walk the node lists instead of the indexes to keep the delta in the gateway order
+    for (uint32_t i = 0; i < m_nodeIDs->size(); ++i)
+    {
+        auto const& nodeID = (*m_nodeIDs)[i];
+        if (nodeID && indexOf(nodeID) == i && !_previous.contains(nodeID))
+        {
+            delta->added.push_back(nodeID);
+        }
+    }
+    auto const& previousNodeIDs = *(_previous.m_nodeIDs);
+    for (uint32_t i = 0; i < previousNodeIDs.size(); ++i)
+    {
+        auto const& nodeID = previousNodeIDs[i];
+        if (nodeID && _previous.indexOf(nodeID) == i && !contains(nodeID))
+        {
+            delta->removed.push_back(nodeID);
+        }
+    }
+    return delta;
+}
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief immutable, versioned view of the nodeIDs pushed by the gateway
+ * @file NodeIDsSnapshot.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/crypto/KeyInterface.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace front
+{
+// hash the nodeID by the raw key data instead of the pointer
+struct NodeIDHasher
+{
+    size_t operator()(const bcos::crypto::NodeIDPtr& _nodeID) const;
+};
+
+struct NodeIDEqual
+{
+    bool operator()(const bcos::crypto::NodeIDPtr& _lhs, const bcos::crypto::NodeIDPtr& _rhs) const
+    {
+        return _lhs->data() == _rhs->data();
+    }
+};
+
+/// the nodes added and removed between two snapshots
+struct NodeIDsDelta
+{
+    using Ptr = std::shared_ptr<const NodeIDsDelta>;
+
+    // version of the snapshot the delta leads to
+    uint64_t version = 0;
+    bcos::crypto::NodeIDs added;
+    bcos::crypto::NodeIDs removed;
+
+    bool empty() const { return added.empty() && removed.empty(); }
+};
+
+class NodeIDsSnapshot
+{
+public:
+    using Ptr = std::shared_ptr<const NodeIDsSnapshot>;
+
+    NodeIDsSnapshot() : NodeIDsSnapshot(0, nullptr) {}
+    NodeIDsSnapshot(uint64_t _version, std::shared_ptr<const bcos::crypto::NodeIDs> _nodeIDs);
+
+    uint64_t version() const { return m_version; }
+    // the node list as pushed by the gateway, may contain duplicated nodes
+    std::shared_ptr<const bcos::crypto::NodeIDs> nodeIDs() const { return m_nodeIDs; }
+    // count of distinct nodes
+    size_t size() const { return m_index.size(); }
+
+    bool contains(const bcos::crypto::NodeIDPtr& _nodeID) const
+    {
+        return _nodeID && m_index.count(_nodeID);
+    }
+
+    // index of the first occurrence of _nodeID in nodeIDs(), -1 if not exists
+    int64_t indexOf(const bcos::crypto::NodeIDPtr& _nodeID) const;
+
+    /**
+     * @brief: append _count distinct nodes other than _exclude to _sampled, uniformly at random,
+     * all of them if there are fewer. The nodes are selected in one pass over the distinct nodes
+     * without allocating beyond _sampled (Knuth's Algorithm S)
+     * @return the number of nodes sampled
+     */
+    size_t sample(size_t _count, const bcos::crypto::NodeIDPtr& _exclude,
+        bcos::crypto::NodeIDs& _sampled) const;
+
+    // compute the nodes added and removed since _previous
+    NodeIDsDelta::Ptr diff(const NodeIDsSnapshot& _previous) const;
+
+private:
+    uint64_t m_version;
+    std::shared_ptr<const bcos::crypto::NodeIDs> m_nodeIDs;
+    // indexes of the first occurrences in m_nodeIDs, in the gateway order
+    std::vector<uint32_t> m_distinct;
+    std::unordered_map<bcos::crypto::NodeIDPtr, uint32_t, NodeIDHasher, NodeIDEqual> m_index;
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief per destination circuit breaker of the requests
+ * @file PeerCircuitBreaker.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/Common.h>
+#include <bcos-front/PeerCircuitBreaker.h>
+
+using namespace bcos;
+using namespace bcos::front;
+
+PeerCircuitBreaker::PeerCircuitBreaker(uint32_t _failureThreshold, uint64_t _probeInterval)
+  : m_failureThreshold(std::max<uint32_t>(_failureThreshold, 1)), m_probeInterval(_probeInterval)
+{
+    for (auto& transitions : m_transitions)
+    {
+        transitions.store(0, std::memory_order_relaxed);
+    }
+}
+
+BreakerState PeerCircuitBreaker::transit(Entry& _entry, BreakerState _state, uint64_t _now)
+{
+    auto from = _entry.state;
+    _entry.state = _state;
+    _entry.since = _now;
+    _entry.probing = false;
+    if (_state == BreakerState::Open)
+    {
+        _entry.rejected = 0;
+    }
+    m_transitions[(size_t)_state].fetch_add(1, std::memory_order_relaxed);
+    return from;
+}
+
+void PeerCircuitBreaker::notify(
+    const bcos::crypto::NodeIDPtr& _nodeID, BreakerState _from, BreakerState _to)
+{
+    FRONT_LOG(INFO) << LOG_BADGE("PeerCircuitBreaker") << LOG_DESC("state changed")
+                    << LOG_KV("nodeID", _nodeID->hex()) << LOG_KV("from", (int)_from)
+                    << LOG_KV("to", (int)_to);
+    if (m_stateChangeHandler)
+    {
+        m_stateChangeHandler(_nodeID, _from, _to);
+    }
+}
+
+bool PeerCircuitBreaker::allowRequest(const bcos::crypto::NodeIDPtr& _nodeID, uint64_t _now)
+{
+    bool changed = false;
+    {
+        Guard l(x_entries);
+        auto it = m_entries.find(_nodeID);
+        if (it == m_entries.end() || it->second.state == BreakerState::Closed)
+        {
+            return true;
+        }
+        auto& entry = it->second;
+        if (entry.state == BreakerState::Open && _now >= entry.since + m_probeInterval)
+        {
+            transit(entry, BreakerState::HalfOpen, _now);
+            changed = true;
+        }
+        // one probe at a time, a probe without outcome is replaced after the probe interval
+        if (entry.state == BreakerState::HalfOpen &&
+            (!entry.probing || _now >= entry.since + m_probeInterval))
+        {
+            entry.probing = true;
+            entry.since = _now;
+        }
+        else
+        {
+            entry.rejected++;
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    if (changed)
+    {
+        notify(_nodeID, BreakerState::Open, BreakerState::HalfOpen);
+    }
+    return true;
+}
+
+void PeerCircuitBreaker::onSuccess(const bcos::crypto::NodeIDPtr& _nodeID)
+{
+    BreakerState from;
+    {
+        Guard l(x_entries);
+        auto it = m_entries.find(_nodeID);
+        if (it == m_entries.end())
+        {
+            return;
+        }
+        if (it->second.state == BreakerState::Closed)
+        {
+            // healthy peers are not tracked
+            m_entries.erase(it);
+            return;
+        }
+        from = transit(it->second, BreakerState::Closed, utcSteadyTime());
+        m_entries.erase(it);
+    }
+    notify(_nodeID, from, BreakerState::Closed);
+}
+
+void PeerCircuitBreaker::onFailure(const bcos::crypto::NodeIDPtr& _nodeID, uint64_t _now)
+{
+    BreakerState from;
+    {
+        Guard l(x_entries);
+        auto& entry = m_entries[_nodeID];
+        entry.consecutiveFailures++;
+        if (entry.state == BreakerState::Open ||
+            (entry.state == BreakerState::Closed &&
+                entry.consecutiveFailures < m_failureThreshold))
+        {
+            return;
+        }
+        // the threshold reached or the probe failed
+        from = transit(entry, BreakerState::Open, _now);
+    }
+    notify(_nodeID, from, BreakerState::Open);
+}
+
+BreakerState PeerCircuitBreaker::state(const bcos::crypto::NodeIDPtr& _nodeID) const
+{
+    Guard l(x_entries);
+    auto it = m_entries.find(_nodeID);
+    return it == m_entries.end() ? BreakerState::Closed : it->second.state;
+}
+
+std::vector<PeerBreakerStatus> PeerCircuitBreaker::snapshot() const
+{
+    std::vector<PeerBreakerStatus> status;
+    Guard l(x_entries);
+    status.reserve(m_entries.size());
+    for (auto const& it : m_entries)
+    {
+        PeerBreakerStatus peer;
+        peer.nodeID = it.first;
+        peer.state = it.second.state;
+        peer.consecutiveFailures = it.second.consecutiveFailures;
+        peer.rejected = it.second.rejected;
+        status.push_back(peer);
+    }
+    return status;
+}
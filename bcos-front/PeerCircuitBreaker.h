@@ -0,0 +1,130 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief per destination circuit breaker of the requests
+ * @file PeerCircuitBreaker.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/NodeIDsSnapshot.h>
+#include <array>
+
+namespace bcos
+{
+namespace front
+{
+enum class BreakerState : uint8_t
+{
+    // requests pass
+    Closed = 0,
+    // requests fail fast until the probe interval elapses
+    Open = 1,
+    // one probe request passes, its outcome closes or reopens the breaker
+    HalfOpen = 2,
+};
+
+struct PeerBreakerStatus
+{
+    bcos::crypto::NodeIDPtr nodeID;
+    BreakerState state = BreakerState::Closed;
+    uint32_t consecutiveFailures = 0;
+    // number of requests failed fast since the breaker opened
+    uint64_t rejected = 0;
+};
+
+/**
+ * consecutive timeouts or errors of a peer open its breaker, after the probe interval one request
+ * is let through to probe the peer, its success closes the breaker and its failure opens it again
+ */
+class PeerCircuitBreaker
+{
+public:
+    using Ptr = std::shared_ptr<PeerCircuitBreaker>;
+    using StateChangeHandler = std::function<void(
+        const bcos::crypto::NodeIDPtr& _nodeID, BreakerState _from, BreakerState _to)>;
+
+    constexpr static uint32_t DEFAULT_FAILURE_THRESHOLD = 5;
+    constexpr static uint64_t DEFAULT_PROBE_INTERVAL = 5000;
+
+    /**
+     * @param _failureThreshold: consecutive failures opening the breaker
+     * @param _probeInterval: time in milliseconds the breaker stays open before probing, also
+     * the time a probe can take before another one is allowed
+     */
+    PeerCircuitBreaker(uint32_t _failureThreshold = DEFAULT_FAILURE_THRESHOLD,
+        uint64_t _probeInterval = DEFAULT_PROBE_INTERVAL);
+    PeerCircuitBreaker(const PeerCircuitBreaker&) = delete;
+    PeerCircuitBreaker& operator=(const PeerCircuitBreaker&) = delete;
+
+    uint32_t failureThreshold() const { return m_failureThreshold; }
+    uint64_t probeInterval() const { return m_probeInterval; }
+
+    // check if a request to _nodeID can be sent, _now is the steady time in milliseconds
+    bool allowRequest(const bcos::crypto::NodeIDPtr& _nodeID, uint64_t _now);
+    bool allowRequest(const bcos::crypto::NodeIDPtr& _nodeID)
+    {
+        return allowRequest(_nodeID, utcSteadyTime());
+    }
+
+    void onSuccess(const bcos::crypto::NodeIDPtr& _nodeID);
+    void onFailure(const bcos::crypto::NodeIDPtr& _nodeID, uint64_t _now);
+    void onFailure(const bcos::crypto::NodeIDPtr& _nodeID)
+    {
+        onFailure(_nodeID, utcSteadyTime());
+    }
+
+    BreakerState state(const bcos::crypto::NodeIDPtr& _nodeID) const;
+    // the peers whose breaker is not in the initial closed state without failures
+    std::vector<PeerBreakerStatus> snapshot() const;
+    // number of transitions into _state since creation
+    uint64_t transitions(BreakerState _state) const
+    {
+        return m_transitions[(size_t)_state].load(std::memory_order_relaxed);
+    }
+    // number of requests failed fast
+    uint64_t rejected() const { return m_rejected.load(std::memory_order_relaxed); }
+
+    // called outside the lock on every state change
+    void setStateChangeHandler(StateChangeHandler _handler) { m_stateChangeHandler = _handler; }
+
+private:
+    struct Entry
+    {
+        BreakerState state = BreakerState::Closed;
+        uint32_t consecutiveFailures = 0;
+        // the time the breaker opened or the probe was sent
+        uint64_t since = 0;
+        bool probing = false;
+        uint64_t rejected = 0;
+    };
+    // called with x_entries held, return the previous state
+    BreakerState transit(Entry& _entry, BreakerState _state, uint64_t _now);
+    void notify(const bcos::crypto::NodeIDPtr& _nodeID, BreakerState _from, BreakerState _to);
+
+    const uint32_t m_failureThreshold;
+    const uint64_t m_probeInterval;
+    StateChangeHandler m_stateChangeHandler;
+
+    mutable bcos::Mutex x_entries;
+    std::unordered_map<bcos::crypto::NodeIDPtr, Entry, NodeIDHasher, NodeIDEqual> m_entries;
+    std::array<std::atomic<uint64_t>, 3> m_transitions;
+    std::atomic<uint64_t> m_rejected = {0};
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief token bucket shaping of the outbound messages per module and destination
+ * @file RateLimiter.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/RateLimiter.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace bcos;
+using namespace bcos::front;
+
+TokenBucket::TokenBucket(double _rate, double _burst, uint64_t _now)
+  : m_rate(_rate), m_burst(std::max(_burst, 1.0)), m_tokens(m_burst), m_lastRefill(_now)
+{}
+
+void TokenBucket::refill(uint64_t _now)
+{
+    if (_now <= m_lastRefill)
+    {
+        return;
+    }
+    m_tokens = std::min(m_burst, m_tokens + m_rate * (_now - m_lastRefill) / 1e6);
+    m_lastRefill = _now;
+}
+
+double TokenBucket::tokens(uint64_t _now)
+{
+    refill(_now);
+    return m_tokens;
+}
+
+uint64_t TokenBucket::waitTime(double _tokens, uint64_t _now)
+{
+    refill(_now);
+    // a message larger than the burst goes once the bucket is full instead of never
+    auto needed = std::min(_tokens, m_burst);
+    if (m_tokens >= needed)
+    {
+        return 0;
+    }
+    return (uint64_t)std::ceil((needed - m_tokens) * 1e6 / m_rate);
+}
+
+void TokenBucket::consume(double _tokens, uint64_t _now)
+{
+    refill(_now);
+    m_tokens -= _tokens;
+}
+
+void OutboundRateLimiter::initBuckets(Buckets& _buckets, const RateLimit& _limit, uint64_t _now)
+{
+    if (_limit.messagesPerSecond > 0)
+    {
+        _buckets.messages = std::make_unique<TokenBucket>(
+            _limit.messagesPerSecond, _limit.messagesPerSecond * _limit.burstSeconds, _now);
+    }
+    if (_limit.bytesPerSecond > 0)
+    {
+        _buckets.bytes = std::make_unique<TokenBucket>(
+            _limit.bytesPerSecond, _limit.bytesPerSecond * _limit.burstSeconds, _now);
+    }
+    _buckets.initialized = true;
+}
+
+void OutboundRateLimiter::setLimit(uint16_t _moduleID, const RateLimit& _limit, uint64_t _now)
+{
+    Guard l(x_modules);
+    auto& state = m_states[_moduleID];
+    auto previous = std::move(state);
+    state = ModuleState();
+    state.limit = _limit;
+    // the counters survive the change of the limit
+    state.messages = previous.messages;
+    state.bytes = previous.bytes;
+    state.delayed = previous.delayed;
+    state.rejected = previous.rejected;
+    state.exportTime = previous.exportTime ? previous.exportTime : _now;
+    state.exportMessages = previous.exportMessages;
+    state.exportBytes = previous.exportBytes;
+    m_modules = m_states.size();
+}
+
+void OutboundRateLimiter::removeLimit(uint16_t _moduleID)
+{
+    Guard l(x_modules);
+    m_states.erase(_moduleID);
+    m_modules = m_states.size();
+}
+
+bool OutboundRateLimiter::limited(uint16_t _moduleID) const
+{
+    Guard l(x_modules);
+    return m_states.count(_moduleID);
+}
+
+OutboundRateLimiter::Admission OutboundRateLimiter::admit(
+    uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID, size_t _bytes, uint64_t _now)
+{
+    Admission admission;
+    Guard l(x_modules);
+    auto it = m_states.find(_moduleID);
+    if (it == m_states.end())
+    {
+        return admission;
+    }
+    auto& state = it->second;
+    auto* buckets = &state.module;
+    if (state.limit.perDestination)
+    {
+        buckets = _nodeID ? &state.destinations[_nodeID] : &state.broadcast;
+    }
+    if (!buckets->initialized)
+    {
+        initBuckets(*buckets, state.limit, _now);
+    }
+
+    uint64_t wait = 0;
+    if (buckets->messages)
+    {
+        wait = buckets->messages->waitTime(1, _now);
+    }
+    if (buckets->bytes)
+    {
+        wait = std::max(wait, buckets->bytes->waitTime(_bytes, _now));
+    }
+    if (wait > 0 && (state.limit.overflow == RateLimit::Overflow::Reject ||
+                        wait > state.limit.maxDelay * 1000))
+    {
+        state.rejected++;
+        admission.admitted = false;
+        return admission;
+    }
+    if (buckets->messages)
+    {
+        buckets->messages->consume(1, _now);
+    }
+    if (buckets->bytes)
+    {
+        buckets->bytes->consume(_bytes, _now);
+    }
+    state.messages++;
+    state.bytes += _bytes;
+    if (wait > 0)
+    {
+        state.delayed++;
+        admission.delay = wait;
+    }
+    return admission;
+}
+
+std::vector<ModuleRate> OutboundRateLimiter::rates(uint64_t _now)
+{
+    std::vector<ModuleRate> rates;
+    Guard l(x_modules);
+    rates.reserve(m_states.size());
+    for (auto& entry : m_states)
+    {
+        auto& state = entry.second;
+        ModuleRate rate;
+        rate.moduleID = entry.first;
+        rate.delayed = state.delayed;
+        rate.rejected = state.rejected;
+        if (_now > state.exportTime)
+        {
+            auto seconds = (_now - state.exportTime) / 1e6;
+            rate.messagesPerSecond = (state.messages - state.exportMessages) / seconds;
+            rate.bytesPerSecond = (state.bytes - state.exportBytes) / seconds;
+        }
+        state.exportTime = _now;
+        state.exportMessages = state.messages;
+        state.exportBytes = state.bytes;
+        rates.emplace_back(rate);
+    }
+    std::sort(rates.begin(), rates.end(), [](const ModuleRate& _lhs, const ModuleRate& _rhs) {
+        return _lhs.moduleID < _rhs.moduleID;
+    });
+    return rates;
+}
@@ -0,0 +1,170 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief token bucket shaping of the outbound messages per module and destination
+ * @file RateLimiter.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/NodeIDsSnapshot.h>
+
+namespace bcos
+{
+namespace front
+{
+/**
+ * token bucket refilled at rate tokens per second up to burst tokens. A consumption may take the
+ * bucket below zero, the consumer then waits until the debt is refilled, so the delayed messages
+ * keep their order without a queue of their own
+ */
+class TokenBucket
+{
+public:
+    // _now is the steady time in microseconds, the bucket starts full
+    TokenBucket(double _rate, double _burst, uint64_t _now);
+
+    double rate() const { return m_rate; }
+    double burst() const { return m_burst; }
+    double tokens(uint64_t _now);
+
+    // microseconds until _tokens are available, 0 if they are
+    uint64_t waitTime(double _tokens, uint64_t _now);
+    // take _tokens, going into debt if they are not available
+    void consume(double _tokens, uint64_t _now);
+
+private:
+    void refill(uint64_t _now);
+
+    double m_rate;
+    double m_burst;
+    double m_tokens;
+    uint64_t m_lastRefill;
+};
+
+struct RateLimit
+{
+    enum class Overflow : uint8_t
+    {
+        // the messages over the budget are rejected
+        Reject = 0,
+        // the messages over the budget are sent once the budget allows, up to maxDelay
+        Delay = 1,
+    };
+
+    // 0 for no limit
+    double messagesPerSecond = 0;
+    double bytesPerSecond = 0;
+    // the budget that can be spent at once, in seconds of the rates
+    double burstSeconds = 1;
+    // apply the rates to each destination instead of the whole module
+    bool perDestination = false;
+    Overflow overflow = Overflow::Reject;
+    // the messages that would wait longer are rejected, in milliseconds
+    uint64_t maxDelay = 1000;
+};
+
+struct ModuleRate
+{
+    uint16_t moduleID = 0;
+    // rates of the messages admitted since the previous export
+    double messagesPerSecond = 0;
+    double bytesPerSecond = 0;
+    uint64_t delayed = 0;
+    uint64_t rejected = 0;
+};
+
+class OutboundRateLimiter
+{
+public:
+    using Ptr = std::shared_ptr<OutboundRateLimiter>;
+
+    struct Admission
+    {
+        bool admitted = true;
+        // microseconds the message must wait before being sent
+        uint64_t delay = 0;
+    };
+
+    OutboundRateLimiter() = default;
+    OutboundRateLimiter(const OutboundRateLimiter&) = delete;
+    OutboundRateLimiter& operator=(const OutboundRateLimiter&) = delete;
+
+    /**
+     * @brief: take effect for the next messages, the buckets of the module restart full at the
+     * next admit so they take the time of the admits whatever clock the caller has
+     * @param _now: the steady time in microseconds, the rates are exported from
+     */
+    void setLimit(uint16_t _moduleID, const RateLimit& _limit, uint64_t _now);
+    void setLimit(uint16_t _moduleID, const RateLimit& _limit)
+    {
+        setLimit(_moduleID, _limit, utcSteadyTimeUs());
+    }
+    void removeLimit(uint16_t _moduleID);
+    bool limited(uint16_t _moduleID) const;
+    // no module is limited, the send path skips the limiter
+    bool empty() const { return m_modules == 0; }
+
+    /**
+     * @brief: account a message of _bytes to _nodeID, nullptr for the broadcasts
+     * @param _now: the steady time in microseconds
+     */
+    Admission admit(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID, size_t _bytes,
+        uint64_t _now);
+    Admission admit(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID, size_t _bytes)
+    {
+        return admit(_moduleID, _nodeID, _bytes, utcSteadyTimeUs());
+    }
+
+    // the rates of the limited modules since the previous call, sorted by moduleID
+    std::vector<ModuleRate> rates(uint64_t _now);
+    std::vector<ModuleRate> rates() { return rates(utcSteadyTimeUs()); }
+
+private:
+    struct Buckets
+    {
+        bool initialized = false;
+        // nullptr if the rate is not limited
+        std::unique_ptr<TokenBucket> messages;
+        std::unique_ptr<TokenBucket> bytes;
+    };
+    struct ModuleState
+    {
+        RateLimit limit;
+        Buckets module;
+        std::unordered_map<bcos::crypto::NodeIDPtr, Buckets, NodeIDHasher, NodeIDEqual>
+            destinations;
+        // broadcasts of a perDestination limit
+        Buckets broadcast;
+        uint64_t messages = 0;
+        uint64_t bytes = 0;
+        uint64_t delayed = 0;
+        uint64_t rejected = 0;
+        uint64_t exportTime = 0;
+        uint64_t exportMessages = 0;
+        uint64_t exportBytes = 0;
+    };
+
+    static void initBuckets(Buckets& _buckets, const RateLimit& _limit, uint64_t _now);
+
+    mutable bcos::Mutex x_modules;
+    std::unordered_map<uint16_t, ModuleState> m_states;
+    std::atomic<size_t> m_modules = {0};
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the deterministic relay tree of a broadcast and the dedup of the relayed broadcasts
+ * @file RelayTree.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/RelayTree.h>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::front;
+
+namespace
+{
+// splitmix64 finalizer, spreads the nodes differently for every broadcast
+uint64_t mix(uint64_t _value)
+{
+    _value ^= _value >> 30;
+    _value *= 0xbf58476d1ce4e5b9ULL;
+    _value ^= _value >> 27;
+    _value *= 0x94d049bb133111ebULL;
+    return _value ^ (_value >> 31);
+}
+}  // namespace
+
+uint64_t RelayTree::nodeHash(const bcos::crypto::NodeIDPtr& _nodeID)
+{
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (auto byte : _nodeID->data())
+    {
+        hash ^= byte;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+RelayTree::RelayTree(const bcos::crypto::NodeIDs& _members, const bcos::crypto::NodeIDPtr& _self,
+    uint64_t _origin, uint64_t _broadcastID, uint8_t _fanout)
+  : m_fanout(std::max<size_t>(_fanout, 1))
+{
+    std::vector<std::pair<uint64_t, bcos::crypto::NodeIDPtr>> ranked;
+    ranked.reserve(_members.size() + 1);
+    bool originFound = false;
+    auto rank = [&](const bcos::crypto::NodeIDPtr& _nodeID) {
+        auto hash = nodeHash(_nodeID);
+        if (hash == _origin)
+        {
+            originFound = true;
+            // the origin is the root
+            return std::make_pair(uint64_t(0), _nodeID);
+        }
+        // 0 is left to the origin
+        return std::make_pair(std::max<uint64_t>(mix(hash ^ _broadcastID), 1), _nodeID);
+    };
+    for (auto const& member : _members)
+    {
+        ranked.emplace_back(rank(member));
+    }
+    ranked.emplace_back(rank(_self));
+    // ties of the rank are broken by the key data, the order is the same on every node
+    std::sort(ranked.begin(), ranked.end(), [](auto const& _lhs, auto const& _rhs) {
+        if (_lhs.first != _rhs.first)
+        {
+            return _lhs.first < _rhs.first;
+        }
+        return _lhs.second->data() < _rhs.second->data();
+    });
+    NodeIDEqual equal;
+    for (auto const& entry : ranked)
+    {
+        if (!m_nodes.empty() && equal(m_nodes.back(), entry.second))
+        {
+            continue;
+        }
+        if (equal(entry.second, _self))
+        {
+            m_position = m_nodes.size();
+        }
+        m_nodes.emplace_back(entry.second);
+    }
+    m_valid = originFound;
+}
+
+size_t RelayTree::depth() const
+{
+    size_t depth = 0;
+    // the last position of every level: 0, k, k + k^2, ...
+    for (size_t last = 0, width = 1; last + 1 < m_nodes.size(); ++depth)
+    {
+        width *= m_fanout;
+        last += width;
+    }
+    return depth;
+}
+
+bcos::crypto::NodeIDs RelayTree::children() const
+{
+    bcos::crypto::NodeIDs nodes;
+    for (auto position : children(m_position))
+    {
+        nodes.emplace_back(m_nodes[position]);
+    }
+    return nodes;
+}
+
+std::vector<size_t> RelayTree::children(size_t _position) const
+{
+    std::vector<size_t> children;
+    if (!m_valid)
+    {
+        return children;
+    }
+    auto first = _position * m_fanout + 1;
+    for (auto position = first; position < first + m_fanout && position < m_nodes.size();
+         ++position)
+    {
+        children.emplace_back(position);
+    }
+    return children;
+}
+
+bool RelayDedup::insert(uint64_t _origin, uint64_t _broadcastID)
+{
+    auto key = _broadcastID ^ mix(_origin);
+    Guard l(x_seen);
+    if (!m_seen.insert(key).second)
+    {
+        m_duplicates++;
+        return false;
+    }
+    m_order.push_back(key);
+    if (m_order.size() > m_capacity)
+    {
+        m_seen.erase(m_order.front());
+        m_order.pop_front();
+    }
+    return true;
+}
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the deterministic relay tree of a broadcast and the dedup of the relayed broadcasts
+ * @file RelayTree.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/NodeIDsSnapshot.h>
+#include <deque>
+#include <unordered_set>
+
+namespace bcos
+{
+namespace front
+{
+/**
+ * the members of the group ordered by a hash mixed with the broadcastID, the origin first, laid
+ * out as a complete _fanout-ary tree: the node at position p forwards to the positions
+ * p * fanout + 1 ... p * fanout + fanout. Every node computes the same tree from the same
+ * membership, so the tree needs no more than (broadcastID, origin, fanout) in the header
+ */
+class RelayTree
+{
+public:
+    /**
+     * @param _members: the members of the group, duplicated nodes and _self are allowed
+     * @param _self: the node computing the tree, always a member of it
+     * @param _origin: nodeHash of the broadcaster
+     */
+    RelayTree(const bcos::crypto::NodeIDs& _members, const bcos::crypto::NodeIDPtr& _self,
+        uint64_t _origin, uint64_t _broadcastID, uint8_t _fanout);
+
+    // stable hash of the key data of the node, the same on every platform
+    static uint64_t nodeHash(const bcos::crypto::NodeIDPtr& _nodeID);
+
+    // false if the origin is not a known member, the tree can not be built
+    bool valid() const { return m_valid; }
+    size_t size() const { return m_nodes.size(); }
+    // the levels below the origin
+    size_t depth() const;
+    // position of _self in the tree, 0 for the origin
+    size_t position() const { return m_position; }
+    // the nodes _self forwards the broadcast to
+    bcos::crypto::NodeIDs children() const;
+    // positions of the nodes the node at _position forwards the broadcast to
+    std::vector<size_t> children(size_t _position) const;
+    bcos::crypto::NodeIDPtr const& node(size_t _position) const { return m_nodes[_position]; }
+
+private:
+    std::vector<bcos::crypto::NodeIDPtr> m_nodes;
+    size_t m_fanout;
+    size_t m_position = 0;
+    bool m_valid = false;
+};
+
+/// the relayed broadcasts seen recently, bounded by the capacity in FIFO order
+class RelayDedup
+{
+public:
+    using Ptr = std::shared_ptr<RelayDedup>;
+    constexpr static size_t DEFAULT_CAPACITY = 8192;
+
+    explicit RelayDedup(size_t _capacity = DEFAULT_CAPACITY)
+      : m_capacity(std::max<size_t>(_capacity, 1))
+    {}
+
+    // false if the broadcast has been seen
+    bool insert(uint64_t _origin, uint64_t _broadcastID);
+    size_t size() const
+    {
+        Guard l(x_seen);
+        return m_order.size();
+    }
+    uint64_t duplicates() const { return m_duplicates; }
+
+private:
+    size_t m_capacity;
+    mutable bcos::Mutex x_seen;
+    std::unordered_set<uint64_t> m_seen;
+    std::deque<uint64_t> m_order;
+    std::atomic<uint64_t> m_duplicates = {0};
+};
+}  // namespace front
+}  // namespace bcos
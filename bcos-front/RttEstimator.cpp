@@ -0,0 +1,154 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief round trip time estimation and the adaptive request timeouts derived from it
+ * @file RttEstimator.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/RttEstimator.h>
+#include <cmath>
+
+using namespace bcos;
+using namespace bcos::front;
+
+double RttEstimator::bucketBound(size_t _index)
+{
+    return std::pow(1.25, _index);
+}
+
+void RttEstimator::addSample(uint64_t _rtt)
+{
+    double rtt = (double)_rtt;
+    // RFC 6298
+    if (m_samples == 0)
+    {
+        m_srtt = rtt;
+        m_rttvar = rtt / 2;
+    }
+    else
+    {
+        m_rttvar = 0.75 * m_rttvar + 0.25 * std::fabs(m_srtt - rtt);
+        m_srtt = 0.875 * m_srtt + 0.125 * rtt;
+    }
+    m_samples++;
+    m_backoff = 1;
+
+    size_t index = 0;
+    if (rtt > 1)
+    {
+        index = std::min<size_t>((size_t)std::ceil(std::log(rtt) / std::log(1.25)), BUCKETS - 1);
+    }
+    m_histogram[index] += 1;
+    m_total += 1;
+    if (m_samples % DECAY_SAMPLES == 0)
+    {
+        for (auto& count : m_histogram)
+        {
+            count /= 2;
+        }
+        m_total /= 2;
+    }
+}
+
+double RttEstimator::quantile(double _quantile) const
+{
+    if (m_total <= 0)
+    {
+        return 0;
+    }
+    double target = m_total * _quantile;
+    double count = 0;
+    for (size_t i = 0; i < BUCKETS; ++i)
+    {
+        count += m_histogram[i];
+        if (count >= target)
+        {
+            return bucketBound(i);
+        }
+    }
+    return bucketBound(BUCKETS - 1);
+}
+
+uint32_t RttEstimator::timeout(const AdaptiveTimeoutPolicy& _policy) const
+{
+    double timeout = _policy.initialTimeout;
+    if (m_samples >= _policy.minSamples)
+    {
+        timeout = std::max(m_srtt + 4 * m_rttvar, quantile(_policy.quantile));
+    }
+    timeout *= m_backoff;
+    timeout = std::max<double>(timeout, _policy.minTimeout);
+    timeout = std::min<double>(timeout, _policy.maxTimeout);
+    return (uint32_t)std::ceil(timeout);
+}
+
+AdaptiveTimeoutPolicy AdaptiveTimeout::policy(uint16_t _moduleID) const
+{
+    Guard l(x_estimators);
+    auto it = m_modulePolicies.find(_moduleID);
+    return it == m_modulePolicies.end() ? m_policy : it->second;
+}
+
+void AdaptiveTimeout::setPolicy(AdaptiveTimeoutPolicy _policy)
+{
+    Guard l(x_estimators);
+    m_policy = _policy;
+}
+
+void AdaptiveTimeout::setModulePolicy(uint16_t _moduleID, AdaptiveTimeoutPolicy _policy)
+{
+    Guard l(x_estimators);
+    m_modulePolicies[_moduleID] = _policy;
+}
+
+uint32_t AdaptiveTimeout::timeout(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID) const
+{
+    Guard l(x_estimators);
+    auto policy = m_policy;
+    auto modulePolicy = m_modulePolicies.find(_moduleID);
+    if (modulePolicy != m_modulePolicies.end())
+    {
+        policy = modulePolicy->second;
+    }
+    auto it = m_estimators.find(Key(_moduleID, _nodeID));
+    if (it == m_estimators.end())
+    {
+        return RttEstimator().timeout(policy);
+    }
+    return it->second.timeout(policy);
+}
+
+void AdaptiveTimeout::addSample(
+    uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID, uint64_t _rtt)
+{
+    Guard l(x_estimators);
+    m_estimators[Key(_moduleID, _nodeID)].addSample(_rtt);
+}
+
+void AdaptiveTimeout::onTimeout(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID)
+{
+    Guard l(x_estimators);
+    m_estimators[Key(_moduleID, _nodeID)].onTimeout();
+}
+
+RttEstimator AdaptiveTimeout::estimator(
+    uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID) const
+{
+    Guard l(x_estimators);
+    auto it = m_estimators.find(Key(_moduleID, _nodeID));
+    return it == m_estimators.end() ? RttEstimator() : it->second;
+}
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief round trip time estimation and the adaptive request timeouts derived from it
+ * @file RttEstimator.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/NodeIDsSnapshot.h>
+#include <array>
+
+namespace bcos
+{
+namespace front
+{
+struct AdaptiveTimeoutPolicy
+{
+    // bounds of the computed timeout, in milliseconds
+    uint32_t minTimeout = 200;
+    uint32_t maxTimeout = 30000;
+    // used until minSamples round trips are observed
+    uint32_t initialTimeout = 3000;
+    uint32_t minSamples = 8;
+    // the timeout is at least this quantile of the observed round trips
+    double quantile = 0.99;
+};
+
+/**
+ * round trip times of one peer and module, the timeout is computed as the TCP RTO does,
+ * SRTT + 4 * RTTVAR, raised to the streaming quantile of a decaying log scale histogram and
+ * doubled by every timeout until the next response
+ */
+class RttEstimator
+{
+public:
+    // the histogram buckets grow by 25% from 1ms, the last one is above 200s
+    constexpr static size_t BUCKETS = 56;
+    // the counts are halved every DECAY_SAMPLES samples to follow the recent round trips
+    constexpr static uint32_t DECAY_SAMPLES = 256;
+
+    // add a round trip time, in milliseconds
+    void addSample(uint64_t _rtt);
+    // a request timed out, the timeout is backed off until the next sample
+    void onTimeout() { m_backoff = std::min<uint32_t>(m_backoff * 2, 64); }
+
+    uint64_t samples() const { return m_samples; }
+    double srtt() const { return m_srtt; }
+    double rttvar() const { return m_rttvar; }
+    // estimated _quantile of the recent round trips, in milliseconds
+    double quantile(double _quantile) const;
+
+    uint32_t timeout(const AdaptiveTimeoutPolicy& _policy) const;
+
+    // upper bound of bucket _index, in milliseconds
+    static double bucketBound(size_t _index);
+
+private:
+    uint64_t m_samples = 0;
+    double m_srtt = 0;
+    double m_rttvar = 0;
+    uint32_t m_backoff = 1;
+    std::array<double, BUCKETS> m_histogram = {};
+    double m_total = 0;
+};
+
+// the adaptive timeout of every peer and module
+class AdaptiveTimeout
+{
+public:
+    using Ptr = std::shared_ptr<AdaptiveTimeout>;
+
+    AdaptiveTimeout(AdaptiveTimeoutPolicy _policy = AdaptiveTimeoutPolicy()) : m_policy(_policy)
+    {}
+    AdaptiveTimeout(const AdaptiveTimeout&) = delete;
+    AdaptiveTimeout& operator=(const AdaptiveTimeout&) = delete;
+
+    AdaptiveTimeoutPolicy policy(uint16_t _moduleID) const;
+    void setPolicy(AdaptiveTimeoutPolicy _policy);
+    // override the default policy for one module
+    void setModulePolicy(uint16_t _moduleID, AdaptiveTimeoutPolicy _policy);
+
+    // the timeout in milliseconds of a request to _nodeID
+    uint32_t timeout(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID) const;
+
+    void addSample(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID, uint64_t _rtt);
+    void onTimeout(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID);
+
+    // copy of the estimator, empty if no sample
+    RttEstimator estimator(uint16_t _moduleID, const bcos::crypto::NodeIDPtr& _nodeID) const;
+
+private:
+    using Key = std::pair<uint16_t, bcos::crypto::NodeIDPtr>;
+    struct KeyHasher
+    {
+        size_t operator()(const Key& _key) const
+        {
+            return NodeIDHasher()(_key.second) * 31 + _key.first;
+        }
+    };
+    struct KeyEqual
+    {
+        bool operator()(const Key& _lhs, const Key& _rhs) const
+        {
+            return _lhs.first == _rhs.first && NodeIDEqual()(_lhs.second, _rhs.second);
+        }
+    };
+
+    mutable bcos::Mutex x_estimators;
+    AdaptiveTimeoutPolicy m_policy;
+    std::unordered_map<uint16_t, AdaptiveTimeoutPolicy> m_modulePolicies;
+    std::unordered_map<Key, RttEstimator, KeyHasher, KeyEqual> m_estimators;
+};
+}  // namespace front
+}  // namespace bcos
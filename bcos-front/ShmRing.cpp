@@ -0,0 +1,325 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief single-producer/single-consumer rings in POSIX shared memory with eventfd wakeups
+ * @file ShmRing.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/libutilities/Exceptions.h>
+#include <bcos-front/Common.h>
+#include <bcos-front/ShmRing.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::front;
+
+namespace
+{
+// the header of the segment, then the two control blocks, then the two rings
+const size_t CONTROL_OFFSET = 64;
+const size_t DATA_OFFSET = 4096;
+// a full ring is polled by yields first, the consumer usually frees space at once, then by
+// sleeps doubled up to the max so that a stalled consumer doesn't take a core
+const size_t WRITE_YIELDS = 64;
+const std::chrono::microseconds MIN_WRITE_SLEEP(10);
+const std::chrono::microseconds MAX_WRITE_SLEEP(1000);
+
+inline uint64_t alignRecord(uint64_t _length)
+{
+    return (_length + 7) & ~(uint64_t)7;
+}
+
+inline ShmRingControl* control(byte* _data, size_t _index)
+{
+    return (ShmRingControl*)(_data + CONTROL_OFFSET + _index * sizeof(ShmRingControl));
+}
+}  // namespace
+
+byte* ShmRing::reserve(size_t _size)
+{
+    if (_size == 0 || _size > maxRecordSize())
+    {
+        return nullptr;
+    }
+    uint64_t length = alignRecord(RECORD_HEADER_LENGTH + _size);
+    uint64_t offset = m_head & (m_capacity - 1);
+    // a record never wraps, skip the end of the ring
+    uint64_t padding = offset + length > m_capacity ? m_capacity - offset : 0;
+    if (m_head + padding + length - m_control->tail.load(std::memory_order_acquire) >
+        m_capacity)
+    {
+        return nullptr;
+    }
+    if (padding > 0)
+    {
+        memcpy(m_data + offset, &PADDING, RECORD_HEADER_LENGTH);
+        m_head += padding;
+        offset = 0;
+    }
+    uint32_t recordLength = _size;
+    memcpy(m_data + offset, &recordLength, RECORD_HEADER_LENGTH);
+    m_head += length;
+    return m_data + offset + RECORD_HEADER_LENGTH;
+}
+
+void ShmRing::commit()
+{
+    m_control->head.store(m_head, std::memory_order_release);
+    // pairs with the fence of wait: either the consumer sees the head or this sees it sleeping,
+    // cleared so that the commits before the consumer runs again write the eventfd once
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_control->sleeping.load(std::memory_order_relaxed) &&
+        m_control->sleeping.exchange(0, std::memory_order_relaxed))
+    {
+        wakeUp();
+        m_wakeUps.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool ShmRing::write(size_t _size, const std::function<void(byte*)>& _fill, int _timeout)
+{
+    std::lock_guard<std::mutex> lock(x_write);
+    auto record = reserve(_size);
+    if (!record && _size > 0 && _size <= maxRecordSize())
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_timeout);
+        size_t yields = 0;
+        auto sleep = MIN_WRITE_SLEEP;
+        // x_write is held on: the other producers couldn't write before this one anyway
+        while (!record && std::chrono::steady_clock::now() < deadline)
+        {
+            if (yields < WRITE_YIELDS)
+            {
+                ++yields;
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(sleep);
+                sleep = std::min(sleep * 2, MAX_WRITE_SLEEP);
+            }
+            record = reserve(_size);
+        }
+    }
+    if (!record)
+    {
+        return false;
+    }
+    _fill(record);
+    commit();
+    return true;
+}
+
+bool ShmRing::peek(bytesConstRef& _record)
+{
+    if (corrupted())
+    {
+        return false;
+    }
+    auto head = m_control->head.load(std::memory_order_acquire);
+    while (m_tail != head)
+    {
+        uint64_t offset = m_tail & (m_capacity - 1);
+        uint32_t length = 0;
+        memcpy(&length, m_data + offset, RECORD_HEADER_LENGTH);
+        if (length == PADDING && head - m_tail <= m_capacity)
+        {
+            m_tail += m_capacity - offset;
+            continue;
+        }
+        // written by the other process, a record out of the ring would be read past the mapping
+        if (head - m_tail > m_capacity || length > m_capacity - offset - RECORD_HEADER_LENGTH ||
+            alignRecord(RECORD_HEADER_LENGTH + length) > head - m_tail)
+        {
+            m_corrupted = true;
+            FRONT_LOG(ERROR) << LOG_BADGE("ShmRing") << LOG_DESC("corrupted record, stop reading")
+                             << LOG_KV("length", length) << LOG_KV("tail", m_tail)
+                             << LOG_KV("head", head);
+            return false;
+        }
+        m_tail += alignRecord(RECORD_HEADER_LENGTH + length);
+        _record = bytesConstRef(m_data + offset + RECORD_HEADER_LENGTH, length);
+        return true;
+    }
+    return false;
+}
+
+void ShmRing::release()
+{
+    m_control->tail.store(m_tail, std::memory_order_release);
+}
+
+bool ShmRing::wait(int _timeout)
+{
+    m_control->sleeping.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_control->head.load(std::memory_order_acquire) == m_tail)
+    {
+        struct pollfd pollFd = {m_eventFd, POLLIN, 0};
+        if (::poll(&pollFd, 1, _timeout) > 0)
+        {
+            uint64_t count = 0;
+            if (::read(m_eventFd, &count, sizeof(count)) < 0)
+            {
+                // drained by a concurrent wait, nothing to do
+            }
+        }
+    }
+    m_control->sleeping.store(0, std::memory_order_relaxed);
+    return m_control->head.load(std::memory_order_acquire) != m_tail;
+}
+
+void ShmRing::wakeUp()
+{
+    uint64_t one = 1;
+    if (::write(m_eventFd, &one, sizeof(one)) < 0)
+    {
+        // the counter is saturated, the consumer is woken anyway
+    }
+}
+
+ShmChannel::Ptr ShmChannel::create(const std::string& _name, size_t _capacity)
+{
+    if (_capacity < DATA_OFFSET || (_capacity & (_capacity - 1)) != 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidParameter() << errinfo_comment(
+                                  "ShmChannel: capacity must be a power of 2 of 4096 at least"));
+    }
+    auto fd = ::shm_open(_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidParameter()
+                              << errinfo_comment("ShmChannel: create segment failed " + _name));
+    }
+    auto channel = Ptr(new ShmChannel(_name, true));
+    auto size = DATA_OFFSET + 2 * _capacity;
+    if (::ftruncate(fd, size) != 0)
+    {
+        ::close(fd);
+        BOOST_THROW_EXCEPTION(InvalidParameter()
+                              << errinfo_comment("ShmChannel: resize segment failed " + _name));
+    }
+    channel->map(fd, size);
+
+    auto header = (Header*)channel->m_data;
+    header->magic = MAGIC;
+    header->version = VERSION;
+    header->capacity = _capacity;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        auto ringControl = new (control(channel->m_data, i)) ShmRingControl();
+        ringControl->head.store(0);
+        ringControl->tail.store(0);
+        ringControl->sleeping.store(0);
+    }
+    channel->m_capacity = _capacity;
+    channel->m_toGatewayFd = ::eventfd(0, EFD_NONBLOCK);
+    channel->m_toFrontFd = ::eventfd(0, EFD_NONBLOCK);
+    if (channel->m_toGatewayFd < 0 || channel->m_toFrontFd < 0)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("ShmChannel: create eventfd failed " + _name));
+    }
+    channel->m_toGateway = std::make_unique<ShmRing>(control(channel->m_data, 0),
+        channel->m_data + DATA_OFFSET, _capacity, channel->m_toGatewayFd);
+    channel->m_toFront = std::make_unique<ShmRing>(control(channel->m_data, 1),
+        channel->m_data + DATA_OFFSET + _capacity, _capacity, channel->m_toFrontFd);
+
+    FRONT_LOG(INFO) << LOG_DESC("ShmChannel create") << LOG_KV("name", _name)
+                    << LOG_KV("capacity", _capacity);
+    return channel;
+}
+
+ShmChannel::Ptr ShmChannel::attach(const std::string& _name, int _toGatewayFd, int _toFrontFd)
+{
+    auto channel = Ptr(new ShmChannel(_name, false));
+    // owned from now on, closed even if the segment is invalid
+    channel->m_toGatewayFd = _toGatewayFd;
+    channel->m_toFrontFd = _toFrontFd;
+    auto fd = ::shm_open(_name.c_str(), O_RDWR, 0600);
+    struct stat segmentStat;
+    if (fd < 0 || ::fstat(fd, &segmentStat) != 0 ||
+        (size_t)segmentStat.st_size < DATA_OFFSET + 2 * DATA_OFFSET)
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("ShmChannel: invalid segment " + _name));
+    }
+    channel->map(fd, segmentStat.st_size);
+    auto header = (const Header*)channel->m_data;
+    if (header->magic != MAGIC || header->version != VERSION ||
+        DATA_OFFSET + 2 * header->capacity != channel->m_size)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("ShmChannel: invalid segment " + _name));
+    }
+    channel->m_capacity = header->capacity;
+    channel->m_toGateway = std::make_unique<ShmRing>(control(channel->m_data, 0),
+        channel->m_data + DATA_OFFSET, channel->m_capacity, _toGatewayFd);
+    channel->m_toFront = std::make_unique<ShmRing>(control(channel->m_data, 1),
+        channel->m_data + DATA_OFFSET + channel->m_capacity, channel->m_capacity, _toFrontFd);
+    return channel;
+}
+
+void ShmChannel::map(int _fd, size_t _size)
+{
+    // populated, the first laps of the rings do not fault the pages in
+    auto data =
+        ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, 0);
+    // the mapping holds the segment
+    ::close(_fd);
+    if (data == MAP_FAILED)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("ShmChannel: mmap failed " + m_name));
+    }
+    m_data = (byte*)data;
+    m_size = _size;
+}
+
+ShmChannel::~ShmChannel()
+{
+    m_toGateway.reset();
+    m_toFront.reset();
+    if (m_data)
+    {
+        ::munmap(m_data, m_size);
+    }
+    for (auto fd : {m_toGatewayFd, m_toFrontFd})
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+    if (m_owner)
+    {
+        ::shm_unlink(m_name.c_str());
+    }
+}
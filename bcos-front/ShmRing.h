@@ -0,0 +1,162 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief single-producer/single-consumer rings in POSIX shared memory with eventfd wakeups
+ * @file ShmRing.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace bcos
+{
+namespace front
+{
+/// the control block of a ring, the positions only grow, offset = position % capacity
+struct ShmRingControl
+{
+    // written by the producer
+    alignas(64) std::atomic<uint64_t> head;
+    // written by the consumer
+    alignas(64) std::atomic<uint64_t> tail;
+    // the consumer is about to sleep on its eventfd, the producer wakes it and clears this
+    alignas(64) std::atomic<uint32_t> sleeping;
+};
+
+/**
+ * records of length(4) + data, 8 bytes aligned, a record never wraps: the end of the ring is
+ * skipped by a padding record instead; one producer and one consumer, each may live in another
+ * process mapping the same memory
+ */
+class ShmRing
+{
+public:
+    /// length of a padding record
+    constexpr static uint32_t PADDING = 0xffffffff;
+    constexpr static size_t RECORD_HEADER_LENGTH = 4;
+
+    // _capacity is a power of 2, the memory is initialized by ShmChannel
+    ShmRing(ShmRingControl* _control, byte* _data, size_t _capacity, int _eventFd)
+      : m_control(_control),
+        m_data(_data),
+        m_capacity(_capacity),
+        m_eventFd(_eventFd),
+        m_head(_control->head.load()),
+        m_tail(_control->tail.load())
+    {}
+
+    // the largest record the ring takes
+    size_t maxRecordSize() const { return m_capacity / 2 - RECORD_HEADER_LENGTH; }
+
+    /// producer, reserve and commit are called by one thread at a time
+    // the memory of a _size bytes record, nullptr if the ring is full or _size is 0
+    byte* reserve(size_t _size);
+    // publish the reserved records, wake the consumer if it sleeps
+    void commit();
+    // reserve, _fill and commit a _size bytes record under a lock, for the producers of many
+    // threads; wait up to _timeout milliseconds for the consumer if full, yielding then
+    // sleeping longer and longer, false if timed out
+    bool write(size_t _size, const std::function<void(byte*)>& _fill, int _timeout);
+
+    /// consumer, one thread
+    // the next record, false if none or the ring is corrupted, valid until release
+    bool peek(bytesConstRef& _record);
+    // give the records peeked back to the producer
+    void release();
+    // sleep until a record is committed, up to _timeout milliseconds; false if timed out
+    bool wait(int _timeout);
+    // wake the consumer from wait, e.g. to stop it
+    void wakeUp();
+
+    // the eventfd writes of the producer, the records committed while the consumer was awake
+    // need none
+    uint64_t wakeUps() const { return m_wakeUps.load(std::memory_order_relaxed); }
+    // a record out of the ring was peeked, nothing is read any more
+    bool corrupted() const { return m_corrupted.load(std::memory_order_relaxed); }
+
+private:
+    ShmRingControl* m_control;
+    byte* m_data;
+    size_t m_capacity;
+    int m_eventFd;
+    // the positions of the reserved and the peeked records, not published yet
+    uint64_t m_head;
+    uint64_t m_tail;
+    std::mutex x_write;
+    std::atomic<uint64_t> m_wakeUps = {0};
+    std::atomic<bool> m_corrupted = {false};
+};
+
+/**
+ * the shared memory segment of a front and a gateway: a ring per direction and an eventfd per
+ * ring the consumer sleeps on; the creator passes the eventfds to the other process, e.g. by
+ * fork or over a unix socket, and unlinks the segment when destroyed
+ */
+class ShmChannel
+{
+public:
+    using Ptr = std::shared_ptr<ShmChannel>;
+
+    constexpr static uint32_t MAGIC = 0x48534642;  // "BFSH"
+    constexpr static uint32_t VERSION = 1;
+
+    // create the segment _name, e.g. "/bcos-front-group0", with two rings of _capacity bytes
+    static Ptr create(const std::string& _name, size_t _capacity);
+    // map the segment created by the other process with the eventfds it passed
+    static Ptr attach(const std::string& _name, int _toGatewayFd, int _toFrontFd);
+
+    ShmChannel(const ShmChannel&) = delete;
+    ShmChannel& operator=(const ShmChannel&) = delete;
+    ~ShmChannel();
+
+    const std::string& name() const { return m_name; }
+    size_t capacity() const { return m_capacity; }
+    int toGatewayFd() const { return m_toGatewayFd; }
+    int toFrontFd() const { return m_toFrontFd; }
+
+    // written by the front, read by the gateway
+    ShmRing& toGateway() { return *m_toGateway; }
+    // written by the gateway, read by the front
+    ShmRing& toFront() { return *m_toFront; }
+
+private:
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+    };
+
+    ShmChannel(const std::string& _name, bool _owner) : m_name(_name), m_owner(_owner) {}
+    void map(int _fd, size_t _size);
+
+    std::string m_name;
+    bool m_owner;
+    byte* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+    int m_toGatewayFd = -1;
+    int m_toFrontFd = -1;
+    std::unique_ptr<ShmRing> m_toGateway;
+    std::unique_ptr<ShmRing> m_toFront;
+};
+}  // namespace front
+}  // namespace bcos
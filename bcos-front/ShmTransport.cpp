@@ -0,0 +1,631 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the frames of a co-located front and gateway over the rings of a ShmChannel
+ * @file ShmTransport.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/Common.h>
+#include <bcos-front/ShmTransport.h>
+#include <cstring>
+#include <limits>
+
+using namespace bcos;
+using namespace bcos::front;
+
+namespace
+{
+class RecordWriter
+{
+public:
+    explicit RecordWriter(byte* _data) : m_data(_data) {}
+
+    template <typename T>
+    void put(T _value)
+    {
+        memcpy(m_data, &_value, sizeof(T));
+        m_data += sizeof(T);
+    }
+    void putBytes(const byte* _data, size_t _size)
+    {
+        memcpy(m_data, _data, _size);
+        m_data += _size;
+    }
+    void putGroup(const std::string& _groupID)
+    {
+        put<uint8_t>(_groupID.size());
+        putBytes((const byte*)_groupID.data(), _groupID.size());
+    }
+    void putNodeID(const bytes& _nodeID)
+    {
+        put<uint16_t>(_nodeID.size());
+        putBytes(_nodeID.data(), _nodeID.size());
+    }
+
+private:
+    byte* m_data;
+};
+
+class RecordReader
+{
+public:
+    explicit RecordReader(bytesConstRef _record) : m_record(_record) {}
+
+    template <typename T>
+    bool get(T& _value)
+    {
+        if (m_offset + sizeof(T) > m_record.size())
+        {
+            return false;
+        }
+        memcpy(&_value, m_record.data() + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+    bool getBytes(size_t _size, bytesConstRef& _data)
+    {
+        if (m_offset + _size > m_record.size())
+        {
+            return false;
+        }
+        _data = bytesConstRef(m_record.data() + m_offset, _size);
+        m_offset += _size;
+        return true;
+    }
+    bool getGroup(bytesConstRef& _groupID)
+    {
+        uint8_t length = 0;
+        return get(length) && getBytes(length, _groupID);
+    }
+    bool getNodeID(bytesConstRef& _nodeID)
+    {
+        uint16_t length = 0;
+        return get(length) && getBytes(length, _nodeID);
+    }
+    // the payload, the rest of the record
+    bytesConstRef rest() const
+    {
+        return bytesConstRef(m_record.data() + m_offset, m_record.size() - m_offset);
+    }
+
+private:
+    bytesConstRef m_record;
+    size_t m_offset = 0;
+};
+
+inline size_t groupSize(const std::string& _groupID)
+{
+    return 1 + _groupID.size();
+}
+
+inline size_t nodeIDSize(const bytes& _nodeID)
+{
+    return 2 + _nodeID.size();
+}
+
+inline bool validGroup(const std::string& _groupID)
+{
+    return _groupID.size() <= std::numeric_limits<uint8_t>::max();
+}
+
+inline std::string toString(bytesConstRef _data)
+{
+    return std::string((const char*)_data.data(), _data.size());
+}
+}  // namespace
+
+void ShmGateway::start() {}
+
+void ShmGateway::stop()
+{
+    std::map<uint64_t, PendingResult> pending;
+    {
+        std::lock_guard<std::mutex> lock(x_pending);
+        pending.swap(m_pending);
+    }
+    auto error = std::make_shared<Error>(FrontError::PeerDisconnected, "shm gateway stopped");
+    for (auto& entry : pending)
+    {
+        entry.second.errorRespFunc(error);
+    }
+}
+
+void ShmGateway::asyncGetPeers(std::function<void(
+        Error::Ptr, bcos::gateway::GatewayInfo::Ptr, bcos::gateway::GatewayInfosPtr)>
+        _onGetPeers)
+{
+    if (m_control)
+    {
+        m_control->asyncGetPeers(_onGetPeers);
+    }
+}
+
+void ShmGateway::asyncGetNodeIDs(const std::string& _groupID, GetNodeIDsFunc _getNodeIDsFunc)
+{
+    if (m_control)
+    {
+        m_control->asyncGetNodeIDs(_groupID, _getNodeIDsFunc);
+    }
+}
+
+void ShmGateway::asyncNotifyGroupInfo(
+    bcos::group::GroupInfo::Ptr _groupInfo, std::function<void(Error::Ptr&&)> _callback)
+{
+    if (m_control)
+    {
+        m_control->asyncNotifyGroupInfo(_groupInfo, _callback);
+    }
+}
+
+void ShmGateway::asyncSendMessageByTopic(const std::string& _topic, bcos::bytesConstRef _data,
+    std::function<void(bcos::Error::Ptr&&, int16_t, bytesPointer)> _respFunc)
+{
+    if (m_control)
+    {
+        m_control->asyncSendMessageByTopic(_topic, _data, _respFunc);
+    }
+}
+
+void ShmGateway::asyncSendBroadbastMessageByTopic(
+    const std::string& _topic, bcos::bytesConstRef _data)
+{
+    if (m_control)
+    {
+        m_control->asyncSendBroadbastMessageByTopic(_topic, _data);
+    }
+}
+
+void ShmGateway::asyncSubscribeTopic(std::string const& _clientID, std::string const& _topicInfo,
+    std::function<void(Error::Ptr&&)> _callback)
+{
+    if (m_control)
+    {
+        m_control->asyncSubscribeTopic(_clientID, _topicInfo, _callback);
+    }
+}
+
+void ShmGateway::asyncRemoveTopic(std::string const& _clientID,
+    std::vector<std::string> const& _topics, std::function<void(Error::Ptr&&)> _callback)
+{
+    if (m_control)
+    {
+        m_control->asyncRemoveTopic(_clientID, _topics, _callback);
+    }
+}
+
+void ShmGateway::asyncSendMessageByNodeID(const std::string& _groupID,
+    bcos::crypto::NodeIDPtr _srcNodeID, bcos::crypto::NodeIDPtr _dstNodeID, bytesConstRef _payload,
+    bcos::gateway::ErrorRespFunc _errorRespFunc)
+{
+    uint64_t seq = 0;
+    if (_errorRespFunc)
+    {
+        std::lock_guard<std::mutex> lock(x_pending);
+        seq = ++m_seq;
+        m_pending.emplace(seq, PendingResult{_errorRespFunc, utcSteadyTime() + RESULT_TIMEOUT});
+    }
+    auto const& src = _srcNodeID->data();
+    auto const& dst = _dstNodeID->data();
+    auto size =
+        1 + 8 + groupSize(_groupID) + nodeIDSize(src) + nodeIDSize(dst) + _payload.size();
+    auto written = validGroup(_groupID) && write(size, [&](byte* _record) {
+        RecordWriter writer(_record);
+        writer.put(ShmRecordType::Send);
+        writer.put(seq);
+        writer.putGroup(_groupID);
+        writer.putNodeID(src);
+        writer.putNodeID(dst);
+        writer.putBytes(_payload.data(), _payload.size());
+    });
+    if (!written && seq > 0)
+    {
+        onSendResult(
+            seq, std::make_shared<Error>(FrontError::Overloaded, "not written to the shm ring"));
+    }
+}
+
+void ShmGateway::asyncSendMessageByNodeIDs(const std::string& _groupID,
+    bcos::crypto::NodeIDPtr _srcNodeID, const bcos::crypto::NodeIDs& _dstNodeIDs,
+    bytesConstRef _payload)
+{
+    if (_dstNodeIDs.empty() || _dstNodeIDs.size() > std::numeric_limits<uint16_t>::max())
+    {
+        return;
+    }
+    auto const& src = _srcNodeID->data();
+    auto size = 1 + groupSize(_groupID) + nodeIDSize(src) + 2 + _payload.size();
+    for (auto const& dst : _dstNodeIDs)
+    {
+        size += nodeIDSize(dst->data());
+    }
+    if (validGroup(_groupID))
+    {
+        write(size, [&](byte* _record) {
+            RecordWriter writer(_record);
+            writer.put(ShmRecordType::SendToNodes);
+            writer.putGroup(_groupID);
+            writer.putNodeID(src);
+            writer.put<uint16_t>(_dstNodeIDs.size());
+            for (auto const& dst : _dstNodeIDs)
+            {
+                writer.putNodeID(dst->data());
+            }
+            writer.putBytes(_payload.data(), _payload.size());
+        });
+    }
+}
+
+void ShmGateway::asyncSendBroadcastMessage(
+    const std::string& _groupID, bcos::crypto::NodeIDPtr _srcNodeID, bytesConstRef _payload)
+{
+    auto const& src = _srcNodeID->data();
+    auto size = 1 + groupSize(_groupID) + nodeIDSize(src) + _payload.size();
+    if (validGroup(_groupID))
+    {
+        write(size, [&](byte* _record) {
+            RecordWriter writer(_record);
+            writer.put(ShmRecordType::Broadcast);
+            writer.putGroup(_groupID);
+            writer.putNodeID(src);
+            writer.putBytes(_payload.data(), _payload.size());
+        });
+    }
+}
+
+bool ShmGateway::write(size_t _size, const std::function<void(byte*)>& _fill)
+{
+    if (m_channel->toGateway().write(_size, _fill, FULL_TIMEOUT))
+    {
+        return true;
+    }
+    m_dropped++;
+    FRONT_LOG(WARNING) << LOG_BADGE("ShmGateway") << LOG_DESC("drop the frame, ring full")
+                       << LOG_KV("size", _size) << LOG_KV("dropped", m_dropped.load());
+    return false;
+}
+
+void ShmGateway::onSendResult(uint64_t _seq, Error::Ptr _error)
+{
+    bcos::gateway::ErrorRespFunc errorRespFunc;
+    {
+        std::lock_guard<std::mutex> lock(x_pending);
+        auto it = m_pending.find(_seq);
+        if (it == m_pending.end())
+        {
+            return;
+        }
+        errorRespFunc = std::move(it->second.errorRespFunc);
+        m_pending.erase(it);
+    }
+    errorRespFunc(_error);
+}
+
+size_t ShmGateway::expireResults(uint64_t _now)
+{
+    std::vector<bcos::gateway::ErrorRespFunc> expired;
+    {
+        std::lock_guard<std::mutex> lock(x_pending);
+        while (!m_pending.empty() && m_pending.begin()->second.expireTime <= _now)
+        {
+            expired.emplace_back(std::move(m_pending.begin()->second.errorRespFunc));
+            m_pending.erase(m_pending.begin());
+        }
+    }
+    if (expired.empty())
+    {
+        return 0;
+    }
+    FRONT_LOG(WARNING) << LOG_BADGE("ShmGateway") << LOG_DESC("send results timed out")
+                       << LOG_KV("expired", expired.size());
+    auto error =
+        std::make_shared<Error>(bcos::protocol::CommonError::TIMEOUT, "shm send result timed out");
+    for (auto& errorRespFunc : expired)
+    {
+        errorRespFunc(error);
+    }
+    return expired.size();
+}
+
+size_t ShmGateway::pendingResults() const
+{
+    std::lock_guard<std::mutex> lock(x_pending);
+    return m_pending.size();
+}
+
+void ShmFrontReceiver::start()
+{
+    if (m_running.exchange(true))
+    {
+        return;
+    }
+    m_thread = std::thread([this]() {
+        while (m_running)
+        {
+            // the results the gateway dropped
+            auto now = utcSteadyTime();
+            if (now >= m_expireTime)
+            {
+                m_gateway->expireResults(now);
+                m_expireTime = now + WAIT_TIMEOUT;
+            }
+            if (poll() > 0)
+            {
+                continue;
+            }
+            if (m_channel->toFront().corrupted())
+            {
+                FRONT_LOG(ERROR) << LOG_BADGE("ShmFrontReceiver")
+                                 << LOG_DESC("the channel is corrupted, stop receiving")
+                                 << LOG_KV("channel", m_channel->name());
+                break;
+            }
+            m_channel->toFront().wait(WAIT_TIMEOUT);
+        }
+    });
+}
+
+void ShmFrontReceiver::stop()
+{
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+    m_channel->toFront().wakeUp();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+size_t ShmFrontReceiver::poll()
+{
+    auto& ring = m_channel->toFront();
+    std::string groupID;
+    std::vector<std::pair<bcos::crypto::NodeIDPtr, bytesConstRef>> frames;
+    auto dispatch = [&]() {
+        if (frames.empty())
+        {
+            return;
+        }
+        m_front->onReceiveMessages(groupID, frames, ReceiveMsgFunc());
+        m_frames += frames.size();
+        m_batches++;
+        frames.clear();
+    };
+
+    size_t count = 0;
+    bytesConstRef record;
+    while (count < MAX_BATCH && ring.peek(record))
+    {
+        ++count;
+        RecordReader reader(record);
+        uint8_t type = 0;
+        reader.get(type);
+        if (type == (uint8_t)ShmRecordType::Receive)
+        {
+            bytesConstRef group;
+            bytesConstRef node;
+            if (reader.getGroup(group) && reader.getNodeID(node))
+            {
+                if (groupID.size() != group.size() ||
+                    memcmp(groupID.data(), group.data(), group.size()) != 0)
+                {
+                    dispatch();
+                    groupID = toString(group);
+                }
+                frames.emplace_back(nodeID(node), reader.rest());
+                continue;
+            }
+        }
+        else if (type == (uint8_t)ShmRecordType::SendResult)
+        {
+            uint64_t seq = 0;
+            int32_t errorCode = 0;
+            if (reader.get(seq) && reader.get(errorCode))
+            {
+                m_gateway->onSendResult(seq, errorCode == 0 ?
+                                                 nullptr :
+                                                 std::make_shared<Error>(
+                                                     errorCode, toString(reader.rest())));
+                continue;
+            }
+        }
+        FRONT_LOG(WARNING) << LOG_BADGE("ShmFrontReceiver") << LOG_DESC("malformed record")
+                           << LOG_KV("type", (int)type) << LOG_KV("size", record.size());
+    }
+    // the frames refer to the ring, dispatched before the space is given back
+    dispatch();
+    if (count > 0)
+    {
+        ring.release();
+    }
+    return count;
+}
+
+bcos::crypto::NodeIDPtr ShmFrontReceiver::nodeID(bytesConstRef _nodeID)
+{
+    auto key = toString(_nodeID);
+    auto it = m_nodeIDs.find(key);
+    if (it != m_nodeIDs.end())
+    {
+        return it->second;
+    }
+    auto nodeID = m_nodeIDFactory(_nodeID);
+    m_nodeIDs.emplace(std::move(key), nodeID);
+    return nodeID;
+}
+
+void ShmGatewayEndpoint::start()
+{
+    if (m_running.exchange(true))
+    {
+        return;
+    }
+    m_thread = std::thread([this]() {
+        while (m_running)
+        {
+            if (poll() > 0)
+            {
+                continue;
+            }
+            if (m_channel->toGateway().corrupted())
+            {
+                FRONT_LOG(ERROR) << LOG_BADGE("ShmGatewayEndpoint")
+                                 << LOG_DESC("the channel is corrupted, stop receiving")
+                                 << LOG_KV("channel", m_channel->name());
+                break;
+            }
+            m_channel->toGateway().wait(WAIT_TIMEOUT);
+        }
+    });
+}
+
+void ShmGatewayEndpoint::stop()
+{
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+    m_channel->toGateway().wakeUp();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+size_t ShmGatewayEndpoint::poll()
+{
+    auto& ring = m_channel->toGateway();
+    auto endpointWeakPtr = std::weak_ptr<ShmGatewayEndpoint>(shared_from_this());
+    size_t count = 0;
+    bytesConstRef record;
+    while (count < MAX_BATCH && ring.peek(record))
+    {
+        ++count;
+        RecordReader reader(record);
+        uint8_t type = 0;
+        reader.get(type);
+        uint64_t seq = 0;
+        bytesConstRef group;
+        bytesConstRef src;
+        bytesConstRef dst;
+        uint16_t dstCount = 0;
+        if (type == (uint8_t)ShmRecordType::Send && reader.get(seq) && reader.getGroup(group) &&
+            reader.getNodeID(src) && reader.getNodeID(dst))
+        {
+            bcos::gateway::ErrorRespFunc errorRespFunc;
+            if (seq > 0)
+            {
+                errorRespFunc = [endpointWeakPtr, seq](Error::Ptr _error) {
+                    auto endpoint = endpointWeakPtr.lock();
+                    if (endpoint)
+                    {
+                        endpoint->sendResult(seq, _error);
+                    }
+                };
+            }
+            m_gateway->asyncSendMessageByNodeID(
+                toString(group), nodeID(src), nodeID(dst), reader.rest(), errorRespFunc);
+            continue;
+        }
+        if (type == (uint8_t)ShmRecordType::SendToNodes && reader.getGroup(group) &&
+            reader.getNodeID(src) && reader.get(dstCount))
+        {
+            bcos::crypto::NodeIDs dstNodeIDs;
+            dstNodeIDs.reserve(dstCount);
+            while (dstNodeIDs.size() < dstCount && reader.getNodeID(dst))
+            {
+                dstNodeIDs.push_back(nodeID(dst));
+            }
+            if (dstNodeIDs.size() == dstCount)
+            {
+                m_gateway->asyncSendMessageByNodeIDs(
+                    toString(group), nodeID(src), dstNodeIDs, reader.rest());
+                continue;
+            }
+        }
+        if (type == (uint8_t)ShmRecordType::Broadcast && reader.getGroup(group) &&
+            reader.getNodeID(src))
+        {
+            m_gateway->asyncSendBroadcastMessage(toString(group), nodeID(src), reader.rest());
+            continue;
+        }
+        FRONT_LOG(WARNING) << LOG_BADGE("ShmGatewayEndpoint") << LOG_DESC("malformed record")
+                           << LOG_KV("type", (int)type) << LOG_KV("size", record.size());
+    }
+    // the gateway takes the payloads before returning
+    if (count > 0)
+    {
+        ring.release();
+    }
+    return count;
+}
+
+bool ShmGatewayEndpoint::deliver(
+    const std::string& _groupID, bcos::crypto::NodeIDPtr _nodeID, bytesConstRef _frame)
+{
+    auto const& node = _nodeID->data();
+    auto size = 1 + groupSize(_groupID) + nodeIDSize(node) + _frame.size();
+    return validGroup(_groupID) &&
+           m_channel->toFront().write(
+               size,
+               [&](byte* _record) {
+                   RecordWriter writer(_record);
+                   writer.put(ShmRecordType::Receive);
+                   writer.putGroup(_groupID);
+                   writer.putNodeID(node);
+                   writer.putBytes(_frame.data(), _frame.size());
+               },
+               ShmGateway::FULL_TIMEOUT);
+}
+
+void ShmGatewayEndpoint::sendResult(uint64_t _seq, Error::Ptr _error)
+{
+    int32_t errorCode = _error ? _error->errorCode() : 0;
+    auto message = _error ? _error->errorMessage() : std::string();
+    message.resize(std::min<size_t>(message.size(), std::numeric_limits<uint16_t>::max()));
+    auto written = m_channel->toFront().write(
+        1 + 8 + 4 + message.size(),
+        [&](byte* _record) {
+            RecordWriter writer(_record);
+            writer.put(ShmRecordType::SendResult);
+            writer.put(_seq);
+            writer.put(errorCode);
+            writer.putBytes((const byte*)message.data(), message.size());
+        },
+        ShmGateway::FULL_TIMEOUT);
+    if (!written)
+    {
+        FRONT_LOG(WARNING) << LOG_BADGE("ShmGatewayEndpoint") << LOG_DESC("drop the send result")
+                           << LOG_KV("seq", _seq);
+    }
+}
+
+bcos::crypto::NodeIDPtr ShmGatewayEndpoint::nodeID(bytesConstRef _nodeID)
+{
+    auto key = toString(_nodeID);
+    auto it = m_nodeIDs.find(key);
+    if (it != m_nodeIDs.end())
+    {
+        return it->second;
+    }
+    auto nodeID = m_nodeIDFactory(_nodeID);
+    m_nodeIDs.emplace(std::move(key), nodeID);
+    return nodeID;
+}
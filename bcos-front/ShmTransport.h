@@ -0,0 +1,215 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the frames of a co-located front and gateway over the rings of a ShmChannel
+ * @file ShmTransport.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/gateway/GatewayInterface.h>
+#include <bcos-front/FrontService.h>
+#include <bcos-front/ShmRing.h>
+#include <map>
+#include <thread>
+
+namespace bcos
+{
+namespace front
+{
+/// every record starts with its type(1), integers in the byte order of the host
+enum class ShmRecordType : uint8_t
+{
+    // front to gateway: seq(8) + group + src + dst + payload, seq 0 if not waiting the result
+    Send = 1,
+    // front to gateway: group + src + count(2) + count * dst + payload
+    SendToNodes = 2,
+    // front to gateway: group + src + payload
+    Broadcast = 3,
+    // gateway to front: group + nodeID + frame
+    Receive = 4,
+    // gateway to front: seq(8) + errorCode(4) + errorMessage, errorCode 0 if sent
+    SendResult = 5,
+};
+/// group: length(1) + groupID, src/dst/nodeID: length(2) + nodeID, the payload takes the rest
+
+using ShmNodeIDFactory = std::function<bcos::crypto::NodeIDPtr(bytesConstRef)>;
+
+/**
+ * the gateway of a front whose gateway runs in another process of the host: the frames go
+ * through the ring to the gateway and are copied once into the shared memory, the other calls
+ * go through _control, e.g. the RPC client of the gateway
+ */
+class ShmGateway : public gateway::GatewayInterface
+{
+public:
+    using Ptr = std::shared_ptr<ShmGateway>;
+
+    /// the time a send waits for the gateway to drain a full ring, in milliseconds
+    constexpr static int FULL_TIMEOUT = 100;
+    /// the time the result of a send is waited for, e.g. dropped by the gateway on a full ring,
+    /// in milliseconds
+    constexpr static uint64_t RESULT_TIMEOUT = 10000;
+
+    ShmGateway(ShmChannel::Ptr _channel, gateway::GatewayInterface::Ptr _control)
+      : m_channel(_channel), m_control(_control)
+    {}
+
+    void start() override;
+    void stop() override;
+    void asyncGetPeers(std::function<void(Error::Ptr, bcos::gateway::GatewayInfo::Ptr,
+            bcos::gateway::GatewayInfosPtr)>
+            _onGetPeers) override;
+    void asyncGetNodeIDs(const std::string& _groupID, GetNodeIDsFunc _getNodeIDsFunc) override;
+    void asyncSendMessageByNodeID(const std::string& _groupID, bcos::crypto::NodeIDPtr _srcNodeID,
+        bcos::crypto::NodeIDPtr _dstNodeID, bytesConstRef _payload,
+        bcos::gateway::ErrorRespFunc _errorRespFunc) override;
+    void asyncSendMessageByNodeIDs(const std::string& _groupID,
+        bcos::crypto::NodeIDPtr _srcNodeID, const bcos::crypto::NodeIDs& _dstNodeIDs,
+        bytesConstRef _payload) override;
+    void asyncSendBroadcastMessage(const std::string& _groupID,
+        bcos::crypto::NodeIDPtr _srcNodeID, bytesConstRef _payload) override;
+    void asyncNotifyGroupInfo(bcos::group::GroupInfo::Ptr _groupInfo,
+        std::function<void(Error::Ptr&&)> _callback) override;
+    void asyncSendMessageByTopic(const std::string& _topic, bcos::bytesConstRef _data,
+        std::function<void(bcos::Error::Ptr&&, int16_t, bytesPointer)> _respFunc) override;
+    void asyncSendBroadbastMessageByTopic(
+        const std::string& _topic, bcos::bytesConstRef _data) override;
+    void asyncSubscribeTopic(std::string const& _clientID, std::string const& _topicInfo,
+        std::function<void(Error::Ptr&&)> _callback) override;
+    void asyncRemoveTopic(std::string const& _clientID, std::vector<std::string> const& _topics,
+        std::function<void(Error::Ptr&&)> _callback) override;
+
+    // the result of a send from the gateway, called by ShmFrontReceiver
+    void onSendResult(uint64_t _seq, Error::Ptr _error);
+    // fail the results waited for longer than RESULT_TIMEOUT by _now, the steady time in
+    // milliseconds; called by ShmFrontReceiver, return the results failed
+    size_t expireResults(uint64_t _now);
+    size_t pendingResults() const;
+    // the frames not written since the ring stayed full or the frame is too large
+    uint64_t droppedFrames() const { return m_dropped; }
+
+private:
+    bool write(size_t _size, const std::function<void(byte*)>& _fill);
+
+    ShmChannel::Ptr m_channel;
+    gateway::GatewayInterface::Ptr m_control;
+    struct PendingResult
+    {
+        bcos::gateway::ErrorRespFunc errorRespFunc;
+        uint64_t expireTime;
+    };
+
+    mutable std::mutex x_pending;
+    uint64_t m_seq = 0;
+    // in the order of seq and so of expireTime
+    std::map<uint64_t, PendingResult> m_pending;
+    std::atomic<uint64_t> m_dropped = {0};
+};
+
+/**
+ * drain the ring from the gateway on its own thread: the frames received are handed to the
+ * front by onReceiveMessages in batches of the consecutive frames of a group, straight from the
+ * shared memory, and the space is given back to the gateway once the batch is dispatched; the
+ * thread sleeps on the eventfd only when the ring is empty
+ */
+class ShmFrontReceiver
+{
+public:
+    using Ptr = std::shared_ptr<ShmFrontReceiver>;
+
+    /// the records of a batch at most, the ring space is held until the batch is dispatched
+    constexpr static size_t MAX_BATCH = 256;
+    constexpr static int WAIT_TIMEOUT = 100;
+
+    ShmFrontReceiver(ShmChannel::Ptr _channel, std::shared_ptr<FrontService> _front,
+        ShmGateway::Ptr _gateway, ShmNodeIDFactory _nodeIDFactory)
+      : m_channel(_channel), m_front(_front), m_gateway(_gateway), m_nodeIDFactory(_nodeIDFactory)
+    {}
+    ShmFrontReceiver(const ShmFrontReceiver&) = delete;
+    ShmFrontReceiver& operator=(const ShmFrontReceiver&) = delete;
+    ~ShmFrontReceiver() { stop(); }
+
+    void start();
+    void stop();
+    // drain one batch on the calling thread, return the records read
+    size_t poll();
+
+    uint64_t frames() const { return m_frames; }
+    uint64_t batches() const { return m_batches; }
+
+private:
+    bcos::crypto::NodeIDPtr nodeID(bytesConstRef _nodeID);
+
+    ShmChannel::Ptr m_channel;
+    std::shared_ptr<FrontService> m_front;
+    ShmGateway::Ptr m_gateway;
+    ShmNodeIDFactory m_nodeIDFactory;
+    // accessed by the receiving thread only
+    std::unordered_map<std::string, bcos::crypto::NodeIDPtr> m_nodeIDs;
+    std::atomic<bool> m_running = {false};
+    std::thread m_thread;
+    std::atomic<uint64_t> m_frames = {0};
+    std::atomic<uint64_t> m_batches = {0};
+    uint64_t m_expireTime = 0;
+};
+
+/**
+ * the gateway side of the channel: the sends of the front are handed to _gateway on the
+ * thread of the endpoint, and deliver replaces the onReceiveMessage RPC to the front
+ */
+class ShmGatewayEndpoint : public std::enable_shared_from_this<ShmGatewayEndpoint>
+{
+public:
+    using Ptr = std::shared_ptr<ShmGatewayEndpoint>;
+
+    constexpr static size_t MAX_BATCH = 256;
+    constexpr static int WAIT_TIMEOUT = 100;
+
+    ShmGatewayEndpoint(ShmChannel::Ptr _channel, gateway::GatewayInterface::Ptr _gateway,
+        ShmNodeIDFactory _nodeIDFactory)
+      : m_channel(_channel), m_gateway(_gateway), m_nodeIDFactory(_nodeIDFactory)
+    {}
+    ShmGatewayEndpoint(const ShmGatewayEndpoint&) = delete;
+    ShmGatewayEndpoint& operator=(const ShmGatewayEndpoint&) = delete;
+    ~ShmGatewayEndpoint() { stop(); }
+
+    void setGateway(gateway::GatewayInterface::Ptr _gateway) { m_gateway = _gateway; }
+
+    void start();
+    void stop();
+    // drain one batch on the calling thread, return the records read
+    size_t poll();
+
+    // hand a frame received from _nodeID to the front, false if the ring stayed full
+    bool deliver(
+        const std::string& _groupID, bcos::crypto::NodeIDPtr _nodeID, bytesConstRef _frame);
+
+private:
+    bcos::crypto::NodeIDPtr nodeID(bytesConstRef _nodeID);
+    void sendResult(uint64_t _seq, Error::Ptr _error);
+
+    ShmChannel::Ptr m_channel;
+    gateway::GatewayInterface::Ptr m_gateway;
+    ShmNodeIDFactory m_nodeIDFactory;
+    // accessed by the endpoint thread only
+    std::unordered_map<std::string, bcos::crypto::NodeIDPtr> m_nodeIDs;
+    std::atomic<bool> m_running = {false};
+    std::thread m_thread;
+};
+}  // namespace front
+}  // namespace bcos
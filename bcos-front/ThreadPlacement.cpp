@@ -0,0 +1,223 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief pin the front threads to cpu sets and keep their allocations on the local NUMA node
+ * @file ThreadPlacement.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-framework/libutilities/Exceptions.h>
+#include <bcos-front/Common.h>
+#include <bcos-front/ThreadPlacement.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <set>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace bcos;
+using namespace bcos::front;
+
+namespace
+{
+#ifdef __linux__
+// from linux/mempolicy.h, not every libc ships it and libnuma is not a dependency
+constexpr int MPOL_PREFERRED_MODE = 1;
+constexpr uint32_t MAX_NUMA_NODES = 1024;
+#endif
+}  // namespace
+
+CpuSet bcos::front::parseCpuList(const std::string& _cpuList)
+{
+    std::set<uint32_t> cpus;
+    std::vector<std::string> ranges;
+    boost::split(ranges, boost::trim_copy(_cpuList), boost::is_any_of(","));
+    for (auto const& range : ranges)
+    {
+        if (range.empty())
+        {
+            continue;
+        }
+        try
+        {
+            auto separator = range.find('-');
+            auto first = (uint32_t)std::stoul(range.substr(0, separator));
+            auto last = separator == std::string::npos ?
+                            first :
+                            (uint32_t)std::stoul(range.substr(separator + 1));
+            for (auto cpu = first; cpu <= last; ++cpu)
+            {
+                cpus.insert(cpu);
+            }
+        }
+        catch (std::exception const&)
+        {
+            BOOST_THROW_EXCEPTION(
+                InvalidParameter() << errinfo_comment("invalid cpu list: " + _cpuList));
+        }
+    }
+    return CpuSet(cpus.begin(), cpus.end());
+}
+
+CpuSet bcos::front::numaNodeCpus(uint32_t _node)
+{
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(_node) + "/cpulist");
+    std::string cpuList;
+    if (!file || !std::getline(file, cpuList))
+    {
+        return CpuSet();
+    }
+    return parseCpuList(cpuList);
+}
+
+int bcos::front::numaNodeOfCpu(uint32_t _cpu)
+{
+#ifdef __linux__
+    for (uint32_t node = 0; node < MAX_NUMA_NODES; ++node)
+    {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file)
+        {
+            // the nodes are numbered without holes on the machines we deploy to
+            return -1;
+        }
+        std::string cpuList;
+        std::getline(file, cpuList);
+        auto cpus = parseCpuList(cpuList);
+        if (std::binary_search(cpus.begin(), cpus.end(), _cpu))
+        {
+            return node;
+        }
+    }
+#endif
+    return -1;
+}
+
+bool bcos::front::pinCurrentThread(const CpuSet& _cpus)
+{
+#ifdef __linux__
+    if (_cpus.empty())
+    {
+        return false;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto cpu : _cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+    auto ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    if (ret != 0)
+    {
+        FRONT_LOG(WARNING) << LOG_BADGE("placement") << LOG_DESC("pthread_setaffinity_np failed")
+                           << LOG_KV("error", ret) << LOG_KV("firstCpu", _cpus.front());
+        return false;
+    }
+    return true;
+#else
+    FRONT_LOG(WARNING) << LOG_BADGE("placement") << LOG_DESC("cpu pinning is not supported");
+    return false;
+#endif
+}
+
+bool bcos::front::preferLocalMemory(const CpuSet& _cpus)
+{
+#ifdef __linux__
+    if (_cpus.empty())
+    {
+        return false;
+    }
+    auto node = numaNodeOfCpu(_cpus.front());
+    if (node < 0)
+    {
+        // no NUMA topology exposed, nothing to prefer
+        return false;
+    }
+    std::vector<unsigned long> nodeMask(MAX_NUMA_NODES / (8 * sizeof(unsigned long)), 0);
+    nodeMask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, nodeMask.data(), MAX_NUMA_NODES) != 0)
+    {
+        FRONT_LOG(WARNING) << LOG_BADGE("placement") << LOG_DESC("set_mempolicy failed")
+                           << LOG_KV("node", node) << LOG_KV("errno", errno);
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool bcos::front::placeCurrentThread(const CpuSet& _cpus, bool _numaLocalMemory)
+{
+    auto pinned = pinCurrentThread(_cpus);
+    if (pinned && _numaLocalMemory)
+    {
+        preferLocalMemory(_cpus);
+    }
+    return pinned;
+}
+
+size_t bcos::front::placeThreadPool(bcos::ThreadPool::Ptr _threadPool, size_t _threads,
+    const CpuSet& _cpus, bool _numaLocalMemory, uint64_t _timeout)
+{
+    if (!_threadPool || _threads == 0 || _cpus.empty())
+    {
+        return 0;
+    }
+    struct Barrier
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t arrived = 0;
+        size_t placed = 0;
+        bool released = false;
+    };
+    auto barrier = std::make_shared<Barrier>();
+    for (size_t i = 0; i < _threads; ++i)
+    {
+        _threadPool->enqueue([barrier, _threads, _cpus, _numaLocalMemory]() {
+            auto placed = placeCurrentThread(_cpus, _numaLocalMemory);
+            std::unique_lock<std::mutex> lock(barrier->mutex);
+            barrier->arrived++;
+            barrier->placed += placed;
+            barrier->cv.notify_all();
+            // hold the worker until every task is taken by another worker
+            barrier->cv.wait(
+                lock, [&]() { return barrier->released || barrier->arrived == _threads; });
+        });
+    }
+    std::unique_lock<std::mutex> lock(barrier->mutex);
+    barrier->cv.wait_for(lock, std::chrono::milliseconds(_timeout),
+        [&]() { return barrier->arrived == _threads; });
+    // the pool has fewer workers than _threads, let the waiting ones go
+    barrier->released = true;
+    barrier->cv.notify_all();
+    FRONT_LOG(INFO) << LOG_BADGE("placement") << LOG_DESC("placeThreadPool")
+                    << LOG_KV("threads", _threads) << LOG_KV("placed", barrier->placed)
+                    << LOG_KV("cpus", _cpus.size());
+    return barrier->placed;
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief pin the front threads to cpu sets and keep their allocations on the local NUMA node
+ * @file ThreadPlacement.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/ThreadPool.h>
+#include <string>
+#include <vector>
+
+namespace bcos
+{
+namespace front
+{
+using CpuSet = std::vector<uint32_t>;
+
+struct ThreadPlacementPolicy
+{
+    // cpus of the io thread driving the timers, empty leaves the thread unpinned
+    CpuSet ioCpus;
+    // cpus of the dispatch workers, empty leaves the workers unpinned
+    CpuSet workerCpus;
+    // number of dispatch workers the factory creates when no thread pool is set, 0 for one
+    // worker per cpu of workerCpus
+    size_t workerThreads = 0;
+    // prefer the NUMA node of the pinned cpus for the allocations of the pinned threads
+    bool numaLocalMemory = true;
+
+    bool empty() const { return ioCpus.empty() && workerCpus.empty(); }
+};
+
+// parse a cpu list in the format of /sys/devices/system/cpu/online, e.g. "0-3,8,10-11"
+CpuSet parseCpuList(const std::string& _cpuList);
+// the cpus of a NUMA node, empty if the node does not exist
+CpuSet numaNodeCpus(uint32_t _node);
+// the NUMA node of a cpu, -1 if unknown
+int numaNodeOfCpu(uint32_t _cpu);
+
+// pin the calling thread to _cpus, false if not supported or rejected by the kernel
+bool pinCurrentThread(const CpuSet& _cpus);
+// prefer the NUMA node of _cpus for the allocations of the calling thread, the first touch of
+// the buffers the thread allocates then lands on the node it runs on
+bool preferLocalMemory(const CpuSet& _cpus);
+// apply both to the calling thread according to _numaLocalMemory
+bool placeCurrentThread(const CpuSet& _cpus, bool _numaLocalMemory);
+
+/**
+ * @brief: pin _threads workers of _threadPool, every worker takes one placement task and waits
+ * for the others so that no worker takes two of them
+ * @return the number of workers placed, less than _threads if the pool has fewer idle workers
+ * within _timeout milliseconds
+ */
+size_t placeThreadPool(bcos::ThreadPool::Ptr _threadPool, size_t _threads, const CpuSet& _cpus,
+    bool _numaLocalMemory, uint64_t _timeout = 1000);
+}  // namespace front
+}  // namespace bcos
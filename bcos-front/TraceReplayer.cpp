@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief feed a captured trace back into a front service
+ * @file TraceReplayer.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/Common.h>
+#include <bcos-front/TraceReplayer.h>
+#include <algorithm>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::front;
+
+bcos::crypto::NodeIDPtr TraceReplayer::nodeID(bytesConstRef _nodeID)
+{
+    std::string key((const char*)_nodeID.data(), _nodeID.size());
+    auto it = m_nodeIDs.find(key);
+    if (it != m_nodeIDs.end())
+    {
+        return it->second;
+    }
+    auto nodeID = m_nodeIDFactory(_nodeID);
+    m_nodeIDs.emplace(std::move(key), nodeID);
+    return nodeID;
+}
+
+TraceReplayer::Result TraceReplayer::replay(
+    FrontServiceInterface::Ptr _frontService, const std::string& _groupID, double _speed)
+{
+    Result result;
+    auto const& frames = m_trace->frames();
+    if (frames.empty())
+    {
+        return result;
+    }
+    // the frames are sorted by arrival time
+    auto firstArrival = frames.front().arrivalTime;
+    result.traceSpan = (frames.back().arrivalTime - firstArrival) / 1000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto const& frame : frames)
+    {
+        if (_speed > 0)
+        {
+            // clamped, a corrupted arrival time must neither wrap nor overflow the offset
+            double delta =
+                frame.arrivalTime > firstArrival ? frame.arrivalTime - firstArrival : 0;
+            auto offset = std::chrono::nanoseconds((int64_t)std::min(
+                delta / _speed, (double)(std::chrono::nanoseconds::max().count() / 2)));
+            std::this_thread::sleep_until(start + offset);
+        }
+        _frontService->onReceiveMessage(
+            _groupID, nodeID(frame.nodeID), frame.frame, ReceiveMsgFunc());
+        result.frames++;
+    }
+    result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start)
+                         .count();
+
+    FRONT_LOG(INFO) << LOG_DESC("TraceReplayer replay") << LOG_KV("frames", result.frames)
+                    << LOG_KV("speed", _speed) << LOG_KV("elapsed(us)", result.elapsed)
+                    << LOG_KV("traceSpan(us)", result.traceSpan);
+    return result;
+}
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief feed a captured trace back into a front service
+ * @file TraceReplayer.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/front/FrontServiceInterface.h>
+#include <bcos-front/FrameCapture.h>
+
+namespace bcos
+{
+namespace front
+{
+class TraceReplayer
+{
+public:
+    using Ptr = std::shared_ptr<TraceReplayer>;
+    // rebuild the nodeID from the captured key data
+    using NodeIDFactory = std::function<bcos::crypto::NodeIDPtr(bytesConstRef _nodeID)>;
+
+    struct Result
+    {
+        uint64_t frames = 0;
+        // wall clock time of the replay, in microseconds
+        uint64_t elapsed = 0;
+        // time span of the trace, in microseconds
+        uint64_t traceSpan = 0;
+    };
+
+    TraceReplayer(FrameTrace::Ptr _trace, NodeIDFactory _nodeIDFactory)
+      : m_trace(_trace), m_nodeIDFactory(_nodeIDFactory)
+    {}
+
+    /**
+     * @brief: replay the trace into _frontService through onReceiveMessage
+     * @param _speed: 1 replays at the recorded speed, N at N times the recorded speed,
+     * 0 as fast as possible
+     */
+    Result replay(
+        FrontServiceInterface::Ptr _frontService, const std::string& _groupID, double _speed);
+
+private:
+    bcos::crypto::NodeIDPtr nodeID(bytesConstRef _nodeID);
+
+    FrameTrace::Ptr m_trace;
+    NodeIDFactory m_nodeIDFactory;
+    // avoid rebuilding the same nodeID for every frame
+    std::unordered_map<std::string, bcos::crypto::NodeIDPtr> m_nodeIDs;
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,255 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief work stealing executor owned by the front, a deque per worker
+ * @file WorkStealingExecutor.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/Common.h>
+#include <bcos-front/WorkStealingExecutor.h>
+#include <boost/exception/diagnostic_information.hpp>
+
+using namespace bcos;
+using namespace bcos::front;
+
+namespace
+{
+struct CurrentWorker
+{
+    const WorkStealingExecutor* executor = nullptr;
+    size_t index = 0;
+};
+thread_local CurrentWorker t_currentWorker;
+}  // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(
+    size_t _workerThreads, const CpuSet& _cpus, bool _numaLocalMemory)
+{
+    _workerThreads = std::max<size_t>(1, _workerThreads);
+    for (size_t i = 0; i < _workerThreads; ++i)
+    {
+        m_workers.emplace_back(std::make_unique<Worker>());
+    }
+    // all the deques exist before any worker steals
+    for (size_t i = 0; i < _workerThreads; ++i)
+    {
+        m_workers[i]->thread = std::thread([this, i, _cpus, _numaLocalMemory]() {
+            if (!_cpus.empty())
+            {
+                placeCurrentThread(_cpus, _numaLocalMemory);
+            }
+            run(i);
+        });
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    stop();
+    auto self = currentWorker();
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        auto& thread = m_workers[i]->thread;
+        if (!thread.joinable())
+        {
+            continue;
+        }
+        // destroyed by the last reference released by one of its tasks, the worker returns
+        // without touching the executor once it sees its mark cleared
+        if ((int64_t)i == self)
+        {
+            t_currentWorker = CurrentWorker();
+            thread.detach();
+            continue;
+        }
+        thread.join();
+    }
+}
+
+int64_t WorkStealingExecutor::currentWorker() const
+{
+    return t_currentWorker.executor == this ? (int64_t)t_currentWorker.index : -1;
+}
+
+void WorkStealingExecutor::enqueue(Task _task)
+{
+    auto worker = currentWorker();
+    // the tasks of a worker stay on its deque, the others are spread
+    push(worker >= 0 ? worker : m_nextWorker.fetch_add(1, std::memory_order_relaxed) %
+                                    m_workers.size(),
+        std::move(_task));
+}
+
+void WorkStealingExecutor::enqueueContinuation(Task _task)
+{
+    auto index = currentWorker();
+    if (index < 0)
+    {
+        enqueue(std::move(_task));
+        return;
+    }
+    auto& worker = *m_workers[index];
+    if (worker.lifoSlot)
+    {
+        push(index, std::move(worker.lifoSlot));
+    }
+    worker.lifoSlot = std::move(_task);
+}
+
+void WorkStealingExecutor::push(size_t _worker, Task _task)
+{
+    {
+        auto& worker = *m_workers[_worker];
+        Guard l(worker.x_tasks);
+        worker.tasks.emplace_back(std::move(_task));
+    }
+    m_pending.fetch_add(1);
+    wakeUp();
+}
+
+void WorkStealingExecutor::wakeUp()
+{
+    // pairs with the increment of m_sleepers before checking m_pending in run()
+    if (m_sleepers.load() > 0)
+    {
+        Guard l(x_sleep);
+        m_wakeUp.notify_one();
+    }
+}
+
+bool WorkStealingExecutor::next(size_t _worker, Task& _task)
+{
+    auto& worker = *m_workers[_worker];
+    if (worker.lifoSlot)
+    {
+        if (worker.lifoRuns < MAX_LIFO_RUNS)
+        {
+            worker.lifoRuns++;
+            _task = std::move(worker.lifoSlot);
+            worker.lifoSlot = nullptr;
+            m_continued.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        // let the deque have a turn
+        push(_worker, std::move(worker.lifoSlot));
+        worker.lifoSlot = nullptr;
+    }
+    worker.lifoRuns = 0;
+    {
+        Guard l(worker.x_tasks);
+        if (!worker.tasks.empty())
+        {
+            _task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+            m_pending.fetch_sub(1);
+            return true;
+        }
+    }
+    return steal(_worker, _task);
+}
+
+bool WorkStealingExecutor::steal(size_t _thief, Task& _task)
+{
+    if (m_pending.load() <= 0)
+    {
+        return false;
+    }
+    for (size_t i = 1; i < m_workers.size(); ++i)
+    {
+        auto& victim = *m_workers[(_thief + i) % m_workers.size()];
+        Guard l(victim.x_tasks);
+        if (!victim.tasks.empty())
+        {
+            _task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            m_pending.fetch_sub(1);
+            m_stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingExecutor::run(size_t _worker)
+{
+    t_currentWorker = CurrentWorker{this, _worker};
+    Task task;
+    while (m_running.load(std::memory_order_acquire))
+    {
+        if (next(_worker, task))
+        {
+            try
+            {
+                task();
+            }
+            catch (const std::exception& e)
+            {
+                FRONT_LOG(WARNING) << LOG_BADGE("WorkStealingExecutor") << LOG_DESC("task error")
+                                   << LOG_KV("error", boost::diagnostic_information(e));
+            }
+            task = nullptr;
+            // the executor has been destroyed by the task
+            if (t_currentWorker.executor != this)
+            {
+                return;
+            }
+            m_executed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        UniqueGuard l(x_sleep);
+        m_sleepers.fetch_add(1);
+        m_wakeUp.wait(l, [this]() {
+            return m_pending.load() > 0 || !m_running.load(std::memory_order_acquire);
+        });
+        m_sleepers.fetch_sub(1);
+    }
+    t_currentWorker = CurrentWorker();
+}
+
+void WorkStealingExecutor::stop()
+{
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+    {
+        Guard l(x_sleep);
+        m_wakeUp.notify_all();
+    }
+    auto self = currentWorker();
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        auto& thread = m_workers[i]->thread;
+        if (!thread.joinable())
+        {
+            continue;
+        }
+        // stopped by one of its tasks, joined by the destructor
+        if ((int64_t)i == self)
+        {
+            continue;
+        }
+        thread.join();
+    }
+    for (auto& worker : m_workers)
+    {
+        Guard l(worker->x_tasks);
+        m_pending.fetch_sub(worker->tasks.size());
+        worker->tasks.clear();
+    }
+}
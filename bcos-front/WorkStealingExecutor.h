@@ -0,0 +1,113 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief work stealing executor owned by the front, a deque per worker
+ * @file WorkStealingExecutor.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/FrontExecutor.h>
+#include <bcos-front/ThreadPlacement.h>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace bcos
+{
+namespace front
+{
+/**
+ * each worker runs the tasks of its own deque, the tasks enqueued by the other threads are spread
+ * over the deques round robin, those enqueued by a worker stay on its deque; an idle worker
+ * steals the oldest task of the others before sleeping, so that the workers only contend on the
+ * same lock when one of them runs dry.
+ * a continuation enqueued by a worker takes its LIFO slot and runs right after the current task,
+ * the task it replaces goes to the back of the deque; the slot is not stolen. Only the tasks of
+ * the workers have a slot: the responses received on the gateway and timer threads continue as
+ * plain tasks, the slot serves the responses completed on a worker, e.g. delivered by an
+ * in-process transport to a request sent by a dispatch task
+ */
+class WorkStealingExecutor : public FrontExecutor
+{
+public:
+    using Ptr = std::shared_ptr<WorkStealingExecutor>;
+
+    // continuations run back to back from the LIFO slot before the deque gets a turn
+    constexpr static size_t MAX_LIFO_RUNS = 3;
+
+    /**
+     * @param _cpus: pin the workers to these cpus if not empty
+     * @param _numaLocalMemory: allocate the memory of the workers on the node of _cpus
+     */
+    explicit WorkStealingExecutor(size_t _workerThreads, const CpuSet& _cpus = CpuSet(),
+        bool _numaLocalMemory = false);
+    ~WorkStealingExecutor() override;
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    void enqueue(Task _task) override;
+    void enqueueContinuation(Task _task) override;
+    /**
+     * @brief: drop the queued tasks and join the workers, the running tasks are finished. Called
+     * by a task, the worker running it is joined by the destructor instead
+     */
+    void stop() override;
+
+    size_t workerThreads() const { return m_workers.size(); }
+    // the worker index of the calling thread, -1 if not one of the workers
+    int64_t currentWorker() const;
+
+    uint64_t executed() const { return m_executed.load(std::memory_order_relaxed); }
+    uint64_t stolen() const { return m_stolen.load(std::memory_order_relaxed); }
+    // tasks run from the LIFO slot
+    uint64_t continued() const { return m_continued.load(std::memory_order_relaxed); }
+
+private:
+    struct Worker
+    {
+        bcos::Mutex x_tasks;
+        std::deque<Task> tasks;
+        // touched by the worker thread only
+        Task lifoSlot;
+        size_t lifoRuns = 0;
+        std::thread thread;
+    };
+
+    void push(size_t _worker, Task _task);
+    void run(size_t _worker);
+    bool next(size_t _worker, Task& _task);
+    bool steal(size_t _thief, Task& _task);
+    void wakeUp();
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<bool> m_running = {true};
+    std::atomic<size_t> m_nextWorker = {0};
+    // tasks in the deques, the LIFO slots excluded
+    std::atomic<int64_t> m_pending = {0};
+    std::atomic<size_t> m_sleepers = {0};
+    bcos::Mutex x_sleep;
+    std::condition_variable m_wakeUp;
+
+    std::atomic<uint64_t> m_executed = {0};
+    std::atomic<uint64_t> m_stolen = {0};
+    std::atomic<uint64_t> m_continued = {0};
+};
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,140 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief compare the dispatch throughput and latency of bcos::ThreadPool and the work stealing
+ * executor under fan-in
+ * @file front-executor-bench.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/WorkStealingExecutor.h>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::front;
+
+namespace
+{
+uint64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct Result
+{
+    double tasksPerSecond;
+    uint64_t p50;
+    uint64_t p99;
+};
+
+/**
+ * _producers threads enqueue _tasks tiny tasks each, as the gateway threads do with the received
+ * messages; every _continuationEvery task enqueues a continuation as a response callback would
+ */
+Result run(FrontExecutor& _executor, size_t _producers, size_t _tasks, size_t _continuationEvery)
+{
+    auto total = _producers * _tasks;
+    auto expected = total + (total + _continuationEvery - 1) / _continuationEvery;
+    // enqueue to run latency in ns, one slot per task
+    std::vector<uint64_t> latencies(expected, 0);
+    std::atomic<size_t> executed(0);
+    std::atomic<size_t> recorded(0);
+    std::promise<void> done;
+    auto finish = [&]() {
+        if (++executed == expected)
+        {
+            done.set_value();
+        }
+    };
+
+    auto start = nowNs();
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < _producers; ++p)
+    {
+        producers.emplace_back([&, p]() {
+            for (size_t i = 0; i < _tasks; ++i)
+            {
+                auto enqueueTime = nowNs();
+                bool continued = ((p * _tasks + i) % _continuationEvery) == 0;
+                _executor.enqueue([&, enqueueTime, continued]() {
+                    latencies[recorded++] = nowNs() - enqueueTime;
+                    if (continued)
+                    {
+                        auto continueTime = nowNs();
+                        _executor.enqueueContinuation([&, continueTime]() {
+                            latencies[recorded++] = nowNs() - continueTime;
+                            finish();
+                        });
+                    }
+                    finish();
+                });
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    done.get_future().get();
+    auto elapsed = nowNs() - start;
+
+    latencies.resize(recorded);
+    std::sort(latencies.begin(), latencies.end());
+    return Result{expected * 1e9 / elapsed, latencies[latencies.size() / 2],
+        latencies[latencies.size() * 99 / 100]};
+}
+}  // namespace
+
+int main(int argc, const char* argv[])
+{
+    size_t tasks = argc > 1 ? std::stoul(argv[1]) : 200000;
+    size_t producers = argc > 2 ? std::stoul(argv[2]) : 4;
+    size_t maxThreads = std::max(2u, std::thread::hardware_concurrency());
+
+    std::cout << producers << " producers, " << tasks << " tasks each, a continuation every 8"
+              << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(14) << "executor" << std::setw(14)
+              << "tasks/s" << std::setw(12) << "p50(ns)" << std::setw(12) << "p99(ns)"
+              << std::setw(10) << "stolen" << std::endl;
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        auto print = [threads](const std::string& _name, const Result& _result, uint64_t _stolen) {
+            std::cout << std::setw(8) << threads << std::setw(14) << _name << std::setw(14)
+                      << std::fixed << std::setprecision(0) << _result.tasksPerSecond
+                      << std::setw(12) << _result.p50 << std::setw(12) << _result.p99
+                      << std::setw(10) << _stolen << std::endl;
+        };
+        {
+            ThreadPoolExecutor executor(std::make_shared<ThreadPool>("bench", threads));
+            print("ThreadPool", run(executor, producers, tasks, 8), 0);
+            executor.stop();
+        }
+        {
+            WorkStealingExecutor executor(threads);
+            auto result = run(executor, producers, tasks, 8);
+            print("WorkStealing", result, executor.stolen());
+            executor.stop();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief compare the FrontMessage decoder with the in-place FrontMessageView
+ * @file front-message-bench.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/FrontMessage.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace bcos;
+using namespace bcos::front;
+
+template <typename F>
+double nanosecondsPerOp(size_t _rounds, F _f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < _rounds; ++i)
+    {
+        _f();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / _rounds;
+}
+
+int main(int argc, const char* argv[])
+{
+    size_t rounds = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    auto factory = std::make_shared<FrontMessageFactory>();
+    std::string uuid = "f0e1d2c3-b4a5-9687-7869-5a4b3c2d1e0f";
+
+    std::cout << std::setw(12) << "payload" << std::setw(20) << "FrontMessage(ns)" << std::setw(24)
+              << "FrontMessageView(ns)" << std::endl;
+    for (size_t payloadSize : {0, 64, 1024, 64 * 1024})
+    {
+        bytes payload(payloadSize, 'x');
+        auto message = factory->buildMessage();
+        message->setModuleID(1000);
+        message->setUuid(std::make_shared<bytes>(uuid.begin(), uuid.end()));
+        message->setPayload(bytesConstRef(payload.data(), payload.size()));
+        bytes buffer;
+        message->encode(buffer);
+        auto frame = bytesConstRef(buffer.data(), buffer.size());
+
+        // the decoding of the receive path before FrontMessageView
+        uint64_t checksum = 0;
+        auto decodeCost = nanosecondsPerOp(rounds, [&]() {
+            auto decoded = factory->buildMessage();
+            decoded->decode(frame);
+            checksum += decoded->moduleID() + decoded->payload().size() + decoded->uuid()->size();
+        });
+        auto viewCost = nanosecondsPerOp(rounds, [&]() {
+            FrontMessageView view;
+            view.decode(frame);
+            checksum += view.moduleID() + view.payload().size() + view.uuid().size();
+        });
+        std::cout << std::setw(12) << payloadSize << std::setw(20) << std::fixed
+                  << std::setprecision(2) << decodeCost << std::setw(24) << viewCost
+                  << "  (checksum " << checksum << ")" << std::endl;
+    }
+    return 0;
+}
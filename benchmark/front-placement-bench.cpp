@@ -0,0 +1,166 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief request throughput of a looped back front service with and without thread placement
+ * @file front-placement-bench.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/interfaces/gateway/GatewayInterface.h>
+#include <bcos-front/FrontServiceFactory.h>
+#include <bcos-front/ThreadPlacement.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::front;
+
+// deliver every frame back to the front service it came from
+class LoopbackGateway : public gateway::GatewayInterface
+{
+public:
+    void setFrontService(FrontServiceInterface::Ptr _frontService)
+    {
+        m_frontService = _frontService;
+    }
+    void start() override {}
+    void stop() override { m_frontService.reset(); }
+    void asyncGetPeers(std::function<void(
+            Error::Ptr, bcos::gateway::GatewayInfo::Ptr, bcos::gateway::GatewayInfosPtr)>) override
+    {}
+    void asyncGetNodeIDs(const std::string&, GetNodeIDsFunc) override {}
+    void asyncSendMessageByNodeID(const std::string& _groupID,
+        bcos::crypto::NodeIDPtr _srcNodeID, bcos::crypto::NodeIDPtr, bytesConstRef _payload,
+        bcos::gateway::ErrorRespFunc _errorRespFunc) override
+    {
+        if (_errorRespFunc)
+        {
+            _errorRespFunc(nullptr);
+        }
+        m_frontService->onReceiveMessage(_groupID, _srcNodeID, _payload, ReceiveMsgFunc());
+    }
+    void asyncSendMessageByNodeIDs(const std::string&, bcos::crypto::NodeIDPtr,
+        const bcos::crypto::NodeIDs&, bytesConstRef) override
+    {}
+    void asyncSendBroadcastMessage(
+        const std::string&, bcos::crypto::NodeIDPtr, bytesConstRef) override
+    {}
+    void asyncNotifyGroupInfo(
+        bcos::group::GroupInfo::Ptr, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncSendMessageByTopic(const std::string&, bcos::bytesConstRef,
+        std::function<void(bcos::Error::Ptr&&, int16_t, bytesPointer)>) override
+    {}
+    void asyncSendBroadbastMessageByTopic(const std::string&, bcos::bytesConstRef) override {}
+    void asyncSubscribeTopic(
+        std::string const&, std::string const&, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncRemoveTopic(std::string const&, std::vector<std::string> const&,
+        std::function<void(Error::Ptr&&)>) override
+    {}
+
+private:
+    FrontServiceInterface::Ptr m_frontService;
+};
+
+// requests per second of _rounds request/response pairs of _payloadSize bytes
+double requestsPerSecond(
+    const ThreadPlacementPolicy& _placement, size_t _workers, size_t _rounds, size_t _payloadSize)
+{
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto nodeID = keyFactory->createKey(bytesConstRef((const byte*)"bench", 5));
+    auto gateway = std::make_shared<LoopbackGateway>();
+    auto factory = std::make_shared<FrontServiceFactory>();
+    factory->setGatewayInterface(gateway);
+    if (_placement.empty())
+    {
+        factory->setThreadPool(std::make_shared<ThreadPool>("bench", _workers));
+    }
+    factory->setThreadPlacement(_placement);
+    auto frontService = factory->buildFrontService("bench", nodeID);
+    gateway->setFrontService(frontService);
+    frontService->start();
+
+    int moduleID = 1000;
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [frontService, moduleID](
+            bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid, bytesConstRef _data) {
+            // touch the payload the way a decoding module would
+            bytes copied(_data.begin(), _data.end());
+            frontService->asyncSendResponse(_uuid, moduleID, _nodeID,
+                bytesConstRef(copied.data(), std::min<size_t>(copied.size(), 64)), nullptr);
+        });
+
+    bytes payload(_payloadSize, 'p');
+    std::atomic<size_t> finished(0);
+    // bound the requests in flight so that the callbacks table stays small
+    size_t const window = 4096;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < _rounds; ++i)
+    {
+        while (i - finished >= window)
+        {
+            std::this_thread::yield();
+        }
+        frontService->asyncSendMessageByNodeID(moduleID, nodeID,
+            bytesConstRef(payload.data(), payload.size()), 10000,
+            [&finished](Error::Ptr, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) { finished++; });
+    }
+    while (finished < _rounds)
+    {
+        std::this_thread::yield();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    frontService->stop();
+    gateway->stop();
+    return _rounds / elapsed.count();
+}
+
+int main(int argc, const char* argv[])
+{
+    size_t rounds = argc > 1 ? std::stoul(argv[1]) : 200000;
+    size_t workers = argc > 2 ? std::stoul(argv[2]) : 4;
+    uint32_t node = argc > 3 ? std::stoul(argv[3]) : 0;
+
+    // the io thread takes the first cpu of the node, the workers the following ones
+    auto cpus = numaNodeCpus(node);
+    if (cpus.empty())
+    {
+        cpus = parseCpuList("0-" + std::to_string(std::thread::hardware_concurrency() - 1));
+    }
+    ThreadPlacementPolicy placement;
+    placement.ioCpus = {cpus.front()};
+    placement.workerCpus.assign(
+        cpus.begin() + (cpus.size() > 1), cpus.begin() + std::min(cpus.size(), workers + 1));
+    placement.workerThreads = workers;
+
+    std::cout << "node " << node << ", cpus " << cpus.size() << ", workers " << workers
+              << ", rounds " << rounds << std::endl;
+    std::cout << std::setw(12) << "payload" << std::setw(16) << "unpinned(rps)" << std::setw(16)
+              << "pinned(rps)" << std::endl;
+    for (size_t payloadSize : {64, 4096, 64 * 1024})
+    {
+        auto unpinned = requestsPerSecond(ThreadPlacementPolicy(), workers, rounds, payloadSize);
+        auto pinned = requestsPerSecond(placement, workers, rounds, payloadSize);
+        std::cout << std::setw(12) << payloadSize << std::setw(16) << std::fixed
+                  << std::setprecision(0) << unpinned << std::setw(16) << pinned << std::endl;
+    }
+    return 0;
+}
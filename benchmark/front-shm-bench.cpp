@@ -0,0 +1,435 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief round trips of a front and a gateway process in process, over shm and over a socket
+ * @file front-shm-bench.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-front/FrontServiceFactory.h>
+#include <bcos-front/ShmTransport.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <unistd.h>
+
+using namespace bcos;
+using namespace bcos::front;
+
+namespace
+{
+const std::string g_groupID = "bench";
+const int g_moduleID = 1000;
+
+bcos::crypto::NodeIDPtr createKey(bytesConstRef _nodeID)
+{
+    static auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    return keyFactory->createKey(_nodeID);
+}
+
+uint64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// the gateway methods the benchmark does not use
+class BenchGateway : public gateway::GatewayInterface
+{
+public:
+    void start() override {}
+    void stop() override {}
+    void asyncGetPeers(std::function<void(
+            Error::Ptr, bcos::gateway::GatewayInfo::Ptr, bcos::gateway::GatewayInfosPtr)>) override
+    {}
+    void asyncGetNodeIDs(const std::string&, GetNodeIDsFunc) override {}
+    void asyncSendMessageByNodeIDs(const std::string&, bcos::crypto::NodeIDPtr,
+        const bcos::crypto::NodeIDs&, bytesConstRef) override
+    {}
+    void asyncSendBroadcastMessage(
+        const std::string&, bcos::crypto::NodeIDPtr, bytesConstRef) override
+    {}
+    void asyncNotifyGroupInfo(
+        bcos::group::GroupInfo::Ptr, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncSendMessageByTopic(const std::string&, bcos::bytesConstRef,
+        std::function<void(bcos::Error::Ptr&&, int16_t, bytesPointer)>) override
+    {}
+    void asyncSendBroadbastMessageByTopic(const std::string&, bcos::bytesConstRef) override {}
+    void asyncSubscribeTopic(
+        std::string const&, std::string const&, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncRemoveTopic(std::string const&, std::vector<std::string> const&,
+        std::function<void(Error::Ptr&&)>) override
+    {}
+};
+
+// in process: the frame is handed back to the front, as received from its destination
+class InProcessGateway : public BenchGateway
+{
+public:
+    void setFront(std::weak_ptr<FrontService> _front) { m_front = _front; }
+    void asyncSendMessageByNodeID(const std::string& _groupID, bcos::crypto::NodeIDPtr,
+        bcos::crypto::NodeIDPtr _dstNodeID, bytesConstRef _payload,
+        bcos::gateway::ErrorRespFunc _errorRespFunc) override
+    {
+        m_front.lock()->onReceiveMessage(_groupID, _dstNodeID, _payload, ReceiveMsgFunc());
+        if (_errorRespFunc)
+        {
+            _errorRespFunc(nullptr);
+        }
+    }
+
+private:
+    std::weak_ptr<FrontService> m_front;
+};
+
+// the gateway process of the shm channel, the frames go back to the front
+class ShmStandInGateway : public BenchGateway
+{
+public:
+    void setEndpoint(ShmGatewayEndpoint::Ptr _endpoint) { m_endpoint = _endpoint; }
+    void asyncSendMessageByNodeID(const std::string& _groupID, bcos::crypto::NodeIDPtr,
+        bcos::crypto::NodeIDPtr _dstNodeID, bytesConstRef _payload,
+        bcos::gateway::ErrorRespFunc _errorRespFunc) override
+    {
+        m_endpoint.lock()->deliver(_groupID, _dstNodeID, _payload);
+        if (_errorRespFunc)
+        {
+            _errorRespFunc(nullptr);
+        }
+    }
+
+private:
+    std::weak_ptr<ShmGatewayEndpoint> m_endpoint;
+};
+
+bool readFully(int _fd, byte* _data, size_t _size)
+{
+    while (_size > 0)
+    {
+        auto n = ::read(_fd, _data, _size);
+        if (n <= 0)
+        {
+            return false;
+        }
+        _data += n;
+        _size -= n;
+    }
+    return true;
+}
+
+bool writeFully(int _fd, const byte* _data, size_t _size)
+{
+    while (_size > 0)
+    {
+        auto n = ::write(_fd, _data, _size);
+        if (n <= 0)
+        {
+            return false;
+        }
+        _data += n;
+        _size -= n;
+    }
+    return true;
+}
+
+/**
+ * the RPC stand-in: every call is serialized as length(4) + group + nodeID + payload into a
+ * buffer and crosses a unix socket both ways, the copies of an RPC without its framework, so a
+ * lower bound of the RPC cost
+ */
+class SocketGateway : public BenchGateway
+{
+public:
+    explicit SocketGateway(int _fd) : m_fd(_fd) {}
+    ~SocketGateway()
+    {
+        ::shutdown(m_fd, SHUT_RDWR);
+        if (m_receiver.joinable())
+        {
+            m_receiver.join();
+        }
+        ::close(m_fd);
+    }
+
+    void start(std::weak_ptr<FrontService> _front)
+    {
+        m_receiver = std::thread([this, _front]() {
+            bytes record;
+            while (true)
+            {
+                uint32_t length = 0;
+                if (!readFully(m_fd, (byte*)&length, 4))
+                {
+                    return;
+                }
+                record.resize(length);
+                if (!readFully(m_fd, record.data(), length))
+                {
+                    return;
+                }
+                auto groupLength = record[0];
+                uint16_t nodeIDLength = 0;
+                memcpy(&nodeIDLength, record.data() + 1 + groupLength, 2);
+                auto nodeOffset = 1 + groupLength + 2;
+                auto frameOffset = nodeOffset + nodeIDLength;
+                auto front = _front.lock();
+                if (!front)
+                {
+                    return;
+                }
+                front->onReceiveMessage(
+                    std::string((const char*)record.data() + 1, groupLength),
+                    nodeID(bytesConstRef(record.data() + nodeOffset, nodeIDLength)),
+                    bytesConstRef(record.data() + frameOffset, length - frameOffset),
+                    ReceiveMsgFunc());
+            }
+        });
+    }
+
+    void asyncSendMessageByNodeID(const std::string& _groupID, bcos::crypto::NodeIDPtr,
+        bcos::crypto::NodeIDPtr _dstNodeID, bytesConstRef _payload,
+        bcos::gateway::ErrorRespFunc _errorRespFunc) override
+    {
+        auto const& node = _dstNodeID->data();
+        uint32_t length = 1 + _groupID.size() + 2 + node.size() + _payload.size();
+        bytes record;
+        record.reserve(4 + length);
+        record.insert(record.end(), (byte*)&length, (byte*)&length + 4);
+        record.push_back((byte)_groupID.size());
+        record.insert(record.end(), _groupID.begin(), _groupID.end());
+        uint16_t nodeIDLength = node.size();
+        record.insert(record.end(), (byte*)&nodeIDLength, (byte*)&nodeIDLength + 2);
+        record.insert(record.end(), node.begin(), node.end());
+        record.insert(record.end(), _payload.begin(), _payload.end());
+        {
+            std::lock_guard<std::mutex> lock(x_write);
+            writeFully(m_fd, record.data(), record.size());
+        }
+        if (_errorRespFunc)
+        {
+            _errorRespFunc(nullptr);
+        }
+    }
+
+private:
+    bcos::crypto::NodeIDPtr nodeID(bytesConstRef _nodeID)
+    {
+        std::string key((const char*)_nodeID.data(), _nodeID.size());
+        auto it = m_nodeIDs.find(key);
+        if (it == m_nodeIDs.end())
+        {
+            it = m_nodeIDs.emplace(key, createKey(_nodeID)).first;
+        }
+        return it->second;
+    }
+
+    int m_fd;
+    std::mutex x_write;
+    std::thread m_receiver;
+    std::unordered_map<std::string, bcos::crypto::NodeIDPtr> m_nodeIDs;
+};
+
+// the gateway process of the socket: every record goes back as it came
+void runSocketGateway(int _fd)
+{
+    bytes record;
+    while (true)
+    {
+        uint32_t length = 0;
+        if (!readFully(_fd, (byte*)&length, 4))
+        {
+            return;
+        }
+        record.resize(4 + length);
+        memcpy(record.data(), &length, 4);
+        if (!readFully(_fd, record.data() + 4, length) ||
+            !writeFully(_fd, record.data(), record.size()))
+        {
+            return;
+        }
+    }
+}
+
+void runShmGateway(ShmChannel::Ptr _channel)
+{
+    auto peer = ShmChannel::attach(
+        _channel->name(), dup(_channel->toGatewayFd()), dup(_channel->toFrontFd()));
+    auto gateway = std::make_shared<ShmStandInGateway>();
+    auto endpoint = std::make_shared<ShmGatewayEndpoint>(peer, gateway, createKey);
+    gateway->setEndpoint(endpoint);
+    while (true)
+    {
+        if (endpoint->poll() == 0)
+        {
+            peer->toGateway().wait(100);
+        }
+    }
+}
+
+// run the gateway process until the returned guard is released
+std::shared_ptr<void> forkGateway(std::function<void()> _gateway)
+{
+    auto pid = fork();
+    if (pid == 0)
+    {
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        _gateway();
+        _exit(0);
+    }
+    return std::shared_ptr<void>(nullptr, [pid](void*) {
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+    });
+}
+
+FrontService::Ptr buildFront(gateway::GatewayInterface::Ptr _gateway)
+{
+    auto factory = std::make_shared<FrontServiceFactory>();
+    factory->setGatewayInterface(_gateway);
+    std::string nodeID = "bench.front";
+    auto front = factory->buildFrontService(
+        g_groupID, createKey(bytesConstRef((const byte*)nodeID.data(), nodeID.size())));
+    front->registerModuleMessageDispatcher(g_moduleID,
+        [front = std::weak_ptr<FrontService>(front)](bcos::crypto::NodeIDPtr _nodeID,
+            const std::string& _uuid, bytesConstRef _data) {
+            front.lock()->asyncSendResponse(_uuid, g_moduleID, _nodeID, _data, [](Error::Ptr) {});
+        });
+    front->start();
+    return front;
+}
+
+struct Result
+{
+    double requestsPerSecond;
+    uint64_t p50;
+    uint64_t p99;
+};
+
+// _requests round trips of _payloadSize bytes both ways, _window of them in flight
+Result run(FrontService::Ptr _front, size_t _requests, size_t _payloadSize, size_t _window)
+{
+    bytes payload(_payloadSize, 'x');
+    std::string peer = "bench.peer";
+    auto dstNodeID = createKey(bytesConstRef((const byte*)peer.data(), peer.size()));
+    std::vector<uint64_t> latencies(_requests, 0);
+    std::mutex mutex;
+    std::condition_variable released;
+    size_t inFlight = 0;
+    size_t done = 0;
+
+    auto start = nowNs();
+    for (size_t i = 0; i < _requests; ++i)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            released.wait(lock, [&]() { return inFlight < _window; });
+            inFlight++;
+        }
+        auto sendTime = nowNs();
+        _front->asyncSendMessageByNodeID(g_moduleID, dstNodeID,
+            bytesConstRef(payload.data(), payload.size()), 10000,
+            [&, i, sendTime](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef,
+                const std::string&, std::function<void(bytesConstRef)>) {
+                latencies[i] = _error ? std::numeric_limits<uint64_t>::max() : nowNs() - sendTime;
+                std::lock_guard<std::mutex> lock(mutex);
+                inFlight--;
+                done++;
+                released.notify_all();
+            });
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&]() { return done == _requests; });
+    }
+    auto elapsed = nowNs() - start;
+    std::sort(latencies.begin(), latencies.end());
+    return Result{_requests * 1e9 / elapsed, latencies[_requests / 2] / 1000,
+        latencies[_requests * 99 / 100] / 1000};
+}
+}  // namespace
+
+int main(int argc, const char* argv[])
+{
+    size_t requests = argc > 1 ? std::stoul(argv[1]) : 20000;
+    size_t window = argc > 2 ? std::stoul(argv[2]) : 32;
+
+    std::cout << requests << " round trips, " << window << " in flight" << std::endl;
+    std::cout << std::setw(10) << "payload" << std::setw(12) << "transport" << std::setw(14)
+              << "requests/s" << std::setw(12) << "p50(us)" << std::setw(12) << "p99(us)"
+              << std::endl;
+    for (size_t payloadSize : {64, 4096, 256 * 1024})
+    {
+        auto print = [payloadSize](const std::string& _name, const Result& _result) {
+            std::cout << std::setw(10) << payloadSize << std::setw(12) << _name << std::setw(14)
+                      << std::fixed << std::setprecision(0) << _result.requestsPerSecond
+                      << std::setw(12) << _result.p50 << std::setw(12) << _result.p99
+                      << std::endl;
+        };
+        auto count = payloadSize > 64 * 1024 ? requests / 10 : requests;
+        {
+            auto gateway = std::make_shared<InProcessGateway>();
+            auto front = buildFront(gateway);
+            gateway->setFront(front);
+            print("in-process", run(front, count, payloadSize, window));
+            front->stop();
+        }
+        {
+            auto channel = ShmChannel::create(
+                "/bcos-front-bench-" + std::to_string(getpid()), 16 * 1024 * 1024);
+            auto guard = forkGateway([channel]() { runShmGateway(channel); });
+            auto gateway = std::make_shared<ShmGateway>(channel, nullptr);
+            auto front = buildFront(gateway);
+            auto receiver = std::make_shared<ShmFrontReceiver>(channel, front, gateway, createKey);
+            receiver->start();
+            print("shm", run(front, count, payloadSize, window));
+            // the writes of the gateway process are counted in its own ring object
+            std::cout << std::setw(36) << "eventfd writes of the front: "
+                      << channel->toGateway().wakeUps() << std::endl;
+            receiver->stop();
+            front->stop();
+        }
+        {
+            int fds[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+            {
+                std::cerr << "socketpair failed" << std::endl;
+                return 1;
+            }
+            auto guard = forkGateway([fds]() {
+                ::close(fds[0]);
+                runSocketGateway(fds[1]);
+            });
+            ::close(fds[1]);
+            auto gateway = std::make_shared<SocketGateway>(fds[0]);
+            auto front = buildFront(gateway);
+            gateway->start(front);
+            print("socket", run(front, count, payloadSize, window));
+            front->stop();
+        }
+    }
+    return 0;
+}
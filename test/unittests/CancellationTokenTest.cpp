@@ -0,0 +1,66 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the cancellation registry
+ * @file CancellationTokenTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/CancellationToken.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+BOOST_FIXTURE_TEST_SUITE(CancellationTokenTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testCancellationRegistry)
+{
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto nodeID0 = keyFactory->createKey(bytesConstRef((const byte*)"node0", 5));
+    auto nodeID1 = keyFactory->createKey(bytesConstRef((const byte*)"node1", 5));
+    auto now = utcSteadyTimeUs();
+
+    CancellationRegistry registry;
+    auto token = registry.add(nodeID0, "uuid", now + 1000000);
+    BOOST_CHECK_EQUAL(registry.size(), 1);
+    BOOST_CHECK(!token->cancelled());
+    // the same uuid from another node is a different request
+    BOOST_CHECK(!registry.cancel(nodeID1, "uuid"));
+    BOOST_CHECK(registry.cancel(nodeID0, "uuid"));
+    BOOST_CHECK(token->cancelled());
+    BOOST_CHECK_EQUAL(registry.size(), 0);
+    BOOST_CHECK(!registry.cancel(nodeID0, "uuid"));
+
+    // responded
+    token = registry.add(nodeID0, "uuid", now + 1000000);
+    registry.remove(nodeID0, "uuid");
+    BOOST_CHECK_EQUAL(registry.size(), 0);
+    BOOST_CHECK(!registry.cancel(nodeID0, "uuid"));
+    BOOST_CHECK(!token->cancelled());
+
+    // the expired tokens are swept by the next add
+    registry.add(nodeID0, "expired", now);
+    std::this_thread::sleep_for(std::chrono::microseconds(CancellationRegistry::SWEEP_INTERVAL));
+    registry.add(nodeID0, "uuid", now + 10000000);
+    BOOST_CHECK_EQUAL(registry.size(), 1);
+    BOOST_CHECK(!registry.cancel(nodeID0, "expired"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
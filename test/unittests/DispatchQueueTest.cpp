@@ -0,0 +1,121 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the earliest-deadline-first dispatch queue
+ * @file DispatchQueueTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/DispatchQueue.h>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+BOOST_FIXTURE_TEST_SUITE(DispatchQueueTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testDispatchQueue_earliestDeadlineFirst)
+{
+    DispatchQueue queue;
+    queue.setDefaultDeadline(10000000);
+    BOOST_CHECK(!queue.runOne());
+
+    std::vector<int> order;
+    auto now = utcSteadyTimeUs();
+    auto task = [&order](int _id) { return [&order, _id]() { order.push_back(_id); }; };
+    queue.push(DispatchQueue::NO_DEADLINE, task(1), nullptr);
+    queue.push(now + 3000000, task(2), nullptr);
+    queue.push(DispatchQueue::NO_DEADLINE, task(3), nullptr);
+    queue.push(now + 1000000, task(4), nullptr);
+    queue.push(now + 2000000, task(5), nullptr);
+    BOOST_CHECK_EQUAL(queue.size(), 5);
+
+    while (queue.runOne())
+    {
+    }
+    // the deadlines first, then the tasks without deadline in FIFO order
+    BOOST_CHECK(order == std::vector<int>({4, 5, 2, 1, 3}));
+    BOOST_CHECK_EQUAL(queue.size(), 0);
+    BOOST_CHECK_EQUAL(queue.expired(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testDispatchQueue_noDeadline)
+{
+    DispatchQueue queue;
+    queue.setDefaultDeadline(1000);
+    std::vector<int> order;
+    auto task = [&order](int _id) { return [&order, _id]() { order.push_back(_id); }; };
+    queue.push(DispatchQueue::NO_DEADLINE, task(1), nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    // pushed later, but due after the implicit deadline
+    auto now = utcSteadyTimeUs();
+    queue.push(now + 1000000, task(2), nullptr);
+    queue.push(now + 1000, task(3), nullptr);
+    queue.push(DispatchQueue::NO_DEADLINE, task(4), nullptr);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    while (queue.runOne())
+    {
+    }
+    // the implicit deadline orders the task but never drops it
+    BOOST_CHECK(order == std::vector<int>({1, 4, 2}));
+    BOOST_CHECK_EQUAL(queue.expired(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testDispatchQueue_dueTime)
+{
+    DispatchQueue queue;
+    std::vector<int> order;
+    auto task = [&order](int _id) { return [&order, _id]() { order.push_back(_id); }; };
+    auto now = utcSteadyTimeUs();
+    queue.push(now + 2000000, task(1), nullptr);
+    // a batch of a request due first and one without deadline
+    queue.push(now + 1000000, DispatchQueue::NO_DEADLINE, task(2), nullptr);
+    // due first, but kept until its deadline
+    queue.push(now, now + 1000000, task(3), nullptr);
+
+    while (queue.runOne())
+    {
+    }
+    BOOST_CHECK(order == std::vector<int>({3, 2, 1}));
+    BOOST_CHECK_EQUAL(queue.expired(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testDispatchQueue_expired)
+{
+    DispatchQueue queue;
+    int run = 0;
+    int dropped = 0;
+    auto now = utcSteadyTimeUs();
+    queue.push(
+        now - 1, [&run]() { run++; }, [&dropped]() { dropped++; });
+    queue.push(
+        now + 1000000, [&run]() { run++; }, [&dropped]() { dropped++; });
+    // expired without a handler
+    queue.push(now, [&run]() { run++; }, nullptr);
+
+    while (queue.runOne())
+    {
+    }
+    BOOST_CHECK_EQUAL(run, 1);
+    BOOST_CHECK_EQUAL(dropped, 1);
+    BOOST_CHECK_EQUAL(queue.expired(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
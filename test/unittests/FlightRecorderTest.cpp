@@ -0,0 +1,151 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the flight recorder
+ * @file FlightRecorderTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/FlightRecorder.h>
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+BOOST_FIXTURE_TEST_SUITE(FlightRecorderTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testFlightRecorder_record)
+{
+    FlightRecorder recorder(5);
+    BOOST_CHECK_EQUAL(recorder.capacity(), 8);
+    BOOST_CHECK(recorder.snapshot().empty());
+
+    recorder.record(FlightEvent::Send, 11, 2, 100, 1000);
+    recorder.record(FlightEvent::Receive, 12, -1, 0, 10);
+    auto records = recorder.snapshot();
+    BOOST_CHECK_EQUAL(records.size(), 2);
+    BOOST_CHECK(records[0].event == FlightEvent::Send);
+    BOOST_CHECK_EQUAL(records[0].moduleID, 11);
+    BOOST_CHECK_EQUAL(records[0].peerIndex, 2);
+    BOOST_CHECK_EQUAL(records[0].requestID, 100);
+    BOOST_CHECK_EQUAL(records[0].size, 1000);
+    BOOST_CHECK_EQUAL(records[1].peerIndex, -1);
+    BOOST_CHECK(records[0].timestamp <= records[1].timestamp);
+
+    // the oldest records are overwritten
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        recorder.record(FlightEvent::Timeout, i, 0, i + 1, i);
+    }
+    records = recorder.snapshot();
+    BOOST_CHECK_EQUAL(records.size(), 8);
+    BOOST_CHECK_EQUAL(recorder.written(), 22);
+    BOOST_CHECK_EQUAL(records.front().moduleID, 12);
+    BOOST_CHECK_EQUAL(records.back().moduleID, 19);
+}
+
+BOOST_AUTO_TEST_CASE(testFlightRecorder_dumpAndTimelines)
+{
+    FlightRecorder recorder(64);
+    auto id0 = FlightRecorder::requestID("request-0");
+    auto id1 = FlightRecorder::requestID("request-1");
+    BOOST_CHECK_EQUAL(FlightRecorder::requestID(""), 0);
+    recorder.record(FlightEvent::Send, 1, 0, id0, 10);
+    recorder.record(FlightEvent::Send, 1, 1, id1, 10);
+    recorder.record(FlightEvent::Receive, 2, 1, 0, 10);
+    recorder.record(FlightEvent::Response, 1, 1, id1, 20);
+    recorder.record(FlightEvent::Timeout, 1, 0, id0, 0);
+
+    std::stringstream stream;
+    recorder.dump(stream);
+    FlightDump dump;
+    BOOST_CHECK(FlightRecorder::load(stream, dump));
+    BOOST_CHECK_EQUAL(dump.records.size(), 5);
+    BOOST_CHECK(dump.ticksPerSecond > 0);
+
+    auto timelines = FlightRecorder::buildTimelines(dump.records);
+    BOOST_CHECK_EQUAL(timelines.size(), 2);
+    BOOST_CHECK_EQUAL(timelines[id0].size(), 2);
+    BOOST_CHECK(timelines[id0][1].event == FlightEvent::Timeout);
+    BOOST_CHECK(timelines[id1][1].event == FlightEvent::Response);
+    BOOST_CHECK_EQUAL(timelines[id1][1].size, 20);
+
+    std::stringstream invalid("not a dump");
+    BOOST_CHECK(!FlightRecorder::load(invalid, dump));
+}
+
+BOOST_AUTO_TEST_CASE(testFlightRecorder_slowRequestTrigger)
+{
+    FlightRecorder recorder(64);
+    int triggered = 0;
+    recorder.setSlowRequestTrigger(100, 60000, [&triggered](FlightRecorder&) { triggered++; });
+    recorder.onRequestFinished(10);
+    BOOST_CHECK_EQUAL(triggered, 0);
+    recorder.onRequestFinished(200);
+    BOOST_CHECK_EQUAL(triggered, 1);
+    // rate limited by the min interval
+    recorder.onRequestFinished(200);
+    BOOST_CHECK_EQUAL(triggered, 1);
+}
+
+BOOST_AUTO_TEST_CASE(testFlightRecorder_slowRequestTriggerExecutor)
+{
+    // queue the tasks instead of running them
+    class QueueExecutor : public FrontExecutor
+    {
+    public:
+        void enqueue(Task _task) override { tasks.emplace_back(std::move(_task)); }
+        void stop() override {}
+        std::vector<Task> tasks;
+    };
+    auto executor = std::make_shared<QueueExecutor>();
+    auto recorder = std::make_shared<FlightRecorder>(64);
+    std::atomic<int> triggered(0);
+    recorder->setSlowRequestTrigger(100, 0, [&triggered](FlightRecorder&) { triggered++; });
+    recorder->onRequestFinished(200, executor);
+    // posted, not run by the thread finishing the request
+    BOOST_CHECK_EQUAL(triggered, 0);
+    BOOST_CHECK_EQUAL(executor->tasks.size(), 1);
+    executor->tasks.front()();
+    BOOST_CHECK_EQUAL(triggered, 1);
+
+    // the trigger replaced while the requests finish
+    std::thread setter([&recorder]() {
+        for (int i = 0; i < 100; ++i)
+        {
+            recorder->setSlowRequestTrigger(100, 0, [](FlightRecorder&) {});
+        }
+    });
+    for (int i = 0; i < 100; ++i)
+    {
+        recorder->onRequestFinished(200);
+    }
+    setter.join();
+
+    // the pending dump is dropped with the recorder
+    triggered = 0;
+    recorder->setSlowRequestTrigger(100, 0, [&triggered](FlightRecorder&) { triggered++; });
+    recorder->onRequestFinished(200, executor);
+    recorder.reset();
+    executor->tasks.back()();
+    BOOST_CHECK_EQUAL(triggered, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,199 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the frame capture and the trace replay
+ * @file FrameCaptureTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include "FakeGateway.h"
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/libutilities/Exceptions.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/FrameCapture.h>
+#include <bcos-front/FrontServiceFactory.h>
+#include <bcos-front/TraceReplayer.h>
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+using namespace bcos::front::test;
+
+namespace
+{
+std::string tracePath()
+{
+    static std::atomic<int> index(0);
+    return "front-trace-" + std::to_string(utcTime()) + "-" + std::to_string(index++) + ".bin";
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(FrameCaptureTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testFrameCapture_appendAndRead)
+{
+    auto path = tracePath();
+    std::string nodeID = "node";
+    std::string frame(100, 'f');
+    {
+        FrameCapture capture(path, 800);
+        for (size_t i = 0; i < 20; ++i)
+        {
+            capture.append(bytesConstRef((const byte*)nodeID.data(), nodeID.size()),
+                bytesConstRef((const byte*)frame.data(), i));
+        }
+        // 64 bytes header and 8 bytes aligned records of 22 + i bytes, 760 bytes in total
+        BOOST_CHECK_EQUAL(capture.capturedFrames(), 20);
+        BOOST_CHECK_EQUAL(capture.droppedFrames(), 0);
+        // full
+        BOOST_CHECK(!capture.append(bytesConstRef((const byte*)nodeID.data(), nodeID.size()),
+            bytesConstRef((const byte*)frame.data(), frame.size())));
+        BOOST_CHECK_EQUAL(capture.droppedFrames(), 1);
+    }
+
+    FrameTrace trace(path);
+    BOOST_CHECK_EQUAL(trace.frames().size(), 20);
+    for (size_t i = 0; i < trace.frames().size(); ++i)
+    {
+        auto const& captured = trace.frames()[i];
+        BOOST_CHECK_EQUAL(captured.nodeID.toString(), nodeID);
+        BOOST_CHECK_EQUAL(captured.frame.size(), i);
+        if (i > 0)
+        {
+            BOOST_CHECK(captured.arrivalTime >= trace.frames()[i - 1].arrivalTime);
+        }
+    }
+    std::remove(path.c_str());
+
+    BOOST_CHECK_THROW(FrameTrace("/not/exist/trace.bin"), InvalidParameter);
+}
+
+BOOST_AUTO_TEST_CASE(testFrameCapture_outOfOrderTrace)
+{
+    auto path = tracePath();
+    std::string nodeID = "node";
+    std::string frame(3, 'f');
+    {
+        FrameCapture capture(path, 1024);
+        for (size_t i = 1; i <= 3; ++i)
+        {
+            capture.append(bytesConstRef((const byte*)nodeID.data(), nodeID.size()),
+                bytesConstRef((const byte*)frame.data(), i));
+        }
+        capture.close();
+    }
+    // rewrite the arrival times out of the file order, as written by another capturer
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        uint64_t offset = 64;
+        uint64_t arrivalTimes[] = {3000000, 1000, 2000};
+        for (size_t i = 1; i <= 3; ++i)
+        {
+            file.seekp(offset + 8);
+            file.write((const char*)&arrivalTimes[i - 1], 8);
+            // 18 bytes record header, 8 bytes aligned
+            offset += (18 + nodeID.size() + i + 7) & ~(uint64_t)7;
+        }
+    }
+
+    auto trace = std::make_shared<FrameTrace>(path);
+    BOOST_CHECK_EQUAL(trace->frames().size(), 3);
+    BOOST_CHECK_EQUAL(trace->frames()[0].arrivalTime, 1000);
+    BOOST_CHECK_EQUAL(trace->frames()[0].frame.size(), 2);
+    BOOST_CHECK_EQUAL(trace->frames()[1].frame.size(), 3);
+    BOOST_CHECK_EQUAL(trace->frames()[2].frame.size(), 1);
+
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto factory = std::make_shared<FrontServiceFactory>();
+    factory->setGatewayInterface(std::make_shared<FakeGateway>());
+    auto frontService = factory->buildFrontService(
+        "group", keyFactory->createKey(bytesConstRef((const byte*)"front", 5)));
+    TraceReplayer replayer(
+        trace, [keyFactory](bytesConstRef _nodeID) { return keyFactory->createKey(_nodeID); });
+    // the frames are not valid messages, only the timing is replayed
+    auto result = replayer.replay(frontService, "group", 1);
+    BOOST_CHECK_EQUAL(result.frames, 3);
+    BOOST_CHECK_EQUAL(result.traceSpan, 2999);
+    BOOST_CHECK(result.elapsed >= 2999);
+    BOOST_CHECK(result.elapsed < 1000000);
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(testFrameCapture_captureAndReplay)
+{
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto buildFront = [keyFactory]() {
+        auto gateway = std::make_shared<FakeGateway>();
+        auto factory = std::make_shared<FrontServiceFactory>();
+        factory->setGatewayInterface(gateway);
+        auto frontService = factory->buildFrontService(
+            "group", keyFactory->createKey(bytesConstRef((const byte*)"front", 5)));
+        frontService->start();
+        gateway->setFrontService(frontService);
+        return frontService;
+    };
+
+    int moduleID = 1001;
+    std::string data(256, 'x');
+    auto path = tracePath();
+    {
+        auto frontService = buildFront();
+        std::atomic<int> received(0);
+        frontService->registerModuleMessageDispatcher(moduleID,
+            [&received](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {
+                received++;
+            });
+        frontService->setFrameCapture(std::make_shared<FrameCapture>(path, 1024 * 1024));
+        auto dstNodeID = keyFactory->createKey(bytesConstRef((const byte*)"peer", 4));
+        for (int i = 0; i < 10; ++i)
+        {
+            frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+                bytesConstRef((const byte*)data.data(), data.size()), 0, CallbackFunc());
+        }
+        BOOST_CHECK_EQUAL(received, 10);
+        BOOST_CHECK_EQUAL(frontService->frameCapture()->capturedFrames(), 10);
+        frontService->frameCapture()->close();
+        frontService->setFrameCapture(nullptr);
+    }
+
+    auto trace = std::make_shared<FrameTrace>(path);
+    BOOST_CHECK_EQUAL(trace->frames().size(), 10);
+
+    auto frontService = buildFront();
+    std::atomic<int> replayed(0);
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [&replayed, &data](bcos::crypto::NodeIDPtr _nodeID, const std::string&,
+            bytesConstRef _data) {
+            BOOST_CHECK_EQUAL(_nodeID->data().size(), 4);
+            BOOST_CHECK_EQUAL(_data.toString(), data);
+            replayed++;
+        });
+    TraceReplayer replayer(
+        trace, [keyFactory](bytesConstRef _nodeID) { return keyFactory->createKey(_nodeID); });
+    auto result = replayer.replay(frontService, "group", 0);
+    BOOST_CHECK_EQUAL(result.frames, 10);
+    BOOST_CHECK_EQUAL(replayed, 10);
+
+    // replay at 1000x the recorded speed
+    result = replayer.replay(frontService, "group", 1000);
+    BOOST_CHECK_EQUAL(replayed, 20);
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
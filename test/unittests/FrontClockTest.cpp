@@ -0,0 +1,112 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the clocks of the front service
+ * @file FrontClockTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/FrontClock.h>
+#include <boost/test/unit_test.hpp>
+#include <future>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+BOOST_FIXTURE_TEST_SUITE(FrontClockTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testVirtualClock_order)
+{
+    auto clock = std::make_shared<VirtualClock>(1000);
+    BOOST_CHECK_EQUAL(clock->nowUs(), 1000);
+    BOOST_CHECK_EQUAL(clock->now(), 1);
+
+    std::vector<std::pair<int, uint64_t>> fired;
+    for (int i = 0; i < 3; ++i)
+    {
+        // the timers of the same time fire in the scheduled order
+        clock->schedule(300, [&fired, clock, i]() { fired.emplace_back(i, clock->nowUs()); });
+    }
+    clock->schedule(100, [&fired, clock]() {
+        fired.emplace_back(3, clock->nowUs());
+        // due within the same advance
+        clock->schedule(50, [&fired, clock]() { fired.emplace_back(4, clock->nowUs()); });
+    });
+    BOOST_CHECK_EQUAL(clock->pending(), 4);
+
+    BOOST_CHECK_EQUAL(clock->advance(99), 0);
+    BOOST_CHECK_EQUAL(clock->nowUs(), 1099);
+    BOOST_CHECK_EQUAL(clock->advanceTo(1200), 2);
+    BOOST_CHECK_EQUAL(clock->nowUs(), 1200);
+    BOOST_CHECK_EQUAL(clock->runUntilIdle(), 3);
+    BOOST_CHECK_EQUAL(clock->nowUs(), 1300);
+    BOOST_CHECK_EQUAL(clock->pending(), 0);
+
+    std::vector<std::pair<int, uint64_t>> expected = {
+        {3, 1100}, {4, 1150}, {0, 1300}, {1, 1300}, {2, 1300}};
+    BOOST_CHECK(fired == expected);
+
+    // never goes back
+    clock->advanceTo(0);
+    BOOST_CHECK_EQUAL(clock->nowUs(), 1300);
+}
+
+BOOST_AUTO_TEST_CASE(testVirtualClock_cancel)
+{
+    auto clock = std::make_shared<VirtualClock>();
+    int fired = 0;
+    auto timer = clock->schedule(100, [&fired]() { fired++; });
+    auto other = clock->schedule(200, [&fired]() { fired++; });
+    BOOST_CHECK(timer->pending());
+    BOOST_CHECK(timer->cancel());
+    BOOST_CHECK(!timer->cancel());
+    BOOST_CHECK(!timer->pending());
+    // the cancelled timer stays scheduled until reached
+    BOOST_CHECK_EQUAL(clock->pending(), 2);
+
+    BOOST_CHECK_EQUAL(clock->runUntilIdle(), 1);
+    BOOST_CHECK_EQUAL(fired, 1);
+    BOOST_CHECK(!other->cancel());
+    BOOST_CHECK(!other->fire());
+    BOOST_CHECK_EQUAL(fired, 1);
+}
+
+BOOST_AUTO_TEST_CASE(testAsioClock)
+{
+    auto ioService = std::make_shared<boost::asio::io_service>();
+    auto work = std::make_shared<boost::asio::io_service::work>(*ioService);
+    std::thread ioThread([ioService]() { ioService->run(); });
+
+    auto clock = std::make_shared<AsioClock>(ioService);
+    std::promise<uint64_t> promise;
+    auto start = clock->nowUs();
+    clock->schedule(20000, [&promise, clock]() { promise.set_value(clock->nowUs()); });
+    std::atomic<int> cancelled(0);
+    auto timer = clock->schedule(10000, [&cancelled]() { cancelled++; });
+    BOOST_CHECK(timer->cancel());
+
+    BOOST_CHECK(promise.get_future().get() >= start + 20000);
+    BOOST_CHECK_EQUAL(cancelled, 0);
+
+    work.reset();
+    ioService->stop();
+    ioThread.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the pre-encoded frames
+ * @file FrontFrameTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/FrontFrame.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+namespace
+{
+bytesConstRef toRef(const std::string& _data)
+{
+    return bytesConstRef((const byte*)_data.data(), _data.size());
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(FrontFrameTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testFrontFrame_send)
+{
+    std::string payload(1000, 'p');
+    FrontFrame frame(1000, toRef(payload));
+    BOOST_CHECK_EQUAL(frame.moduleID(), 1000);
+    BOOST_CHECK_EQUAL(frame.payload().toString(), payload);
+
+    // every send sees its own header in front of the payload, written in place
+    for (auto const& header : {std::string("header-1"), std::string("h2"), std::string()})
+    {
+        std::string sent;
+        frame.send(toRef(header), [&sent](bytesConstRef _frame) { sent = _frame.toString(); });
+        BOOST_CHECK_EQUAL(sent, header + payload);
+    }
+    BOOST_CHECK_EQUAL(frame.patched(), 3);
+    BOOST_CHECK_EQUAL(frame.copied(), 0);
+    BOOST_CHECK_EQUAL(frame.payload().toString(), payload);
+
+    // a header over the room is copied
+    std::string large(FrontFrame::HEADER_ROOM + 1, 'h');
+    std::string sent;
+    frame.send(toRef(large), [&sent](bytesConstRef _frame) { sent = _frame.toString(); });
+    BOOST_CHECK_EQUAL(sent, large + payload);
+    BOOST_CHECK_EQUAL(frame.copied(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontFrame_nestedSend)
+{
+    std::string payload(100, 'p');
+    FrontFrame frame(1000, toRef(payload));
+    std::string outer;
+    std::string inner;
+    // a send from the gateway of another send copies the frame and leaves the outer one intact
+    frame.send(toRef("outer"), [&](bytesConstRef _outer) {
+        frame.send(toRef("in"), [&inner](bytesConstRef _inner) { inner = _inner.toString(); });
+        outer = _outer.toString();
+    });
+    BOOST_CHECK_EQUAL(outer, "outer" + payload);
+    BOOST_CHECK_EQUAL(inner, "in" + payload);
+    BOOST_CHECK_EQUAL(frame.patched(), 1);
+    BOOST_CHECK_EQUAL(frame.copied(), 1);
+
+    // an exception of the gateway releases the frame
+    BOOST_CHECK_THROW(
+        frame.send(toRef("x"), [](bytesConstRef) { throw std::runtime_error("gateway"); }),
+        std::runtime_error);
+    frame.send(toRef("y"), [](bytesConstRef) {});
+    BOOST_CHECK_EQUAL(frame.patched(), 3);
+    BOOST_CHECK_EQUAL(frame.copied(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,7 @@
 #include <bcos-framework/testutils/TestPromptFixture.h>
 #include <bcos-front/FrontMessage.h>
 #include <boost/test/unit_test.hpp>
+#include <random>
 
 using namespace bcos;
 using namespace bcos::test;
@@ -227,4 +228,154 @@ BOOST_AUTO_TEST_CASE(testFrontMessage_5)
         payload, std::string(decodeMessage->payload().begin(), decodeMessage->payload().end()));
 }
 
+BOOST_AUTO_TEST_CASE(testFrontMessageView)
+{
+    auto factory = std::make_shared<FrontMessageFactory>();
+    auto message = factory->buildMessage();
+    std::string uuid = "1234567890";
+    std::string payload = "payload";
+    message->setModuleID(0xabcd);
+    message->setExt(0x1201);
+    message->setUuid(std::make_shared<bytes>(uuid.begin(), uuid.end()));
+    message->setPayload(bytesConstRef((const byte*)payload.data(), payload.size()));
+
+    bytes buffer;
+    BOOST_CHECK(message->encode(buffer));
+
+    FrontMessageView view;
+    BOOST_CHECK_EQUAL(view.decode(bytesConstRef(buffer.data(), buffer.size())),
+        MessageDecodeStatus::MESSAGE_COMPLETE);
+    BOOST_CHECK_EQUAL(view.moduleID(), 0xabcd);
+    BOOST_CHECK_EQUAL(view.ext(), 0x1201);
+    BOOST_CHECK(view.isResponse());
+    BOOST_CHECK_EQUAL(std::string(view.uuid().begin(), view.uuid().end()), uuid);
+    BOOST_CHECK_EQUAL(std::string(view.payload().begin(), view.payload().end()), payload);
+    // refers to the buffer instead of copying
+    BOOST_CHECK(view.payload().data() == buffer.data() + buffer.size() - payload.size());
+
+    // uuid length beyond the buffer
+    bytes invalid{0x00, 0x01, 0xff, 0x00, 0x00, 0x00};
+    BOOST_CHECK_EQUAL(view.decode(bytesConstRef(invalid.data(), invalid.size())),
+        MessageDecodeStatus::MESSAGE_ERROR);
+    BOOST_CHECK_EQUAL(message->decode(bytesConstRef(invalid.data(), invalid.size())),
+        MessageDecodeStatus::MESSAGE_ERROR);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontMessageExtension)
+{
+    auto factory = std::make_shared<FrontMessageFactory>();
+    auto message = factory->buildMessage();
+    std::string uuid = "1234567890";
+    std::string payload = "payload";
+    message->setModuleID(1000);
+    message->setUuid(std::make_shared<bytes>(uuid.begin(), uuid.end()));
+    message->setPayload(bytesConstRef((const byte*)payload.data(), payload.size()));
+
+    // no extension, the legacy layout
+    bytes legacy;
+    BOOST_CHECK(message->encode(legacy));
+    BOOST_CHECK_EQUAL(
+        legacy.size(), FrontMessage::HEADER_MIN_LENGTH + uuid.size() + payload.size());
+
+    FrontMessageExtension extension;
+    extension.setTrace(0x0102030405060708ULL, 1634515200000000ULL, 3);
+    extension.setDeadline(0x0a0b0c0d);
+    message->setExtension(extension);
+    BOOST_CHECK(message->hasExtension());
+    bytes buffer;
+    BOOST_CHECK(message->encode(buffer));
+    BOOST_CHECK_EQUAL(buffer.size(), legacy.size() + extension.encodedLength());
+
+    auto decoded = factory->buildMessage();
+    BOOST_CHECK_EQUAL(decoded->decode(bytesConstRef(buffer.data(), buffer.size())),
+        MessageDecodeStatus::MESSAGE_COMPLETE);
+    BOOST_CHECK(decoded->hasExtension());
+    BOOST_CHECK(decoded->extension().hasTrace());
+    BOOST_CHECK_EQUAL(decoded->extension().traceID, extension.traceID);
+    BOOST_CHECK_EQUAL(decoded->extension().sendTime, extension.sendTime);
+    BOOST_CHECK_EQUAL(decoded->extension().hops, 3);
+    BOOST_CHECK(decoded->extension().hasDeadline());
+    BOOST_CHECK_EQUAL(decoded->extension().ttl, 0x0a0b0c0d);
+    BOOST_CHECK_EQUAL(std::string(decoded->payload().begin(), decoded->payload().end()), payload);
+
+    FrontMessageView view;
+    BOOST_CHECK_EQUAL(view.decode(bytesConstRef(buffer.data(), buffer.size())),
+        MessageDecodeStatus::MESSAGE_COMPLETE);
+    BOOST_CHECK(view.extension().hasTrace());
+    BOOST_CHECK_EQUAL(view.extension().traceID, extension.traceID);
+    BOOST_CHECK_EQUAL(view.extension().sendTime, extension.sendTime);
+    BOOST_CHECK_EQUAL(view.extension().ttl, 0x0a0b0c0d);
+    BOOST_CHECK_EQUAL(std::string(view.payload().begin(), view.payload().end()), payload);
+
+    // a newer version appending unknown fields is skipped by its length
+    bytes newer(buffer.begin(), buffer.end());
+    auto extensionOffset = FrontMessage::HEADER_MIN_LENGTH + uuid.size();
+    newer[extensionOffset] += 4;
+    newer[extensionOffset + 1] = FrontMessageExtension::VERSION + 1;
+    newer[extensionOffset + 2] |= 0x80;
+    newer.insert(newer.begin() + extensionOffset + extension.encodedLength(), 4, 0xee);
+    BOOST_CHECK_EQUAL(view.decode(bytesConstRef(newer.data(), newer.size())),
+        MessageDecodeStatus::MESSAGE_COMPLETE);
+    BOOST_CHECK_EQUAL(view.extension().version, FrontMessageExtension::VERSION + 1);
+    BOOST_CHECK_EQUAL(view.extension().traceID, extension.traceID);
+    BOOST_CHECK_EQUAL(std::string(view.payload().begin(), view.payload().end()), payload);
+
+    // the extension length beyond the buffer or too short for its fields
+    bytes invalid(buffer.begin(), buffer.begin() + extensionOffset + 5);
+    BOOST_CHECK_EQUAL(view.decode(bytesConstRef(invalid.data(), invalid.size())),
+        MessageDecodeStatus::MESSAGE_ERROR);
+    BOOST_CHECK_EQUAL(decoded->decode(bytesConstRef(invalid.data(), invalid.size())),
+        MessageDecodeStatus::MESSAGE_ERROR);
+    invalid.assign(buffer.begin(), buffer.end());
+    invalid[extensionOffset] = FrontMessageExtension::HEADER_LENGTH + 1;
+    BOOST_CHECK_EQUAL(view.decode(bytesConstRef(invalid.data(), invalid.size())),
+        MessageDecodeStatus::MESSAGE_ERROR);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontMessageView_fuzz)
+{
+    auto factory = std::make_shared<FrontMessageFactory>();
+    std::mt19937 random(20211018);
+    for (size_t round = 0; round < 200; ++round)
+    {
+        auto message = factory->buildMessage();
+        auto uuid = std::make_shared<bytes>(random() % 64, (byte)random());
+        bytes payload(random() % 128, (byte)random());
+        message->setModuleID(random());
+        message->setExt(random());
+        message->setUuid(uuid);
+        message->setPayload(bytesConstRef(payload.data(), payload.size()));
+        bytes buffer;
+        BOOST_CHECK(message->encode(buffer));
+
+        // every truncation of the frame and random corruptions of its header
+        for (size_t length = 0; length <= buffer.size(); ++length)
+        {
+            bytes frame(buffer.begin(), buffer.begin() + length);
+            if (length > 2 && round % 2)
+            {
+                frame[random() % 3] = random();
+            }
+            // keep the data on the heap so that out of bounds reads are caught by sanitizers
+            auto input = std::make_unique<byte[]>(frame.size());
+            std::copy(frame.begin(), frame.end(), input.get());
+
+            FrontMessageView view;
+            auto decoded = factory->buildMessage();
+            auto viewStatus = view.decode(bytesConstRef(input.get(), frame.size()));
+            auto status = decoded->decode(bytesConstRef(input.get(), frame.size()));
+            BOOST_REQUIRE_EQUAL(viewStatus, status);
+            if (status != MessageDecodeStatus::MESSAGE_COMPLETE)
+            {
+                continue;
+            }
+            BOOST_CHECK_EQUAL(view.moduleID(), decoded->moduleID());
+            BOOST_CHECK_EQUAL(view.ext(), decoded->ext());
+            BOOST_CHECK(view.uuid().toBytes() == *decoded->uuid());
+            BOOST_CHECK(view.payload().toBytes() == decoded->payload().toBytes());
+            BOOST_CHECK(view.payload().data() + view.payload().size() <= input.get() + length);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
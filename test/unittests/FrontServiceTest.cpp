@@ -24,12 +24,15 @@
 #include "FakeGateway.h"
 #include <bcos-crypto/signature/key/KeyFactoryImpl.h>
 #include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/libutilities/Exceptions.h>
 #include <bcos-framework/testutils/TestPromptFixture.h>
 #include <bcos-front/Common.h>
+#include <bcos-front/FrameCapture.h>
 #include <bcos-front/FrontMessage.h>
 #include <bcos-front/FrontService.h>
 #include <bcos-front/FrontServiceFactory.h>
 #include <boost/test/unit_test.hpp>
+#include <set>
 
 using namespace bcos;
 using namespace bcos::test;
@@ -108,6 +111,155 @@ BOOST_AUTO_TEST_CASE(testFrontService_asyncSendMessageByNodeID_withoutCallback)
     f.get();
 }
 
+BOOST_AUTO_TEST_CASE(testFrontService_registerModuleMessageDispatcher)
+{
+    auto frontService = buildFrontService();
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, 'x');
+
+    std::atomic<int> received(0);
+    auto moduleCallback = [&received](bcos::crypto::NodeIDPtr, const std::string&,
+                              bytesConstRef) { received++; };
+
+    BOOST_CHECK_THROW(frontService->registerModuleMessageDispatcher(-1, moduleCallback),
+        InvalidParameter);
+    BOOST_CHECK_THROW(frontService->registerModuleMessageDispatcher(65536, moduleCallback),
+        InvalidParameter);
+
+    int moduleID = 65535;
+    // register after start
+    frontService->registerModuleMessageDispatcher(moduleID, moduleCallback);
+    BOOST_CHECK_EQUAL(frontService->moduleID2MessageDispatcher().size(), 1);
+    BOOST_CHECK(frontService->moduleID2MessageDispatcher().count(moduleID));
+
+    // replace the dispatcher
+    std::promise<bool> p;
+    auto f = p.get_future();
+    frontService->registerModuleMessageDispatcher(
+        moduleID, [&p](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {
+            p.set_value(true);
+        });
+    BOOST_CHECK_EQUAL(frontService->moduleID2MessageDispatcher().size(), 1);
+    frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 0, CallbackFunc());
+    f.get();
+    BOOST_CHECK_EQUAL(received, 0);
+
+    BOOST_CHECK(frontService->unregisterModuleMessageDispatcher(moduleID));
+    BOOST_CHECK(!frontService->unregisterModuleMessageDispatcher(moduleID));
+    BOOST_CHECK(frontService->moduleID2MessageDispatcher().empty());
+}
+
+BOOST_AUTO_TEST_CASE(testEpochSlot_reclaim)
+{
+    std::atomic<int> alive(0);
+    auto makeValue = [&alive](int _value) {
+        alive++;
+        return std::shared_ptr<const int>(new int(_value), [&alive](const int* _p) {
+            alive--;
+            delete _p;
+        });
+    };
+    {
+        EpochSlot<int> slot(makeValue(0));
+        std::atomic<bool> running(true);
+        std::atomic<int> regressed(0);
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i)
+        {
+            readers.emplace_back([&slot, &running, &regressed]() {
+                int last = 0;
+                while (running)
+                {
+                    auto value = slot.load();
+                    // the values are published in order
+                    if (*value < last)
+                    {
+                        regressed++;
+                    }
+                    last = *value;
+                }
+            });
+        }
+        for (int i = 1; i <= 10000; ++i)
+        {
+            slot.store(makeValue(i));
+        }
+        running = false;
+        for (auto& reader : readers)
+        {
+            reader.join();
+        }
+        BOOST_CHECK_EQUAL(regressed, 0);
+        BOOST_CHECK_EQUAL(*slot.load(), 10000);
+        // freed by the next writes once no reader is left, the last replaced one is kept until
+        // the epoch moves on
+        slot.store(makeValue(1));
+        slot.store(makeValue(2));
+        BOOST_CHECK_EQUAL(slot.retired(), 1);
+        BOOST_CHECK_EQUAL(alive, 2);
+    }
+    BOOST_CHECK_EQUAL(alive, 0);
+}
+
+BOOST_AUTO_TEST_CASE(testModuleDispatcherTable_reclaim)
+{
+    ModuleDispatcherTable<int> table;
+    std::atomic<int> alive(0);
+    auto makeValue = [&alive](int _value) {
+        alive++;
+        return std::shared_ptr<const int>(new int(_value), [&alive](const int* _p) {
+            alive--;
+            delete _p;
+        });
+    };
+    // the readers race with the writer replacing the handler
+    std::atomic<bool> running(true);
+    std::atomic<int> invalid(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&table, &running, &invalid]() {
+            while (running)
+            {
+                auto value = table.get(7);
+                if (value && *value < 0)
+                {
+                    invalid++;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 10000; ++i)
+    {
+        table.set(7, makeValue(i));
+    }
+    running = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+    BOOST_CHECK_EQUAL(invalid, 0);
+    // freed by the next writes once no reader is left
+    table.remove(7);
+    table.remove(7);
+    BOOST_CHECK_EQUAL(table.retired(), 0);
+    BOOST_CHECK_EQUAL(alive, 0);
+
+    // the captures of the replaced dispatchers are released
+    auto frontService = buildFrontService();
+    auto capture = std::make_shared<int>(0);
+    std::weak_ptr<int> weakCapture = capture;
+    frontService->registerModuleMessageDispatcher(
+        100, [capture](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {});
+    capture.reset();
+    frontService->registerModuleMessageDispatcher(
+        100, [](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {});
+    BOOST_CHECK(!weakCapture.expired());
+    frontService->unregisterModuleMessageDispatcher(100);
+    BOOST_CHECK(weakCapture.expired());
+}
+
 BOOST_AUTO_TEST_CASE(testFrontService_onRecieveNodeIDsAnd)
 {
     auto frontService = buildFrontService();
@@ -143,6 +295,126 @@ BOOST_AUTO_TEST_CASE(testFrontService_onRecieveNodeIDsAnd)
     BOOST_CHECK(nodeIDs0->size() == nodeIDs->size());
 }
 
+BOOST_AUTO_TEST_CASE(testFrontService_onReceiveNodeIDsDelta)
+{
+    auto frontService = buildFrontService();
+    int moduleID = 1000;
+    auto nodeID0 = createKey(g_dstNodeID_0);
+    auto nodeID1 = createKey(g_dstNodeID_1);
+
+    std::vector<NodeIDsDelta::Ptr> deltas;
+    frontService->registerModuleNodeIDsDeltaDispatcher(moduleID,
+        [&deltas](NodeIDsDelta::Ptr _delta, ReceiveMsgFunc) { deltas.push_back(_delta); });
+
+    BOOST_CHECK(!frontService->isConnected(nodeID0));
+    BOOST_CHECK_EQUAL(frontService->nodeIDsSnapshot()->version(), 0);
+
+    auto nodeIDs = std::make_shared<crypto::NodeIDs>(crypto::NodeIDs{nodeID0, nodeID0});
+    frontService->onReceiveNodeIDs(g_groupID, nodeIDs, nullptr);
+    BOOST_CHECK(frontService->isConnected(createKey(g_dstNodeID_0)));
+    BOOST_CHECK(!frontService->isConnected(nodeID1));
+    BOOST_CHECK_EQUAL(deltas.size(), 1);
+    BOOST_CHECK_EQUAL(deltas[0]->added.size(), 1);
+    BOOST_CHECK(deltas[0]->removed.empty());
+
+    // the same node list does not produce a delta
+    frontService->onReceiveNodeIDs(g_groupID, nodeIDs, nullptr);
+    BOOST_CHECK_EQUAL(deltas.size(), 1);
+
+    frontService->onReceiveNodeIDs(
+        g_groupID, std::make_shared<crypto::NodeIDs>(crypto::NodeIDs{nodeID1}), nullptr);
+    BOOST_CHECK_EQUAL(deltas.size(), 2);
+    BOOST_CHECK_EQUAL(deltas[1]->version, 3);
+    BOOST_CHECK_EQUAL(deltas[1]->added.size(), 1);
+    BOOST_CHECK_EQUAL(deltas[1]->added[0]->hex(), nodeID1->hex());
+    BOOST_CHECK_EQUAL(deltas[1]->removed.size(), 1);
+    BOOST_CHECK_EQUAL(deltas[1]->removed[0]->hex(), nodeID0->hex());
+    BOOST_CHECK(frontService->isConnected(nodeID1));
+    BOOST_CHECK(!frontService->isConnected(nodeID0));
+    BOOST_CHECK_EQUAL(frontService->nodeIDsSnapshot()->indexOf(nodeID1), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testNodeIDsSnapshot_sample)
+{
+    crypto::NodeIDs nodeIDs;
+    for (int i = 0; i < 10; ++i)
+    {
+        nodeIDs.push_back(createKey(g_dstNodeID_0 + std::to_string(i)));
+    }
+    auto self = nodeIDs[3];
+    // duplicated nodes are sampled as often as the others
+    auto withDuplicates = nodeIDs;
+    withDuplicates.push_back(nodeIDs[0]);
+    withDuplicates.push_back(nodeIDs[0]);
+    NodeIDsSnapshot snapshot(1, std::make_shared<const crypto::NodeIDs>(withDuplicates));
+
+    std::map<std::string, size_t> counts;
+    size_t const rounds = 9000;
+    for (size_t i = 0; i < rounds; ++i)
+    {
+        crypto::NodeIDs sampled;
+        BOOST_CHECK_EQUAL(snapshot.sample(3, self, sampled), 3);
+        BOOST_CHECK_EQUAL(sampled.size(), 3);
+        std::set<std::string> distinct;
+        for (auto const& nodeID : sampled)
+        {
+            distinct.insert(nodeID->hex());
+            counts[nodeID->hex()]++;
+        }
+        BOOST_CHECK_EQUAL(distinct.size(), 3);
+    }
+    BOOST_CHECK(!counts.count(self->hex()));
+    BOOST_CHECK_EQUAL(counts.size(), 9);
+    // 3 of 9 peers each round, 3000 times each in expectation
+    for (auto const& entry : counts)
+    {
+        BOOST_CHECK(entry.second > 2700 && entry.second < 3300);
+    }
+
+    // fewer peers than the fanout
+    crypto::NodeIDs sampled;
+    BOOST_CHECK_EQUAL(snapshot.sample(100, self, sampled), 9);
+    BOOST_CHECK_EQUAL(NodeIDsSnapshot().sample(3, self, sampled), 0);
+    BOOST_CHECK_EQUAL(sampled.size(), 9);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_asyncGossip)
+{
+    auto frontService = buildFrontService();
+    int moduleID = 1002;
+    std::string data(100, 'g');
+    auto received = std::make_shared<std::atomic<int>>(0);
+    frontService->registerModuleMessageDispatcher(
+        moduleID, [received, data](bcos::crypto::NodeIDPtr, const std::string& _uuid,
+                      bytesConstRef _data) {
+            BOOST_CHECK(_uuid.empty());
+            BOOST_CHECK_EQUAL(_data.toString(), data);
+            (*received)++;
+        });
+    auto payload = bytesConstRef((const byte*)data.data(), data.size());
+    BOOST_CHECK_EQUAL(frontService->asyncGossip(moduleID, payload, 3), 0);
+
+    crypto::NodeIDs nodeIDs{frontService->nodeID()};
+    for (int i = 0; i < 5; ++i)
+    {
+        nodeIDs.push_back(createKey(g_dstNodeID_1 + std::to_string(i)));
+    }
+    frontService->onReceiveNodeIDs(
+        g_groupID, std::make_shared<const crypto::NodeIDs>(nodeIDs), nullptr);
+    BOOST_CHECK_EQUAL(frontService->asyncGossip(moduleID, payload, 3), 3);
+    // never gossip to itself
+    BOOST_CHECK_EQUAL(frontService->asyncGossip(moduleID, payload, 10), 5);
+    // all the peers, nothing reserved beyond the group
+    BOOST_CHECK_EQUAL(
+        frontService->asyncGossip(moduleID, payload, std::numeric_limits<size_t>::max()), 5);
+    // the fake gateway delivers a multi-destination send once
+    while (*received < 3)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(*received, 3);
+}
+
 BOOST_AUTO_TEST_CASE(testFrontService_asyncSendMessageByNodeID_callback)
 {
     auto frontService = buildFrontService();
@@ -177,6 +449,956 @@ BOOST_AUTO_TEST_CASE(testFrontService_asyncSendMessageByNodeID_callback)
     }
 }
 
+BOOST_AUTO_TEST_CASE(testFrontService_flightRecorder)
+{
+    auto frontService = buildFrontService();
+    auto recorder = std::make_shared<FlightRecorder>(1024);
+    frontService->setFlightRecorder(recorder);
+
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    int moduleID = 12345;
+
+    std::promise<std::string> p;
+    auto f = p.get_future();
+    frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 0,
+        [&p](Error::Ptr, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string& _uuid,
+            std::function<void(bytesConstRef)>) { p.set_value(_uuid); });
+    auto uuid = frontService->callback().begin()->first;
+    frontService->asyncSendResponse(uuid, moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), [](Error::Ptr) {});
+    BOOST_CHECK_EQUAL(f.get(), uuid);
+
+    auto timelines = FlightRecorder::buildTimelines(recorder->snapshot());
+    auto const& timeline = timelines[FlightRecorder::requestID(uuid)];
+    // request send/receive, response send/receive
+    BOOST_CHECK_EQUAL(timeline.size(), 5);
+    BOOST_CHECK(timeline.front().event == FlightEvent::Send);
+    BOOST_CHECK(timeline.back().event == FlightEvent::Response);
+    BOOST_CHECK_EQUAL(timeline.back().moduleID, moduleID);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_latencyStats)
+{
+    auto frontService = buildFrontService();
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    int moduleID = 12345;
+    std::atomic<int> received(0);
+    frontService->registerModuleMessageDispatcher(
+        moduleID, [&received](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {
+            received++;
+        });
+
+    // no extension, no stats
+    frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 0, CallbackFunc());
+    while (received < 1)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK(frontService->latencyStats()->snapshot().empty());
+
+    frontService->setHeaderExtensionEnabled(true);
+    frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 0, CallbackFunc());
+    while (received < 2)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // the queue time is recorded by the dispatch thread before calling the dispatcher
+    auto entries = frontService->latencyStats()->snapshot();
+    BOOST_CHECK_EQUAL(entries.size(), 1);
+    BOOST_CHECK_EQUAL(entries[0].moduleID, moduleID);
+    BOOST_CHECK_EQUAL(entries[0].nodeID->hex(), dstNodeID->hex());
+    BOOST_CHECK_EQUAL(entries[0].oneWayDelay.count, 1);
+    BOOST_CHECK_EQUAL(entries[0].queueTime.count, 1);
+    BOOST_CHECK_EQUAL(entries[0].maxHops, 0);
+
+    frontService->latencyStats()->reset();
+    BOOST_CHECK(frontService->latencyStats()->snapshot().empty());
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_deadline)
+{
+    auto frontService = buildFrontService();
+    frontService->setHeaderExtensionEnabled(true);
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    int moduleID = 12345;
+    std::atomic<int> received(0);
+    frontService->registerModuleMessageDispatcher(
+        moduleID, [&received](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {
+            received++;
+        });
+
+    // a request which spent longer than its ttl on the way is dropped before dispatch
+    auto encode = [&](uint64_t _sendTime, uint32_t _ttl) {
+        auto message = frontService->messageFactory()->buildMessage();
+        std::string uuid = "uuid";
+        message->setModuleID(moduleID);
+        message->setUuid(std::make_shared<bytes>(uuid.begin(), uuid.end()));
+        message->setPayload(bytesConstRef((unsigned char*)data.data(), data.size()));
+        FrontMessageExtension extension;
+        extension.setTrace(1, _sendTime);
+        extension.setDeadline(_ttl);
+        message->setExtension(extension);
+        bytes buffer;
+        message->encode(buffer);
+        return buffer;
+    };
+    auto expired = encode(utcTimeUs() - 20000, 10);
+    frontService->onReceiveMessage(
+        g_groupID, dstNodeID, bytesConstRef(expired.data(), expired.size()), nullptr);
+    auto valid = encode(utcTimeUs(), 60000);
+    frontService->onReceiveMessage(
+        g_groupID, dstNodeID, bytesConstRef(valid.data(), valid.size()), nullptr);
+    // the clock of the sender far behind, the time on the way is unknown
+    auto skewed = encode(utcTimeUs() - 10000000, 1000);
+    frontService->onReceiveMessage(
+        g_groupID, dstNodeID, bytesConstRef(skewed.data(), skewed.size()), nullptr);
+
+    // the requests sent with a timeout carry it as the deadline
+    std::promise<void> p;
+    frontService->registerModuleMessageDispatcher(moduleID + 1,
+        [&p](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) { p.set_value(); });
+    frontService->asyncSendMessageByNodeID(moduleID + 1, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 10000,
+        [](Error::Ptr, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+            std::function<void(bytesConstRef)>) {});
+    p.get_future().get();
+
+    while (frontService->dispatchQueue()->size() > 0 || received < 2)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(received, 2);
+    BOOST_CHECK_EQUAL(frontService->dispatchQueue()->expired(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_loadShedding)
+{
+    auto frontService = buildFrontService();
+    frontService->setHeaderExtensionEnabled(true);
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    int sheddableModuleID = 1000;
+    int criticalModuleID = 1001;
+    std::atomic<int> dispatched(0);
+    auto dispatcher = [&dispatched](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {
+        dispatched++;
+    };
+    frontService->registerModuleMessageDispatcher(sheddableModuleID, dispatcher);
+    frontService->registerModuleMessageDispatcher(criticalModuleID, dispatcher);
+    auto shedder = frontService->loadShedder();
+    shedder->setSheddable(sheddableModuleID, true);
+
+    // queue delay above the target for a whole interval
+    auto now = utcSteadyTimeUs();
+    shedder->onDequeue(shedder->target() * 10, now);
+    shedder->onDequeue(shedder->target() * 10, now + shedder->interval());
+    BOOST_CHECK(shedder->overloaded());
+
+    auto send = [&](int _moduleID) {
+        auto p = std::make_shared<std::promise<Error::Ptr>>();
+        frontService->asyncSendMessageByNodeID(_moduleID, dstNodeID,
+            bytesConstRef((unsigned char*)data.data(), data.size()), 10000,
+            [p](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) { p->set_value(_error); });
+        return p->get_future();
+    };
+    // rejected at once with the overloaded error
+    auto error = send(sheddableModuleID).get();
+    BOOST_CHECK(error);
+    BOOST_CHECK_EQUAL(error->errorCode(), FrontError::Overloaded);
+    BOOST_CHECK_EQUAL(dispatched, 0);
+    BOOST_CHECK_EQUAL(shedder->shed(), 1);
+
+    // the critical modules are always dispatched
+    auto future = send(criticalModuleID);
+    while (dispatched < 1)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(shedder->shed(), 1);
+    // the quick dispatch ends the overload
+    BOOST_CHECK(!shedder->overloaded());
+    BOOST_CHECK(future.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_loadSheddingIdle)
+{
+    auto frontService = buildFrontService();
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    int moduleID = 1002;
+    std::atomic<int> dispatched(0);
+    frontService->registerModuleMessageDispatcher(
+        moduleID, [&dispatched](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {
+            dispatched++;
+        });
+    auto shedder = frontService->loadShedder();
+    shedder->setSheddable(moduleID, true);
+    auto now = utcSteadyTimeUs();
+    shedder->onDequeue(shedder->target() * 10, now);
+    shedder->onDequeue(shedder->target() * 10, now + 1);
+    shedder->onDequeue(shedder->target() * 10, now + shedder->interval());
+    BOOST_CHECK(shedder->overloaded());
+
+    // only the sheddable requests arrive: shed, and nothing dequeued to end the overload
+    auto send = [&]() {
+        frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+            bytesConstRef((unsigned char*)data.data(), data.size()), 0,
+            [](Error::Ptr, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) {});
+    };
+    send();
+    BOOST_CHECK_EQUAL(shedder->shed(), 1);
+    BOOST_CHECK(shedder->overloaded());
+
+    // the queue stayed empty for an interval
+    std::this_thread::sleep_for(std::chrono::microseconds(shedder->interval() * 2));
+    send();
+    while (dispatched < 1)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK(!shedder->overloaded());
+    BOOST_CHECK_EQUAL(shedder->shed(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_cancelRequest)
+{
+    auto frontService = buildFrontService();
+    frontService->setHeaderExtensionEnabled(true);
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    int moduleID = 12345;
+
+    std::promise<CancellationToken::Ptr> dispatched;
+    std::promise<void> cancelled;
+    frontService->registerModuleCancellableDispatcher(moduleID,
+        [&dispatched, &cancelled](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef,
+            CancellationToken::Ptr _token) {
+            dispatched.set_value(_token);
+            // the expensive work checking the token
+            while (!_token->cancelled())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            cancelled.set_value();
+        });
+
+    std::atomic<int> called(0);
+    auto uuid = frontService->asyncSendRequest(moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 10000,
+        [&called](Error::Ptr, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+            std::function<void(bytesConstRef)>) { called++; });
+    BOOST_CHECK(!uuid.empty());
+    auto token = dispatched.get_future().get();
+    BOOST_CHECK(!token->cancelled());
+    BOOST_CHECK_EQUAL(frontService->cancellationRegistry()->size(), 1);
+
+    // the callback and the timer are removed at once, the responder is notified
+    BOOST_CHECK(frontService->cancelRequest(uuid));
+    BOOST_CHECK(frontService->callback().empty());
+    cancelled.get_future().get();
+    BOOST_CHECK(token->cancelled());
+    BOOST_CHECK_EQUAL(frontService->cancellationRegistry()->size(), 0);
+    BOOST_CHECK(!frontService->cancelRequest(uuid));
+
+    // a late response is dropped
+    frontService->asyncSendResponse(uuid, moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), [](Error::Ptr) {});
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_CHECK_EQUAL(called, 0);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_peerDisconnected)
+{
+    auto frontService = buildFrontService();
+    auto nodeID0 = createKey(g_dstNodeID_0);
+    auto nodeID1 = createKey(g_dstNodeID_1);
+    std::string data(100, '#');
+    // no dispatcher registered, the requests stay pending
+    int moduleID = 12345;
+    frontService->onReceiveNodeIDs(
+        g_groupID, std::make_shared<crypto::NodeIDs>(crypto::NodeIDs{nodeID0, nodeID1}), nullptr);
+
+    std::atomic<int> disconnected(0);
+    auto callback = [&disconnected](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef,
+                        const std::string&, std::function<void(bytesConstRef)>) {
+        if (_error && _error->errorCode() == FrontError::PeerDisconnected)
+        {
+            disconnected++;
+        }
+    };
+    for (int i = 0; i < 3; ++i)
+    {
+        frontService->asyncSendMessageByNodeID(moduleID, nodeID0,
+            bytesConstRef((unsigned char*)data.data(), data.size()), 100000, callback);
+    }
+    auto uuid1 = frontService->asyncSendRequest(moduleID, nodeID1,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 100000, callback);
+    BOOST_CHECK_EQUAL(frontService->pendingRequests(nodeID0).size(), 3);
+    BOOST_CHECK_EQUAL(frontService->pendingRequests(nodeID1).size(), 1);
+
+    // nodeID0 left the node list
+    frontService->onReceiveNodeIDs(
+        g_groupID, std::make_shared<crypto::NodeIDs>(crypto::NodeIDs{nodeID1}), nullptr);
+    while (disconnected < 3)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK(frontService->pendingRequests(nodeID0).empty());
+    BOOST_CHECK_EQUAL(frontService->callback().size(), 1);
+
+    // reported unreachable by the gateway
+    BOOST_CHECK_EQUAL(frontService->onPeerDisconnected(nodeID1), 1);
+    BOOST_CHECK_EQUAL(frontService->onPeerDisconnected(nodeID1), 0);
+    while (disconnected < 4)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK(frontService->callback().empty());
+    BOOST_CHECK(!frontService->cancelRequest(uuid1));
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_circuitBreaker)
+{
+    auto frontService = buildFrontService();
+    frontService->setCircuitBreaker(std::make_shared<PeerCircuitBreaker>(2, 100000));
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    // no dispatcher registered, the requests time out
+    int moduleID = 12345;
+
+    auto send = [&]() {
+        auto p = std::make_shared<std::promise<Error::Ptr>>();
+        frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+            bytesConstRef((unsigned char*)data.data(), data.size()), 20,
+            [p](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) { p->set_value(_error); });
+        return p->get_future().get();
+    };
+    BOOST_CHECK_EQUAL(send()->errorCode(), bcos::protocol::CommonError::TIMEOUT);
+    BOOST_CHECK_EQUAL(send()->errorCode(), bcos::protocol::CommonError::TIMEOUT);
+    BOOST_CHECK(frontService->circuitBreaker()->state(dstNodeID) == BreakerState::Open);
+
+    // failed fast without holding a callback
+    BOOST_CHECK_EQUAL(send()->errorCode(), FrontError::CircuitOpen);
+    BOOST_CHECK(frontService->callback().empty());
+    BOOST_CHECK_EQUAL(frontService->circuitBreaker()->rejected(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_adaptiveTimeout)
+{
+    auto frontService = buildFrontService();
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    int moduleID = 12345;
+    AdaptiveTimeoutPolicy policy;
+    policy.minTimeout = 20;
+    policy.minSamples = 4;
+    frontService->adaptiveTimeout()->setPolicy(policy);
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [frontService, moduleID](
+            bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid, bytesConstRef _data) {
+            frontService->asyncSendResponse(_uuid, moduleID, _nodeID, _data, nullptr);
+        });
+
+    auto send = [&]() {
+        auto p = std::make_shared<std::promise<Error::Ptr>>();
+        frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+            bytesConstRef((unsigned char*)data.data(), data.size()),
+            FrontService::ADAPTIVE_TIMEOUT,
+            [p](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) { p->set_value(_error); });
+        return p->get_future().get();
+    };
+    for (size_t i = 0; i < policy.minSamples; ++i)
+    {
+        BOOST_CHECK(!send());
+    }
+    BOOST_CHECK_EQUAL(
+        frontService->adaptiveTimeout()->estimator(moduleID, dstNodeID).samples(), 4);
+    // the loopback round trips are far below the initial timeout
+    BOOST_CHECK(frontService->adaptiveTimeout()->timeout(moduleID, dstNodeID) <
+                policy.initialTimeout);
+
+    // the unanswered requests time out after the adaptive timeout
+    frontService->unregisterModuleMessageDispatcher(moduleID);
+    auto start = utcSteadyTime();
+    auto error = send();
+    BOOST_CHECK_EQUAL(error->errorCode(), bcos::protocol::CommonError::TIMEOUT);
+    BOOST_CHECK(utcSteadyTime() - start < policy.initialTimeout);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_rateLimit)
+{
+    auto frontService = buildFrontService();
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(1000, 'r');
+    int moduleID = 1003;
+    auto received = std::make_shared<std::atomic<int>>(0);
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [frontService, moduleID, received](
+            bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid, bytesConstRef _data) {
+            (*received)++;
+            frontService->asyncSendResponse(_uuid, moduleID, _nodeID, _data, nullptr);
+        });
+    auto send = [&]() {
+        auto p = std::make_shared<std::promise<Error::Ptr>>();
+        frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+            bytesConstRef((unsigned char*)data.data(), data.size()), 10000,
+            [p](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) { p->set_value(_error); });
+        return p->get_future();
+    };
+
+    RateLimit limit;
+    limit.messagesPerSecond = 20;
+    limit.burstSeconds = 0.1;
+    frontService->rateLimiter()->setLimit(moduleID, limit);
+    BOOST_CHECK(!send().get());
+    BOOST_CHECK(!send().get());
+    auto error = send().get();
+    BOOST_REQUIRE(error);
+    BOOST_CHECK_EQUAL(error->errorCode(), FrontError::RateLimited);
+    BOOST_CHECK_EQUAL(*received, 2);
+
+    // the requests over the budget wait for it
+    limit.overflow = RateLimit::Overflow::Delay;
+    frontService->rateLimiter()->setLimit(moduleID, limit);
+    auto start = utcSteadyTime();
+    std::vector<std::future<Error::Ptr>> futures;
+    for (int i = 0; i < 6; ++i)
+    {
+        futures.emplace_back(send());
+    }
+    for (auto& future : futures)
+    {
+        BOOST_CHECK(!future.get());
+    }
+    // 2 at once and 4 at 50ms intervals
+    BOOST_CHECK(utcSteadyTime() - start >= 190);
+    BOOST_CHECK_EQUAL(*received, 8);
+    auto rates = frontService->rateLimiter()->rates();
+    BOOST_CHECK_EQUAL(rates.size(), 1);
+    BOOST_CHECK_EQUAL(rates[0].delayed, 4);
+    BOOST_CHECK_EQUAL(rates[0].rejected, 1);
+
+    // the broadcasts over the budget are dropped
+    limit.overflow = RateLimit::Overflow::Reject;
+    frontService->rateLimiter()->setLimit(moduleID, limit);
+    for (int i = 0; i < 4; ++i)
+    {
+        frontService->asyncSendBroadcastMessage(
+            moduleID, bytesConstRef((unsigned char*)data.data(), data.size()));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK_EQUAL(*received, 10);
+    frontService->rateLimiter()->removeLimit(moduleID);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_rateLimitVirtualClock)
+{
+    auto gateway = std::make_shared<FakeGateway>();
+    auto clock = std::make_shared<VirtualClock>();
+    auto frontServiceFactory = std::make_shared<FrontServiceFactory>();
+    frontServiceFactory->setThreadPool(std::make_shared<ThreadPool>("frontServiceTest", 4));
+    frontServiceFactory->setGatewayInterface(gateway);
+    frontServiceFactory->setClock(clock);
+    auto frontService = frontServiceFactory->buildFrontService(g_groupID, createKey(g_srcNodeID));
+    frontService->start();
+    gateway->setFrontService(frontService);
+
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, 'r');
+    int moduleID = 1006;
+    auto received = std::make_shared<std::atomic<int>>(0);
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [frontService, moduleID, received](
+            bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid, bytesConstRef _data) {
+            (*received)++;
+            frontService->asyncSendResponse(_uuid, moduleID, _nodeID, _data, nullptr);
+        });
+    auto send = [&]() {
+        auto p = std::make_shared<std::promise<Error::Ptr>>();
+        frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+            bytesConstRef((unsigned char*)data.data(), data.size()), 10000,
+            [p](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) { p->set_value(_error); });
+        return p->get_future();
+    };
+
+    // set without the virtual time, the buckets take the time of the sends
+    RateLimit limit;
+    limit.messagesPerSecond = 10;
+    limit.burstSeconds = 0.1;
+    limit.overflow = RateLimit::Overflow::Delay;
+    frontService->rateLimiter()->setLimit(moduleID, limit);
+    BOOST_CHECK(!send().get());
+    // waits 100ms of the virtual time
+    auto delayed = send();
+    BOOST_CHECK_EQUAL(*received, 1);
+    BOOST_CHECK(delayed.wait_for(std::chrono::milliseconds(10)) != std::future_status::ready);
+    clock->advance(100000);
+    BOOST_CHECK(!delayed.get());
+    BOOST_CHECK_EQUAL(*received, 2);
+
+    // refilled by the virtual time
+    clock->advance(1000000);
+    BOOST_CHECK(!send().get());
+    BOOST_CHECK_EQUAL(*received, 3);
+    BOOST_CHECK_EQUAL(frontService->rateLimiter()->rates(clock->nowUs())[0].delayed, 1);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_rateLimitDelayedDeadline)
+{
+    auto gateway = std::make_shared<FakeGateway>();
+    auto clock = std::make_shared<VirtualClock>();
+    auto frontServiceFactory = std::make_shared<FrontServiceFactory>();
+    frontServiceFactory->setGatewayInterface(gateway);
+    frontServiceFactory->setClock(clock);
+    auto frontService = frontServiceFactory->buildFrontService(g_groupID, createKey(g_srcNodeID));
+    frontService->start();
+    gateway->setFrontService(frontService);
+    frontService->setHeaderExtensionEnabled(true);
+
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, 'r');
+    int moduleID = 1007;
+    auto received = std::make_shared<std::atomic<int>>(0);
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [frontService, moduleID, received](
+            bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid, bytesConstRef _data) {
+            (*received)++;
+            frontService->asyncSendResponse(_uuid, moduleID, _nodeID, _data, nullptr);
+        });
+    auto send = [&](uint32_t _timeout) {
+        auto p = std::make_shared<std::promise<Error::Ptr>>();
+        frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+            bytesConstRef((unsigned char*)data.data(), data.size()), _timeout,
+            [p](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) { p->set_value(_error); });
+        return p->get_future();
+    };
+
+    RateLimit limit;
+    limit.messagesPerSecond = 10;
+    limit.burstSeconds = 0.1;
+    limit.overflow = RateLimit::Overflow::Delay;
+    frontService->rateLimiter()->setLimit(moduleID, limit);
+    auto path = "front-deadline-" + std::to_string(utcTime()) + ".bin";
+    frontService->setFrameCapture(std::make_shared<FrameCapture>(path, 1024 * 1024));
+    BOOST_CHECK(!send(10000).get());
+    // delayed by 100ms, the deadline keeps running meanwhile
+    auto delayed = send(10000);
+    clock->advance(100000);
+    BOOST_CHECK(!delayed.get());
+    frontService->frameCapture()->close();
+    frontService->setFrameCapture(nullptr);
+    std::vector<uint32_t> ttls;
+    {
+        FrameTrace trace(path);
+        for (auto const& frame : trace.frames())
+        {
+            auto message = frontService->messageFactory()->buildMessage();
+            BOOST_CHECK(message->decode(frame.frame) >= 0);
+            if (message->extension().hasDeadline())
+            {
+                ttls.push_back(message->extension().ttl);
+            }
+        }
+    }
+    std::remove(path.c_str());
+    BOOST_REQUIRE_EQUAL(ttls.size(), 2);
+    BOOST_CHECK_EQUAL(ttls[0], 10000);
+    BOOST_CHECK_EQUAL(ttls[1], 9900);
+
+    // timed out before the budget is refilled, the delayed send is dropped
+    auto expired = send(50);
+    clock->advance(50000);
+    auto error = expired.get();
+    BOOST_REQUIRE(error);
+    BOOST_CHECK_EQUAL(error->errorCode(), bcos::protocol::CommonError::TIMEOUT);
+    clock->advance(50000);
+    BOOST_CHECK_EQUAL(*received, 2);
+    BOOST_CHECK_EQUAL(frontService->rateLimiter()->rates(clock->nowUs())[0].delayed, 2);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_memoryAccounting)
+{
+    auto frontService = buildFrontService();
+    auto accountant = frontService->memoryAccountant();
+    frontService->setHeaderExtensionEnabled(true);
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(1000, 'm');
+    int moduleID = 1004;
+    auto release = std::make_shared<std::promise<void>>();
+    auto released = release->get_future().share();
+    auto dispatched = std::make_shared<std::atomic<int>>(0);
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [frontService, moduleID, released, dispatched](
+            bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid, bytesConstRef _data) {
+            (*dispatched)++;
+            released.wait();
+            frontService->asyncSendResponse(_uuid, moduleID, _nodeID, _data, nullptr);
+        });
+    auto send = [&]() {
+        auto p = std::make_shared<std::promise<Error::Ptr>>();
+        frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+            bytesConstRef((unsigned char*)data.data(), data.size()), 10000,
+            [p](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) { p->set_value(_error); });
+        return p->get_future();
+    };
+
+    // the pending requests and the queued payloads are accounted
+    std::vector<std::future<Error::Ptr>> futures;
+    for (int i = 0; i < 4; ++i)
+    {
+        futures.emplace_back(send());
+    }
+    while (*dispatched < 4)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK(accountant->used(moduleID, MemoryDirection::Outbound) > 0);
+    BOOST_CHECK_EQUAL(accountant->used(moduleID, MemoryDirection::Inbound), 4 * data.size());
+
+    // the inbound requests of a sheddable module are shed above the high-water mark
+    MemoryLimit limit;
+    limit.highWaterMark = 4 * data.size();
+    accountant->setLimit(MemoryDirection::Inbound, limit);
+    frontService->loadShedder()->setSheddable(moduleID, true);
+    auto error = send().get();
+    BOOST_REQUIRE(error);
+    BOOST_CHECK_EQUAL(error->errorCode(), FrontError::Overloaded);
+    BOOST_CHECK_EQUAL(accountant->rejected(MemoryDirection::Inbound), 1);
+
+    // the outbound requests fail above the hard limit
+    limit.hardLimit = accountant->used(MemoryDirection::Outbound) + 1;
+    accountant->setLimit(MemoryDirection::Outbound, limit);
+    error = send().get();
+    BOOST_REQUIRE(error);
+    BOOST_CHECK_EQUAL(error->errorCode(), FrontError::MemoryExhausted);
+
+    release->set_value();
+    for (auto& future : futures)
+    {
+        BOOST_CHECK(!future.get());
+    }
+    // all released once the responses are handled
+    for (int i = 0; i < 100 && (accountant->used(MemoryDirection::Inbound) ||
+                                   accountant->used(MemoryDirection::Outbound));
+         ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Inbound), 0);
+    BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Outbound), 0);
+    BOOST_CHECK(accountant->peak(MemoryDirection::Inbound) >= 4 * data.size());
+    accountant->setLimit(MemoryDirection::Inbound, MemoryLimit());
+    accountant->setLimit(MemoryDirection::Outbound, MemoryLimit());
+
+    // without accountant nothing is charged nor rejected
+    frontService->setMemoryAccountant(nullptr);
+    limit.hardLimit = 1;
+    accountant->setLimit(MemoryDirection::Outbound, limit);
+    BOOST_CHECK(!send().get());
+    BOOST_CHECK_EQUAL(accountant->rejected(MemoryDirection::Outbound), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_inlineDispatcher)
+{
+    auto frontService = buildFrontService();
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, 'v');
+    int moduleID = 1015;
+
+    // run on the thread receiving the frame, the fake gateway receives on the sending thread
+    std::atomic<int> received(0);
+    auto sender = std::this_thread::get_id();
+    frontService->registerModuleInlineDispatcher(moduleID,
+        [&received, sender, data](
+            bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef _data) {
+            BOOST_CHECK(std::this_thread::get_id() == sender);
+            BOOST_CHECK_EQUAL(_data.toString(), data);
+            received++;
+        },
+        // a budget no loaded test host overruns
+        1000000);
+    for (int i = 0; i < 10; ++i)
+    {
+        frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+            bytesConstRef((byte*)data.data(), data.size()), 0, CallbackFunc());
+    }
+    BOOST_CHECK_EQUAL(received, 10);
+    // neither copied nor queued
+    BOOST_CHECK_EQUAL(frontService->memoryAccountant()->peak(MemoryDirection::Inbound), 0);
+    BOOST_CHECK_EQUAL(frontService->inlineWatchdog()->overruns(), 0);
+
+    // over the budget
+    frontService->registerModuleInlineDispatcher(
+        moduleID,
+        [&received](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            received++;
+        },
+        1000);
+    frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+        bytesConstRef((byte*)data.data(), data.size()), 0, CallbackFunc());
+    BOOST_CHECK_EQUAL(received, 11);
+    BOOST_CHECK_EQUAL(frontService->inlineWatchdog()->overruns(), 1);
+    auto overruns = frontService->inlineWatchdog()->snapshot();
+    BOOST_CHECK_EQUAL(overruns.size(), 1);
+    BOOST_CHECK_EQUAL(overruns[0].moduleID, moduleID);
+    BOOST_CHECK(overruns[0].maxElapsed >= 2000);
+
+    // back to the thread pool
+    std::promise<std::thread::id> promise;
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [&promise](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {
+            promise.set_value(std::this_thread::get_id());
+        });
+    frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+        bytesConstRef((byte*)data.data(), data.size()), 0, CallbackFunc());
+    BOOST_CHECK(promise.get_future().get() != sender);
+    BOOST_CHECK_EQUAL(received, 11);
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_onReceiveMessages)
+{
+    auto frontService = buildFrontService();
+    auto srcNodeID = createKey(g_dstNodeID_0);
+    int moduleA = 1016;
+    int moduleB = 1017;
+    int inlineModule = 1018;
+
+    std::vector<bytes> frames;
+    auto addFrame = [&](int _moduleID, const std::string& _data) {
+        auto message = frontService->messageFactory()->buildMessage();
+        message->setModuleID(_moduleID);
+        std::string uuid = "uuid-" + _data;
+        message->setUuid(std::make_shared<bytes>(uuid.begin(), uuid.end()));
+        message->setPayload(bytesConstRef((byte*)_data.data(), _data.size()));
+        frames.emplace_back();
+        message->encode(frames.back());
+    };
+    for (int i = 0; i < 50; ++i)
+    {
+        addFrame(i % 2 ? moduleA : moduleB, std::to_string(i));
+    }
+    addFrame(inlineModule, "inline");
+    // a broken frame does not stop the others
+    frames.emplace_back(bytes(3, 0xff));
+
+    std::mutex mutex;
+    std::map<int, std::vector<int>> received;
+    std::map<int, std::set<std::thread::id>> threads;
+    std::promise<void> done;
+    auto dispatcher = [&](int _moduleID) {
+        return [&, _moduleID](bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid,
+                   bytesConstRef _data) {
+            BOOST_CHECK_EQUAL(_nodeID->hex(), srcNodeID->hex());
+            BOOST_CHECK_EQUAL(_uuid, "uuid-" + _data.toString());
+            Guard l(mutex);
+            received[_moduleID].push_back(std::stoi(_data.toString()));
+            threads[_moduleID].insert(std::this_thread::get_id());
+            if (received[moduleA].size() + received[moduleB].size() == 50)
+            {
+                done.set_value();
+            }
+        };
+    };
+    frontService->registerModuleMessageDispatcher(moduleA, dispatcher(moduleA));
+    frontService->registerModuleMessageDispatcher(moduleB, dispatcher(moduleB));
+    std::atomic<int> inlined(0);
+    frontService->registerModuleInlineDispatcher(inlineModule,
+        [&inlined](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) { inlined++; });
+
+    std::vector<std::pair<bcos::crypto::NodeIDPtr, bytesConstRef>> batch;
+    for (auto const& frame : frames)
+    {
+        batch.emplace_back(srcNodeID, bytesConstRef(frame.data(), frame.size()));
+    }
+    std::promise<void> acked;
+    std::atomic<int> acks(0);
+    frontService->onReceiveMessages(g_groupID, batch, [&](Error::Ptr _error) {
+        BOOST_CHECK(_error == nullptr);
+        if (++acks == 1)
+        {
+            acked.set_value();
+        }
+    });
+    BOOST_CHECK_EQUAL(inlined, 1);
+    done.get_future().get();
+    acked.get_future().get();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_CHECK_EQUAL(acks, 1);
+
+    // one task per module, the messages in the received order
+    Guard l(mutex);
+    for (auto moduleID : {moduleA, moduleB})
+    {
+        BOOST_CHECK_EQUAL(received[moduleID].size(), 25);
+        BOOST_CHECK(std::is_sorted(received[moduleID].begin(), received[moduleID].end()));
+        BOOST_CHECK_EQUAL(threads[moduleID].size(), 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_completion)
+{
+    auto frontService = buildFrontService();
+    auto dstNodeID = createKey(g_dstNodeID_0);
+    std::string data(100, '#');
+    std::string response(64, 'r');
+    int moduleID = 1019;
+    auto testThread = std::this_thread::get_id();
+
+    std::mutex mutex;
+    std::vector<std::thread::id> threads;
+    std::vector<std::string> payloads;
+    std::vector<int> errors;
+    auto callback = [&](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef _data,
+                        const std::string&, std::function<void(bytesConstRef)>) {
+        Guard l(mutex);
+        threads.push_back(std::this_thread::get_id());
+        payloads.push_back(_data.toString());
+        errors.push_back(_error ? _error->errorCode() : 0);
+    };
+    auto sendAndRespond = [&](const Completion& _completion) {
+        auto uuid = frontService->asyncSendRequest(moduleID, dstNodeID,
+            bytesConstRef((unsigned char*)data.data(), data.size()), 10000, callback,
+            _completion);
+        BOOST_CHECK(!uuid.empty());
+        frontService->asyncSendResponse(uuid, moduleID, dstNodeID,
+            bytesConstRef((unsigned char*)response.data(), response.size()), [](Error::Ptr) {});
+    };
+
+    // inline: on the thread receiving the response, before the response is sent back
+    sendAndRespond(Completion::inlined());
+    {
+        Guard l(mutex);
+        BOOST_CHECK_EQUAL(threads.size(), 1);
+        BOOST_CHECK(threads[0] == testThread);
+        BOOST_CHECK_EQUAL(payloads[0], response);
+    }
+
+    // caller: one task posted to the caller, the payload outlives the received frame
+    std::vector<FrontExecutor::Task> posted;
+    sendAndRespond(Completion::caller(
+        [&posted](FrontExecutor::Task _task) { posted.push_back(std::move(_task)); }));
+    BOOST_CHECK_EQUAL(posted.size(), 1);
+    BOOST_CHECK_EQUAL(threads.size(), 1);
+    posted[0]();
+    {
+        Guard l(mutex);
+        BOOST_CHECK_EQUAL(threads.size(), 2);
+        BOOST_CHECK(threads[1] == testThread);
+        BOOST_CHECK_EQUAL(payloads[1], response);
+    }
+
+    // pool: a task of the front executor
+    std::promise<void> pooled;
+    auto pooledCallback = [&](Error::Ptr _error, bcos::crypto::NodeIDPtr _nodeID,
+                              bytesConstRef _data, const std::string& _uuid,
+                              std::function<void(bytesConstRef)> _respFunc) {
+        callback(_error, _nodeID, _data, _uuid, _respFunc);
+        pooled.set_value();
+    };
+    auto uuid = frontService->asyncSendRequest(moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 10000, pooledCallback);
+    frontService->asyncSendResponse(uuid, moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)response.data(), response.size()), [](Error::Ptr) {});
+    pooled.get_future().get();
+    {
+        Guard l(mutex);
+        BOOST_CHECK(threads[2] != testThread);
+        BOOST_CHECK_EQUAL(payloads[2], response);
+    }
+
+    // the timeouts and the failures follow the policy too
+    posted.clear();
+    frontService->asyncSendMessageByNodeID(moduleID, dstNodeID,
+        bytesConstRef((unsigned char*)data.data(), data.size()), 1, callback,
+        Completion::caller(
+            [&mutex, &posted](FrontExecutor::Task _task) {
+                Guard l(mutex);
+                posted.push_back(std::move(_task));
+            }));
+    while (true)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        Guard l(mutex);
+        if (!posted.empty())
+        {
+            break;
+        }
+    }
+    posted[0]();
+    BOOST_CHECK_EQUAL(errors.back(), bcos::protocol::CommonError::TIMEOUT);
+    BOOST_CHECK(threads.back() == testThread);
+
+    BOOST_CHECK_THROW(frontService->asyncSendRequest(moduleID, dstNodeID,
+                          bytesConstRef((unsigned char*)data.data(), data.size()), 10000,
+                          callback, Completion::caller(Completion::Post())),
+        InvalidParameter);
+    BOOST_CHECK(frontService->callback().empty());
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_sendFrame)
+{
+    auto frontService = buildFrontService();
+    frontService->setHeaderExtensionEnabled(true);
+    int moduleID = 1020;
+    std::string payload(4096, 'f');
+    auto frame =
+        frontService->encodeFrame(moduleID, bytesConstRef((byte*)payload.data(), payload.size()));
+
+    std::vector<std::string> uuids;
+    bool resent = false;
+    // the loopback gateway dispatches inline, inside the send of the frame
+    frontService->registerModuleInlineDispatcher(moduleID,
+        [&](bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid, bytesConstRef _data) {
+            BOOST_CHECK_EQUAL(_data.toString(), payload);
+            uuids.push_back(_uuid);
+            if (!resent)
+            {
+                // overlaps the send in flight, copied
+                resent = true;
+                frontService->asyncSendFrame(frame, _nodeID, 0, CallbackFunc());
+            }
+            std::string response = "ok";
+            frontService->asyncSendResponse(_uuid, moduleID, _nodeID,
+                bytesConstRef((byte*)response.data(), response.size()), [](Error::Ptr) {});
+        });
+
+    std::vector<std::string> responses;
+    for (auto const& dst : {g_dstNodeID_0, g_dstNodeID_1, g_dstNodeID_0})
+    {
+        auto uuid = frontService->asyncSendFrame(frame, createKey(dst), 10000,
+            [&responses](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef _data,
+                const std::string&, std::function<void(bytesConstRef)>) {
+                BOOST_CHECK(_error == nullptr);
+                responses.push_back(_data.toString());
+            },
+            Completion::inlined());
+        BOOST_CHECK(!uuid.empty());
+    }
+    BOOST_CHECK_EQUAL(uuids.size(), 4);
+    BOOST_CHECK_EQUAL(std::set<std::string>(uuids.begin(), uuids.end()).size(), 4);
+    BOOST_CHECK_EQUAL(responses.size(), 3);
+    BOOST_CHECK(responses == std::vector<std::string>(3, "ok"));
+    BOOST_CHECK(frontService->callback().empty());
+    BOOST_CHECK_EQUAL(frame->patched(), 3);
+    BOOST_CHECK_EQUAL(frame->copied(), 1);
+    BOOST_CHECK_EQUAL(frame->payload().toString(), payload);
+}
+
 BOOST_AUTO_TEST_CASE(testFrontService_asyncSendMessageByNodeIDcmak_timeout)
 {
     auto frontService = buildFrontService();
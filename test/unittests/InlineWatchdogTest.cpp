@@ -0,0 +1,95 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the watchdog of the inline dispatchers
+ * @file InlineWatchdogTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/InlineWatchdog.h>
+#include <boost/test/unit_test.hpp>
+#include <future>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+BOOST_FIXTURE_TEST_SUITE(InlineWatchdogTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testInlineWatchdog_overrun)
+{
+    InlineWatchdog watchdog;
+    for (int i = 0; i < 3; ++i)
+    {
+        InlineWatchdog::Scope scope(watchdog, 1, 1000 * 1000);
+    }
+    BOOST_CHECK_EQUAL(watchdog.overruns(), 0);
+    BOOST_CHECK(watchdog.snapshot().empty());
+
+    for (uint16_t moduleID : {2, 1, 2})
+    {
+        InlineWatchdog::Scope scope(watchdog, moduleID, 100);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(watchdog.overruns(), 3);
+    auto overruns = watchdog.snapshot();
+    BOOST_CHECK_EQUAL(overruns.size(), 2);
+    BOOST_CHECK_EQUAL(overruns[0].moduleID, 1);
+    BOOST_CHECK_EQUAL(overruns[0].count, 1);
+    BOOST_CHECK_EQUAL(overruns[1].moduleID, 2);
+    BOOST_CHECK_EQUAL(overruns[1].count, 2);
+    BOOST_CHECK(overruns[1].maxElapsed >= 1000);
+}
+
+BOOST_AUTO_TEST_CASE(testInlineWatchdog_scan)
+{
+    InlineWatchdog watchdog;
+    std::promise<void> entered;
+    std::promise<void> leave;
+    auto leaveFuture = leave.get_future().share();
+    // a dispatch blocked on another thread
+    std::thread blocked([&]() {
+        InlineWatchdog::Scope scope(watchdog, 7, 500 * 1000);
+        entered.set_value();
+        leaveFuture.wait();
+    });
+    entered.get_future().wait();
+    auto now = utcSteadyTimeUs();
+    BOOST_CHECK_EQUAL(watchdog.scan(now), 0);
+    // reported once while running
+    BOOST_CHECK_EQUAL(watchdog.scan(now + 1000 * 1000), 1);
+    BOOST_CHECK_EQUAL(watchdog.scan(now + 2000 * 1000), 0);
+    BOOST_CHECK_EQUAL(watchdog.overruns(), 0);
+
+    leave.set_value();
+    blocked.join();
+    BOOST_CHECK_EQUAL(watchdog.scan(now + 3000 * 1000), 0);
+
+    // more concurrent dispatches than slots are measured once finished
+    std::vector<std::unique_ptr<InlineWatchdog::Scope>> scopes;
+    for (size_t i = 0; i < InlineWatchdog::SLOT_COUNT + 1; ++i)
+    {
+        scopes.emplace_back(std::make_unique<InlineWatchdog::Scope>(watchdog, 8, 0));
+    }
+    BOOST_CHECK_EQUAL(watchdog.scan(utcSteadyTimeUs() + 1000), InlineWatchdog::SLOT_COUNT);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    scopes.clear();
+    BOOST_CHECK_EQUAL(watchdog.overruns(), InlineWatchdog::SLOT_COUNT + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the load shedder
+ * @file LoadShedderTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/LoadShedder.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+BOOST_FIXTURE_TEST_SUITE(LoadShedderTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testLoadShedder_codel)
+{
+    LoadShedder shedder(5000, 100000);
+    uint64_t now = 1000000;
+    shedder.setSheddable(7, true);
+    shedder.setSheddable(65535, true);
+    BOOST_CHECK(shedder.sheddable(7));
+    BOOST_CHECK(shedder.sheddable(65535));
+    BOOST_CHECK(!shedder.sheddable(8));
+
+    // above the target for less than an interval
+    shedder.onDequeue(6000, now);
+    shedder.onDequeue(50000, now + 99999);
+    BOOST_CHECK(!shedder.overloaded());
+    BOOST_CHECK(!shedder.shouldShed(7));
+    // one request below the target resets the interval
+    shedder.onDequeue(4999, now + 99999);
+    shedder.onDequeue(6000, now + 100000);
+    BOOST_CHECK(!shedder.overloaded());
+
+    // above the target for a whole interval
+    shedder.onDequeue(6000, now + 200000);
+    BOOST_CHECK(shedder.overloaded());
+    BOOST_CHECK(shedder.shouldShed(7));
+    // critical module never shed
+    BOOST_CHECK(!shedder.shouldShed(8));
+    BOOST_CHECK_EQUAL(shedder.shed(), 1);
+
+    // recovered by the first request below the target
+    shedder.onDequeue(100, now + 200001);
+    BOOST_CHECK(!shedder.overloaded());
+    BOOST_CHECK(!shedder.shouldShed(7));
+
+    shedder.setSheddable(7, false);
+    BOOST_CHECK(!shedder.sheddable(7));
+    BOOST_CHECK(shedder.sheddable(65535));
+}
+
+BOOST_AUTO_TEST_CASE(testLoadShedder_idle)
+{
+    LoadShedder shedder(5000, 100000);
+    uint64_t now = 1000000;
+    shedder.onDequeue(6000, now);
+    shedder.onDequeue(6000, now + 100000);
+    BOOST_CHECK(shedder.overloaded());
+
+    // the queue just drained, may fill again at once
+    shedder.onIdle(now + 199999);
+    BOOST_CHECK(shedder.overloaded());
+    // nothing dequeued for an interval
+    shedder.onIdle(now + 200000);
+    BOOST_CHECK(!shedder.overloaded());
+
+    // the interval starts again from scratch
+    shedder.onDequeue(6000, now + 300000);
+    shedder.onDequeue(6000, now + 399999);
+    BOOST_CHECK(!shedder.overloaded());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the memory accounting of the front
+ * @file MemoryAccountantTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/MemoryAccountant.h>
+#include <boost/test/unit_test.hpp>
+#include <mutex>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+BOOST_FIXTURE_TEST_SUITE(MemoryAccountantTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testMemoryAccountant)
+{
+    auto accountant = std::make_shared<MemoryAccountant>();
+    {
+        auto ticket0 = accountant->charge(1, MemoryDirection::Inbound, 100);
+        auto ticket1 = accountant->charge(1, MemoryDirection::Outbound, 30);
+        auto ticket2 = accountant->charge(2, MemoryDirection::Inbound, 50);
+        BOOST_CHECK_EQUAL(ticket0->bytes(), 100);
+        BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Inbound), 150);
+        BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Outbound), 30);
+        BOOST_CHECK_EQUAL(accountant->used(1, MemoryDirection::Inbound), 100);
+        BOOST_CHECK_EQUAL(accountant->used(2, MemoryDirection::Outbound), 0);
+
+        auto modules = accountant->snapshot();
+        BOOST_CHECK_EQUAL(modules.size(), 2);
+        BOOST_CHECK_EQUAL(modules[0].moduleID, 1);
+        BOOST_CHECK_EQUAL(modules[0].inbound, 100);
+        BOOST_CHECK_EQUAL(modules[0].outbound, 30);
+        BOOST_CHECK_EQUAL(modules[1].inbound, 50);
+
+        ticket0.reset();
+        BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Inbound), 50);
+        BOOST_CHECK_EQUAL(accountant->peak(MemoryDirection::Inbound), 150);
+    }
+    BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Inbound), 0);
+    BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Outbound), 0);
+    BOOST_CHECK(accountant->snapshot().empty());
+
+    // no limit by default
+    BOOST_CHECK(accountant->admit(1, MemoryDirection::Inbound, 1ULL << 40, true));
+    MemoryLimit limit;
+    limit.highWaterMark = 100;
+    limit.hardLimit = 200;
+    accountant->setLimit(MemoryDirection::Inbound, limit);
+    BOOST_CHECK_EQUAL(accountant->limit(MemoryDirection::Inbound).hardLimit, 200);
+    auto ticket = accountant->charge(1, MemoryDirection::Inbound, 90);
+    BOOST_CHECK(accountant->admit(1, MemoryDirection::Inbound, 10, true));
+    // the sheddable modules give way at the high-water mark, the others at the hard limit
+    BOOST_CHECK(!accountant->admit(1, MemoryDirection::Inbound, 20, true));
+    BOOST_CHECK(accountant->admit(1, MemoryDirection::Inbound, 20, false));
+    BOOST_CHECK(!accountant->admit(1, MemoryDirection::Inbound, 120, false));
+    BOOST_CHECK_EQUAL(accountant->rejected(MemoryDirection::Inbound), 2);
+    // the limits are per direction
+    BOOST_CHECK(accountant->admit(1, MemoryDirection::Outbound, 1000, true));
+    BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Outbound), 0);
+
+    // the admitted bytes are reserved until the ticket is destroyed
+    auto reservation = accountant->admit(2, MemoryDirection::Inbound, 60, false);
+    BOOST_REQUIRE(reservation);
+    BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Inbound), 150);
+    BOOST_CHECK_EQUAL(accountant->used(2, MemoryDirection::Inbound), 60);
+    BOOST_CHECK(!accountant->admit(1, MemoryDirection::Inbound, 60, false));
+    BOOST_CHECK_EQUAL(accountant->rejected(MemoryDirection::Inbound), 3);
+
+    // a part of the reservation held longer, the rest resized to what is held
+    auto part = reservation->split(20);
+    BOOST_CHECK_EQUAL(part->bytes(), 20);
+    BOOST_CHECK_EQUAL(reservation->bytes(), 40);
+    reservation->resize(45);
+    BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Inbound), 155);
+    reservation.reset();
+    BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Inbound), 110);
+    BOOST_CHECK_EQUAL(accountant->used(2, MemoryDirection::Inbound), 20);
+    part.reset();
+    ticket.reset();
+    BOOST_CHECK_EQUAL(accountant->used(MemoryDirection::Inbound), 0);
+    BOOST_CHECK(accountant->snapshot().empty());
+}
+
+BOOST_AUTO_TEST_CASE(testMemoryAccountant_concurrentAdmit)
+{
+    auto accountant = std::make_shared<MemoryAccountant>();
+    MemoryLimit limit;
+    limit.hardLimit = 1000;
+    accountant->setLimit(MemoryDirection::Outbound, limit);
+    // the admits racing for the last bytes never overshoot the limit
+    std::vector<std::thread> threads;
+    std::mutex x_tickets;
+    std::vector<MemoryAccountant::Ticket::Ptr> tickets;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 100; ++j)
+            {
+                auto ticket = accountant->admit(1, MemoryDirection::Outbound, 10, false);
+                if (ticket)
+                {
+                    std::lock_guard<std::mutex> l(x_tickets);
+                    tickets.emplace_back(ticket);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(tickets.size(), 100);
+    BOOST_CHECK_EQUAL(accountant->peak(MemoryDirection::Outbound), 1000);
+    BOOST_CHECK_EQUAL(accountant->rejected(MemoryDirection::Outbound), 300);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
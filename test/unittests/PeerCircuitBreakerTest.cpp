@@ -0,0 +1,92 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the per peer circuit breaker
+ * @file PeerCircuitBreakerTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/PeerCircuitBreaker.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+BOOST_FIXTURE_TEST_SUITE(PeerCircuitBreakerTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testPeerCircuitBreaker_states)
+{
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto nodeID = keyFactory->createKey(bytesConstRef((const byte*)"node0", 5));
+    auto other = keyFactory->createKey(bytesConstRef((const byte*)"node1", 5));
+    PeerCircuitBreaker breaker(3, 1000);
+    std::vector<std::pair<BreakerState, BreakerState>> changes;
+    breaker.setStateChangeHandler(
+        [&changes](const bcos::crypto::NodeIDPtr&, BreakerState _from, BreakerState _to) {
+            changes.emplace_back(_from, _to);
+        });
+
+    uint64_t now = 10000;
+    BOOST_CHECK(breaker.allowRequest(nodeID, now));
+    breaker.onFailure(nodeID, now);
+    breaker.onFailure(nodeID, now);
+    // a success resets the consecutive failures
+    breaker.onSuccess(nodeID);
+    breaker.onFailure(nodeID, now);
+    breaker.onFailure(nodeID, now);
+    BOOST_CHECK(breaker.state(nodeID) == BreakerState::Closed);
+    breaker.onFailure(nodeID, now);
+    BOOST_CHECK(breaker.state(nodeID) == BreakerState::Open);
+    BOOST_CHECK(!breaker.allowRequest(nodeID, now + 999));
+    BOOST_CHECK(breaker.allowRequest(other, now + 999));
+    BOOST_CHECK_EQUAL(breaker.rejected(), 1);
+
+    // one probe after the interval
+    BOOST_CHECK(breaker.allowRequest(nodeID, now + 1000));
+    BOOST_CHECK(breaker.state(nodeID) == BreakerState::HalfOpen);
+    BOOST_CHECK(!breaker.allowRequest(nodeID, now + 1001));
+    // the probe failed
+    breaker.onFailure(nodeID, now + 1100);
+    BOOST_CHECK(breaker.state(nodeID) == BreakerState::Open);
+    BOOST_CHECK(!breaker.allowRequest(nodeID, now + 2000));
+
+    // the probe lost without outcome is replaced after the interval
+    BOOST_CHECK(breaker.allowRequest(nodeID, now + 2100));
+    BOOST_CHECK(!breaker.allowRequest(nodeID, now + 3099));
+    BOOST_CHECK(breaker.allowRequest(nodeID, now + 3100));
+    auto status = breaker.snapshot();
+    BOOST_CHECK_EQUAL(status.size(), 1);
+    BOOST_CHECK(status[0].state == BreakerState::HalfOpen);
+    BOOST_CHECK_EQUAL(status[0].consecutiveFailures, 4);
+
+    // the probe succeeded
+    breaker.onSuccess(nodeID);
+    BOOST_CHECK(breaker.state(nodeID) == BreakerState::Closed);
+    BOOST_CHECK(breaker.snapshot().empty());
+    BOOST_CHECK(breaker.allowRequest(nodeID, now + 3101));
+
+    BOOST_CHECK_EQUAL(breaker.transitions(BreakerState::Open), 2);
+    BOOST_CHECK_EQUAL(breaker.transitions(BreakerState::HalfOpen), 2);
+    BOOST_CHECK_EQUAL(breaker.transitions(BreakerState::Closed), 1);
+    BOOST_CHECK_EQUAL(changes.size(), 5);
+    BOOST_CHECK(changes.back().first == BreakerState::HalfOpen);
+    BOOST_CHECK(changes.back().second == BreakerState::Closed);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
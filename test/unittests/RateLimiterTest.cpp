@@ -0,0 +1,120 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the outbound rate limiter
+ * @file RateLimiterTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/RateLimiter.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+BOOST_FIXTURE_TEST_SUITE(RateLimiterTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testTokenBucket)
+{
+    // 10 tokens per second, burst of 5
+    TokenBucket bucket(10, 5, 0);
+    BOOST_CHECK_EQUAL(bucket.tokens(0), 5);
+    BOOST_CHECK_EQUAL(bucket.waitTime(5, 0), 0);
+    bucket.consume(5, 0);
+    BOOST_CHECK_EQUAL(bucket.waitTime(1, 0), 100000);
+    // half refilled after 250ms
+    BOOST_CHECK_CLOSE(bucket.tokens(250000), 2.5, 0.001);
+    // never above the burst
+    BOOST_CHECK_EQUAL(bucket.tokens(10000000), 5);
+    // the debt delays the next consumers
+    bucket.consume(8, 10000000);
+    BOOST_CHECK_EQUAL(bucket.waitTime(1, 10000000), 400000);
+    // larger than the burst, goes once the bucket is full
+    BOOST_CHECK_EQUAL(bucket.waitTime(100, 20000000), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testOutboundRateLimiter)
+{
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto node0 = keyFactory->createKey(bytesConstRef((const byte*)"node0", 5));
+    auto node1 = keyFactory->createKey(bytesConstRef((const byte*)"node1", 5));
+    OutboundRateLimiter limiter;
+    BOOST_CHECK(limiter.empty());
+    BOOST_CHECK(limiter.admit(1, node0, 1000000, 0).admitted);
+
+    RateLimit limit;
+    limit.messagesPerSecond = 100;
+    limit.bytesPerSecond = 10000;
+    limiter.setLimit(1, limit);
+    BOOST_CHECK(!limiter.empty());
+    BOOST_CHECK(limiter.limited(1));
+    BOOST_CHECK(!limiter.limited(2));
+    auto now = utcSteadyTimeUs();
+    // 10000 bytes of burst
+    for (int i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK(limiter.admit(1, node0, 1000, now).admitted);
+    }
+    auto admission = limiter.admit(1, node1, 1000, now);
+    BOOST_CHECK(!admission.admitted);
+    // other modules are not limited
+    BOOST_CHECK(limiter.admit(2, node0, 1000, now).admitted);
+
+    // delay instead of rejecting
+    limit.overflow = RateLimit::Overflow::Delay;
+    limit.maxDelay = 250;
+    limiter.setLimit(1, limit);
+    now = utcSteadyTimeUs();
+    for (int i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK_EQUAL(limiter.admit(1, node0, 1000, now).delay, 0);
+    }
+    // the delays queue up behind each other
+    BOOST_CHECK_EQUAL(limiter.admit(1, node0, 1000, now).delay, 100000);
+    BOOST_CHECK_EQUAL(limiter.admit(1, node0, 1000, now).delay, 200000);
+    // waiting longer than maxDelay
+    BOOST_CHECK(!limiter.admit(1, node0, 1000, now).admitted);
+
+    // per destination budgets
+    limit.perDestination = true;
+    limit.overflow = RateLimit::Overflow::Reject;
+    limiter.setLimit(1, limit);
+    now = utcSteadyTimeUs();
+    BOOST_CHECK(limiter.admit(1, node0, 10000, now).admitted);
+    BOOST_CHECK(!limiter.admit(1, node0, 1, now).admitted);
+    BOOST_CHECK(limiter.admit(1, node1, 10000, now).admitted);
+    BOOST_CHECK(limiter.admit(1, nullptr, 10000, now).admitted);
+
+    auto rates = limiter.rates(now + 1000000);
+    BOOST_CHECK_EQUAL(rates.size(), 1);
+    BOOST_CHECK_EQUAL(rates[0].moduleID, 1);
+    BOOST_CHECK_EQUAL(rates[0].delayed, 2);
+    BOOST_CHECK_EQUAL(rates[0].rejected, 3);
+    BOOST_CHECK(rates[0].messagesPerSecond > 0);
+    // nothing sent since the previous export
+    rates = limiter.rates(now + 2000000);
+    BOOST_CHECK_EQUAL(rates[0].messagesPerSecond, 0);
+    BOOST_CHECK_EQUAL(rates[0].bytesPerSecond, 0);
+
+    limiter.removeLimit(1);
+    BOOST_CHECK(limiter.empty());
+    BOOST_CHECK(limiter.rates().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
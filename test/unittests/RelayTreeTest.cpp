@@ -0,0 +1,292 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the relay tree broadcast
+ * @file RelayTreeTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include "FakeGateway.h"
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/FrontServiceFactory.h>
+#include <bcos-front/RelayTree.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+using namespace bcos::front::test;
+
+namespace
+{
+// route the frames between the front services of a group, counting the frames each node sends
+class MeshGateway : public FakeGateway
+{
+public:
+    using Ptr = std::shared_ptr<MeshGateway>;
+    using Mesh = std::map<std::string, FrontService::Ptr>;
+
+    explicit MeshGateway(std::shared_ptr<Mesh> _mesh) : m_mesh(_mesh) {}
+
+    void asyncSendMessageByNodeIDs(const std::string& _groupID,
+        bcos::crypto::NodeIDPtr _srcNodeID, const bcos::crypto::NodeIDs& _dstNodeIDs,
+        bytesConstRef _payload) override
+    {
+        for (auto const& nodeID : _dstNodeIDs)
+        {
+            m_sentFrames++;
+            auto it = m_mesh->find(nodeID->hex());
+            if (it != m_mesh->end())
+            {
+                it->second->onReceiveMessage(_groupID, _srcNodeID, _payload, nullptr);
+            }
+        }
+    }
+    // the nodes missing from the mesh are unreachable
+    void asyncSendMessageByNodeID(const std::string& _groupID, bcos::crypto::NodeIDPtr _srcNodeID,
+        bcos::crypto::NodeIDPtr _dstNodeID, bytesConstRef _payload,
+        bcos::gateway::ErrorRespFunc _errorRespFunc) override
+    {
+        m_sentFrames++;
+        auto it = m_mesh->find(_dstNodeID->hex());
+        if (it == m_mesh->end())
+        {
+            _errorRespFunc(std::make_shared<Error>(-1, "unreachable"));
+            return;
+        }
+        it->second->onReceiveMessage(_groupID, _srcNodeID, _payload, _errorRespFunc);
+    }
+    void asyncSendBroadcastMessage(const std::string& _groupID,
+        bcos::crypto::NodeIDPtr _srcNodeID, bytesConstRef _payload) override
+    {
+        for (auto const& entry : *m_mesh)
+        {
+            if (entry.first != _srcNodeID->hex())
+            {
+                m_sentFrames++;
+                entry.second->onReceiveMessage(_groupID, _srcNodeID, _payload, nullptr);
+            }
+        }
+    }
+
+    size_t m_sentFrames = 0;
+
+private:
+    std::shared_ptr<Mesh> m_mesh;
+};
+
+bcos::crypto::NodeIDs createNodeIDs(size_t _count)
+{
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    bcos::crypto::NodeIDs nodeIDs;
+    for (size_t i = 0; i < _count; ++i)
+    {
+        std::string key = "relay-node-" + std::to_string(i);
+        nodeIDs.emplace_back(
+            keyFactory->createKey(bytesConstRef((const byte*)key.data(), key.size())));
+    }
+    return nodeIDs;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(RelayTreeTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testRelayTree)
+{
+    auto nodeIDs = createNodeIDs(100);
+    auto origin = nodeIDs[17];
+    uint64_t broadcastID = 0x1234;
+    uint8_t fanout = 4;
+
+    // every node derives the same tree, each node but the origin is the child of exactly one
+    std::map<std::string, size_t> parents;
+    for (auto const& nodeID : nodeIDs)
+    {
+        RelayTree tree(nodeIDs, nodeID, RelayTree::nodeHash(origin), broadcastID, fanout);
+        BOOST_CHECK(tree.valid());
+        BOOST_CHECK_EQUAL(tree.size(), 100);
+        // 1 + 4 + 16 + 64 >= 100
+        BOOST_CHECK_EQUAL(tree.depth(), 4);
+        BOOST_CHECK(tree.children().size() <= fanout);
+        if (nodeID == origin)
+        {
+            BOOST_CHECK_EQUAL(tree.position(), 0);
+            BOOST_CHECK_EQUAL(tree.children().size(), fanout);
+        }
+        for (auto const& child : tree.children())
+        {
+            parents[child->hex()]++;
+        }
+    }
+    BOOST_CHECK_EQUAL(parents.size(), 99);
+    BOOST_CHECK(!parents.count(origin->hex()));
+    for (auto const& entry : parents)
+    {
+        BOOST_CHECK_EQUAL(entry.second, 1);
+    }
+
+    // the order of the members and the duplicates do not change the tree
+    auto shuffled = nodeIDs;
+    std::reverse(shuffled.begin(), shuffled.end());
+    shuffled.emplace_back(nodeIDs[3]);
+    RelayTree tree(nodeIDs, nodeIDs[5], RelayTree::nodeHash(origin), broadcastID, fanout);
+    RelayTree shuffledTree(shuffled, nodeIDs[5], RelayTree::nodeHash(origin), broadcastID, fanout);
+    BOOST_CHECK_EQUAL(tree.position(), shuffledTree.position());
+    BOOST_CHECK_EQUAL(tree.children().size(), shuffledTree.children().size());
+    for (size_t i = 0; i < tree.children().size(); ++i)
+    {
+        BOOST_CHECK(tree.children()[i]->data() == shuffledTree.children()[i]->data());
+    }
+    // another broadcast spreads the interior nodes differently
+    RelayTree other(nodeIDs, nodeIDs[5], RelayTree::nodeHash(origin), broadcastID + 1, fanout);
+    BOOST_CHECK_EQUAL(other.size(), tree.size());
+
+    // the children of every position, the leaves have none
+    BOOST_CHECK_EQUAL(tree.children(0).size(), fanout);
+    BOOST_CHECK_EQUAL(tree.children(0).front(), 1);
+    BOOST_CHECK_EQUAL(tree.children(25).size(), 0);
+    BOOST_CHECK_EQUAL(tree.children(tree.position()).size(), tree.children().size());
+
+    // unknown origin
+    RelayTree unknown(nodeIDs, nodeIDs[5], 0, broadcastID, fanout);
+    BOOST_CHECK(!unknown.valid());
+    BOOST_CHECK(unknown.children().empty());
+}
+
+BOOST_AUTO_TEST_CASE(testRelayDedup)
+{
+    RelayDedup dedup(3);
+    BOOST_CHECK(dedup.insert(1, 1));
+    BOOST_CHECK(!dedup.insert(1, 1));
+    BOOST_CHECK(dedup.insert(2, 1));
+    BOOST_CHECK(dedup.insert(1, 2));
+    BOOST_CHECK(dedup.insert(1, 3));
+    BOOST_CHECK_EQUAL(dedup.size(), 3);
+    BOOST_CHECK_EQUAL(dedup.duplicates(), 1);
+    // evicted in FIFO order
+    BOOST_CHECK(dedup.insert(1, 1));
+    BOOST_CHECK(!dedup.insert(1, 3));
+}
+
+BOOST_AUTO_TEST_CASE(testFrontService_relayBroadcast)
+{
+    size_t const nodes = 40;
+    int moduleID = 2000;
+    auto nodeIDs = createNodeIDs(nodes);
+    auto sharedNodeIDs = std::make_shared<const bcos::crypto::NodeIDs>(nodeIDs);
+    auto mesh = std::make_shared<MeshGateway::Mesh>();
+    std::vector<MeshGateway::Ptr> gateways;
+    std::map<std::string, size_t> received;
+    std::string data(512, 'b');
+    for (auto const& nodeID : nodeIDs)
+    {
+        auto gateway = std::make_shared<MeshGateway>(mesh);
+        auto factory = std::make_shared<FrontServiceFactory>();
+        factory->setGatewayInterface(gateway);
+        auto frontService = factory->buildFrontService("group", nodeID);
+        frontService->onReceiveNodeIDs("group", sharedNodeIDs, nullptr);
+        frontService->registerModuleMessageDispatcher(moduleID,
+            [&received, &data, nodeID](
+                bcos::crypto::NodeIDPtr, const std::string& _uuid, bytesConstRef _data) {
+                BOOST_CHECK(_uuid.empty());
+                BOOST_CHECK_EQUAL(_data.toString(), data);
+                received[nodeID->hex()]++;
+            });
+        (*mesh)[nodeID->hex()] = frontService;
+        gateways.emplace_back(gateway);
+    }
+
+    auto origin = mesh->at(nodeIDs[0]->hex());
+    // the direct broadcast, the egress of the sender grows with the group
+    origin->asyncSendBroadcastMessage(
+        moduleID, bytesConstRef((const byte*)data.data(), data.size()));
+    BOOST_CHECK_EQUAL(gateways[0]->m_sentFrames, nodes - 1);
+    BOOST_CHECK_EQUAL(received.size(), nodes - 1);
+    received.clear();
+
+    origin->setRelayBroadcast(moduleID, 3);
+    BOOST_CHECK_EQUAL(origin->relayBroadcastFanout(moduleID), 3);
+    origin->asyncSendBroadcastMessage(
+        moduleID, bytesConstRef((const byte*)data.data(), data.size()));
+    BOOST_CHECK_EQUAL(gateways[0]->m_sentFrames, nodes - 1 + 3);
+    BOOST_CHECK_EQUAL(received.size(), nodes - 1);
+    BOOST_CHECK(!received.count(nodeIDs[0]->hex()));
+    size_t relayed = 0;
+    for (size_t i = 0; i < nodes; ++i)
+    {
+        BOOST_CHECK(i == 0 || received[nodeIDs[i]->hex()] == 1);
+        relayed += gateways[i]->m_sentFrames;
+    }
+    // one frame per receiver
+    BOOST_CHECK_EQUAL(relayed, nodes - 1 + nodes - 1);
+
+    // with the trace, every relay adds a hop: 3 + 9 + 27 receivers, two levels relayed
+    for (auto const& entry : *mesh)
+    {
+        entry.second->setHeaderExtensionEnabled(true);
+    }
+    origin->asyncSendBroadcastMessage(
+        moduleID, bytesConstRef((const byte*)data.data(), data.size()));
+    uint8_t maxHops = 0;
+    for (auto const& entry : *mesh)
+    {
+        for (auto const& latency : entry.second->latencyStats()->snapshot())
+        {
+            maxHops = std::max(maxHops, latency.maxHops);
+        }
+    }
+    BOOST_CHECK_EQUAL((int)maxHops, 2);
+
+    // a frame delivered twice is dispatched once
+    received.clear();
+    auto node = mesh->at(nodeIDs[1]->hex());
+    auto duplicates = node->relayDedup()->duplicates();
+    auto message = std::make_shared<FrontMessage>();
+    message->setModuleID(moduleID);
+    message->setPayload(bytesConstRef((const byte*)data.data(), data.size()));
+    FrontMessageExtension extension;
+    extension.setRelay(42, RelayTree::nodeHash(nodeIDs[0]), 3);
+    message->setExtension(extension);
+    bytes frame;
+    message->encode(frame);
+    for (int i = 0; i < 2; ++i)
+    {
+        node->onReceiveMessage(
+            "group", nodeIDs[0], bytesConstRef(frame.data(), frame.size()), nullptr);
+    }
+    BOOST_CHECK_EQUAL(node->relayDedup()->duplicates(), duplicates + 1);
+    BOOST_CHECK_EQUAL(received[nodeIDs[1]->hex()], 1);
+
+    // the unreachable nodes are bypassed by their parents, their subtrees still receive
+    for (size_t i = 1; i <= 3; ++i)
+    {
+        mesh->erase(nodeIDs[i]->hex());
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        received.clear();
+        origin->asyncSendBroadcastMessage(
+            moduleID, bytesConstRef((const byte*)data.data(), data.size()));
+        BOOST_CHECK_EQUAL(received.size(), nodes - 4);
+    }
+
+    origin->setRelayBroadcast(moduleID, 0);
+    BOOST_CHECK_EQUAL(origin->relayBroadcastFanout(moduleID), 0);
+    mesh->clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the round trip estimation and the adaptive timeout
+ * @file RttEstimatorTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/RttEstimator.h>
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+BOOST_FIXTURE_TEST_SUITE(RttEstimatorTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testRttEstimator)
+{
+    AdaptiveTimeoutPolicy policy;
+    policy.minTimeout = 1;
+    policy.maxTimeout = 10000;
+    RttEstimator estimator;
+    BOOST_CHECK_EQUAL(estimator.timeout(policy), policy.initialTimeout);
+
+    // a LAN peer, 2ms to 4ms
+    std::mt19937 random(20211018);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        estimator.addSample(2 + random() % 3);
+    }
+    BOOST_CHECK(estimator.srtt() >= 2 && estimator.srtt() <= 4);
+    BOOST_CHECK(estimator.quantile(0.99) >= 4 && estimator.quantile(0.99) <= 5);
+    auto timeout = estimator.timeout(policy);
+    BOOST_CHECK(timeout >= policy.minTimeout && timeout < 20);
+
+    // backed off by the timeouts, bounded by the policy
+    estimator.onTimeout();
+    auto backedOff = estimator.timeout(policy);
+    BOOST_CHECK(backedOff >= timeout * 2 - 1 && backedOff <= timeout * 2);
+    for (size_t i = 0; i < 20; ++i)
+    {
+        estimator.onTimeout();
+    }
+    BOOST_CHECK(estimator.timeout(policy) <= timeout * 64);
+    estimator.addSample(3);
+    BOOST_CHECK(estimator.timeout(policy) < 20);
+
+    // a cross region peer with a heavy tail, the quantile dominates
+    RttEstimator remote;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        remote.addSample(i % 50 == 0 ? 2000 : 150);
+    }
+    BOOST_CHECK(remote.quantile(0.99) >= 2000);
+    BOOST_CHECK(remote.timeout(policy) >= 2000);
+    BOOST_CHECK(remote.timeout(policy) <= policy.maxTimeout);
+    // the decay follows the recent round trips
+    for (size_t i = 0; i < 4000; ++i)
+    {
+        remote.addSample(150);
+    }
+    BOOST_CHECK(remote.quantile(0.99) < 200);
+}
+
+BOOST_AUTO_TEST_CASE(testAdaptiveTimeout)
+{
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto nodeID = keyFactory->createKey(bytesConstRef((const byte*)"node0", 5));
+    AdaptiveTimeoutPolicy policy;
+    policy.minTimeout = 50;
+    AdaptiveTimeout adaptiveTimeout(policy);
+    BOOST_CHECK_EQUAL(adaptiveTimeout.timeout(1, nodeID), policy.initialTimeout);
+
+    for (size_t i = 0; i < policy.minSamples; ++i)
+    {
+        adaptiveTimeout.addSample(1, nodeID, 5);
+    }
+    BOOST_CHECK_EQUAL(adaptiveTimeout.timeout(1, nodeID), 50);
+    BOOST_CHECK_EQUAL(adaptiveTimeout.estimator(1, nodeID).samples(), policy.minSamples);
+    // per module
+    BOOST_CHECK_EQUAL(adaptiveTimeout.timeout(2, nodeID), policy.initialTimeout);
+    auto modulePolicy = policy;
+    modulePolicy.minTimeout = 500;
+    adaptiveTimeout.setModulePolicy(1, modulePolicy);
+    BOOST_CHECK_EQUAL(adaptiveTimeout.timeout(1, nodeID), 500);
+    adaptiveTimeout.onTimeout(1, nodeID);
+    BOOST_CHECK_EQUAL(adaptiveTimeout.timeout(1, nodeID), 500);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,383 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the shared memory transport of a co-located front and gateway
+ * @file ShmTransportTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/libutilities/Exceptions.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/FrontServiceFactory.h>
+#include <bcos-front/ShmTransport.h>
+#include <boost/test/unit_test.hpp>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <csignal>
+#include <future>
+#include <unistd.h>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+
+namespace
+{
+const static std::string g_groupID = "front.shm.group";
+
+std::string channelName()
+{
+    static std::atomic<int> index(0);
+    return "/bcos-front-test-" + std::to_string(getpid()) + "-" + std::to_string(index++);
+}
+
+bcos::crypto::NodeIDPtr createKey(bytesConstRef _nodeID)
+{
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    return keyFactory->createKey(_nodeID);
+}
+
+bcos::crypto::NodeIDPtr createKey(const std::string& _strNodeID)
+{
+    return createKey(bytesConstRef((byte*)_strNodeID.data(), _strNodeID.size()));
+}
+
+// the gateway process: every frame comes back to the front as received from its destination,
+// the sends to "down" fail
+class StandInGateway : public gateway::GatewayInterface
+{
+public:
+    void setEndpoint(ShmGatewayEndpoint::Ptr _endpoint) { m_endpoint = _endpoint; }
+
+    void start() override {}
+    void stop() override {}
+    void asyncGetPeers(std::function<void(
+            Error::Ptr, bcos::gateway::GatewayInfo::Ptr, bcos::gateway::GatewayInfosPtr)>) override
+    {}
+    void asyncGetNodeIDs(const std::string&, GetNodeIDsFunc) override {}
+    void asyncSendMessageByNodeID(const std::string& _groupID, bcos::crypto::NodeIDPtr,
+        bcos::crypto::NodeIDPtr _dstNodeID, bytesConstRef _payload,
+        bcos::gateway::ErrorRespFunc _errorRespFunc) override
+    {
+        Error::Ptr error;
+        if (_dstNodeID->data() == bytes{'d', 'o', 'w', 'n'})
+        {
+            error = std::make_shared<Error>(-1, "unreachable");
+        }
+        else
+        {
+            m_endpoint.lock()->deliver(_groupID, _dstNodeID, _payload);
+        }
+        if (_errorRespFunc)
+        {
+            _errorRespFunc(error);
+        }
+    }
+    void asyncSendMessageByNodeIDs(const std::string& _groupID, bcos::crypto::NodeIDPtr,
+        const bcos::crypto::NodeIDs& _dstNodeIDs, bytesConstRef _payload) override
+    {
+        for (auto const& dstNodeID : _dstNodeIDs)
+        {
+            m_endpoint.lock()->deliver(_groupID, dstNodeID, _payload);
+        }
+    }
+    void asyncSendBroadcastMessage(const std::string& _groupID,
+        bcos::crypto::NodeIDPtr _srcNodeID, bytesConstRef _payload) override
+    {
+        m_endpoint.lock()->deliver(_groupID, _srcNodeID, _payload);
+    }
+    void asyncNotifyGroupInfo(
+        bcos::group::GroupInfo::Ptr, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncSendMessageByTopic(const std::string&, bcos::bytesConstRef,
+        std::function<void(bcos::Error::Ptr&&, int16_t, bytesPointer)>) override
+    {}
+    void asyncSendBroadbastMessageByTopic(const std::string&, bcos::bytesConstRef) override {}
+    void asyncSubscribeTopic(
+        std::string const&, std::string const&, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncRemoveTopic(std::string const&, std::vector<std::string> const&,
+        std::function<void(Error::Ptr&&)>) override
+    {}
+
+private:
+    std::weak_ptr<ShmGatewayEndpoint> m_endpoint;
+};
+
+// the front of the channel, answering "pong" to the module 1000
+struct ShmFront
+{
+    explicit ShmFront(ShmChannel::Ptr _channel)
+    {
+        gateway = std::make_shared<ShmGateway>(_channel, nullptr);
+        auto factory = std::make_shared<FrontServiceFactory>();
+        factory->setGatewayInterface(gateway);
+        front = factory->buildFrontService(g_groupID, createKey("front"));
+        front->registerModuleMessageDispatcher(
+            1000, [this](bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid,
+                      bytesConstRef _data) {
+                auto response = "pong:" + _data.toString();
+                front->asyncSendResponse(_uuid, 1000, _nodeID,
+                    bytesConstRef((byte*)response.data(), response.size()), [](Error::Ptr) {});
+            });
+        front->start();
+        receiver = std::make_shared<ShmFrontReceiver>(
+            _channel, front, gateway, [](bytesConstRef _nodeID) { return createKey(_nodeID); });
+        receiver->start();
+    }
+    ~ShmFront()
+    {
+        receiver->stop();
+        front->stop();
+    }
+
+    // send the requests to _dst and wait for the responses, return the failed ones
+    size_t ping(const std::string& _dst, size_t _count)
+    {
+        std::atomic<size_t> done(0);
+        std::atomic<size_t> failed(0);
+        std::promise<void> finished;
+        auto dstNodeID = createKey(_dst);
+        for (size_t i = 0; i < _count; ++i)
+        {
+            auto data = std::to_string(i);
+            front->asyncSendMessageByNodeID(1000, dstNodeID,
+                bytesConstRef((byte*)data.data(), data.size()), 10000,
+                [&, data, _count](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef _data,
+                    const std::string&, std::function<void(bytesConstRef)>) {
+                    if (_error || _data.toString() != "pong:" + data)
+                    {
+                        failed++;
+                    }
+                    if (++done == _count)
+                    {
+                        finished.set_value();
+                    }
+                });
+        }
+        finished.get_future().get();
+        return failed;
+    }
+
+    ShmGateway::Ptr gateway;
+    FrontService::Ptr front;
+    ShmFrontReceiver::Ptr receiver;
+};
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(ShmTransportTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testShmRing_records)
+{
+    auto channel = ShmChannel::create(channelName(), 4096);
+    auto& ring = channel->toGateway();
+    BOOST_CHECK(ring.reserve(0) == nullptr);
+    BOOST_CHECK(ring.reserve(ring.maxRecordSize() + 1) == nullptr);
+
+    // wrap around the ring many times, with the padding records
+    size_t written = 0;
+    size_t read = 0;
+    for (size_t round = 0; round < 100; ++round)
+    {
+        byte* record = nullptr;
+        while ((record = ring.reserve(written % 300 + 1)) != nullptr)
+        {
+            memset(record, (byte)written, written % 300 + 1);
+            written++;
+        }
+        ring.commit();
+        bytesConstRef data;
+        while (ring.peek(data))
+        {
+            BOOST_REQUIRE_EQUAL(data.size(), read % 300 + 1);
+            BOOST_REQUIRE(data[0] == (byte)read && data[data.size() - 1] == (byte)read);
+            read++;
+        }
+        ring.release();
+    }
+    BOOST_CHECK_EQUAL(read, written);
+    BOOST_CHECK(written > 100 * 4096 / 320);
+
+    // a length out of the ring written by the other process stops the reading
+    auto record = ring.reserve(8);
+    uint32_t length = 4096;
+    memcpy(record - ShmRing::RECORD_HEADER_LENGTH, &length, sizeof(length));
+    ring.commit();
+    bytesConstRef data;
+    BOOST_CHECK(!ring.peek(data));
+    BOOST_CHECK(ring.corrupted());
+
+    BOOST_CHECK_THROW(ShmChannel::create(channelName(), 5000), InvalidParameter);
+    BOOST_CHECK_THROW(ShmChannel::create(channel->name(), 4096), InvalidParameter);
+    BOOST_CHECK_THROW(ShmChannel::attach(channelName(), dup(channel->toGatewayFd()),
+                          dup(channel->toFrontFd())),
+        InvalidParameter);
+}
+
+BOOST_AUTO_TEST_CASE(testShmRing_producerConsumer)
+{
+    auto channel = ShmChannel::create(channelName(), 64 * 1024);
+    // the consumer maps the segment again, as the other process does
+    auto peer = ShmChannel::attach(
+        channel->name(), dup(channel->toGatewayFd()), dup(channel->toFrontFd()));
+
+    const uint64_t count = 100000;
+    std::thread producer([&channel, count]() {
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            BOOST_REQUIRE(channel->toGateway().write(
+                8 + i % 100, [i](byte* _record) { memcpy(_record, &i, 8); }, 10000));
+        }
+    });
+    auto& ring = peer->toGateway();
+    uint64_t expected = 0;
+    while (expected < count)
+    {
+        bytesConstRef record;
+        size_t batch = 0;
+        while (ring.peek(record))
+        {
+            uint64_t value = 0;
+            memcpy(&value, record.data(), 8);
+            BOOST_REQUIRE_EQUAL(value, expected);
+            BOOST_REQUIRE_EQUAL(record.size(), 8 + expected % 100);
+            expected++;
+            batch++;
+        }
+        if (batch > 0)
+        {
+            ring.release();
+        }
+        else
+        {
+            ring.wait(100);
+        }
+    }
+    producer.join();
+    // the producer writes the eventfd only when the consumer sleeps
+    BOOST_CHECK(channel->toGateway().wakeUps() < count);
+}
+
+BOOST_AUTO_TEST_CASE(testShmTransport_inProcess)
+{
+    auto channel = ShmChannel::create(channelName(), 1024 * 1024);
+    auto peer = ShmChannel::attach(
+        channel->name(), dup(channel->toGatewayFd()), dup(channel->toFrontFd()));
+    auto gateway = std::make_shared<StandInGateway>();
+    auto endpoint = std::make_shared<ShmGatewayEndpoint>(
+        peer, gateway, [](bytesConstRef _nodeID) { return createKey(_nodeID); });
+    gateway->setEndpoint(endpoint);
+    endpoint->start();
+
+    ShmFront shmFront(channel);
+    BOOST_CHECK_EQUAL(shmFront.ping("node0", 1000), 0);
+    // counted once the batch of the last response returns, the result of the last send comes
+    // after its response
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((shmFront.receiver->frames() < 2000 || shmFront.gateway->pendingResults() > 0) &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BOOST_CHECK_EQUAL(shmFront.receiver->frames(), 2000);
+    BOOST_CHECK(shmFront.receiver->batches() <= shmFront.receiver->frames());
+    BOOST_CHECK_EQUAL(shmFront.gateway->pendingResults(), 0);
+
+    // the send error of the gateway fails the request
+    std::promise<Error::Ptr> failed;
+    std::string data = "ping";
+    shmFront.front->asyncSendMessageByNodeID(1000, createKey("down"),
+        bytesConstRef((byte*)data.data(), data.size()), 10000,
+        [&failed](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+            std::function<void(bytesConstRef)>) { failed.set_value(_error); });
+    auto error = failed.get_future().get();
+    BOOST_REQUIRE(error);
+    BOOST_CHECK_EQUAL(error->errorMessage(), "unreachable");
+
+    // the frames to many nodes come back from every node, the broadcast from the front
+    std::atomic<int> received(0);
+    shmFront.front->registerModuleMessageDispatcher(
+        1001, [&received](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {
+            received++;
+        });
+    shmFront.front->asyncSendMessageByNodeIDs(1001,
+        bcos::crypto::NodeIDs{createKey("node0"), createKey("node1"), createKey("node2")},
+        bytesConstRef((byte*)data.data(), data.size()));
+    shmFront.front->asyncSendBroadcastMessage(1001, bytesConstRef((byte*)data.data(), data.size()));
+    while (received < 4)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_CHECK_EQUAL(received, 4);
+    endpoint->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testShmGateway_expireResults)
+{
+    // no endpoint drains the ring, the result of the send never comes
+    auto channel = ShmChannel::create(channelName(), 4096);
+    auto gateway = std::make_shared<ShmGateway>(channel, nullptr);
+    std::string data = "ping";
+    Error::Ptr error;
+    gateway->asyncSendMessageByNodeID(g_groupID, createKey("front"), createKey("node0"),
+        bytesConstRef((byte*)data.data(), data.size()),
+        [&error](Error::Ptr _error) { error = _error; });
+    BOOST_CHECK_EQUAL(gateway->pendingResults(), 1);
+    BOOST_CHECK_EQUAL(gateway->expireResults(utcSteadyTime()), 0);
+    BOOST_CHECK_EQUAL(gateway->expireResults(utcSteadyTime() + ShmGateway::RESULT_TIMEOUT), 1);
+    BOOST_CHECK_EQUAL(gateway->pendingResults(), 0);
+    BOOST_REQUIRE(error);
+    BOOST_CHECK_EQUAL(error->errorCode(), bcos::protocol::CommonError::TIMEOUT);
+}
+
+BOOST_AUTO_TEST_CASE(testShmTransport_standInProcess)
+{
+    auto channel = ShmChannel::create(channelName(), 1024 * 1024);
+    auto pid = fork();
+    BOOST_REQUIRE(pid >= 0);
+    if (pid == 0)
+    {
+        // the stand-in gateway process, killed by the test or with it
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        auto peer = ShmChannel::attach(
+            channel->name(), dup(channel->toGatewayFd()), dup(channel->toFrontFd()));
+        auto gateway = std::make_shared<StandInGateway>();
+        auto endpoint = std::make_shared<ShmGatewayEndpoint>(
+            peer, gateway, [](bytesConstRef _nodeID) { return createKey(_nodeID); });
+        gateway->setEndpoint(endpoint);
+        while (true)
+        {
+            if (endpoint->poll() == 0)
+            {
+                peer->toGateway().wait(100);
+            }
+        }
+    }
+    std::shared_ptr<void> reaper(nullptr, [pid](void*) {
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+    });
+
+    ShmFront shmFront(channel);
+    BOOST_CHECK_EQUAL(shmFront.ping("node0", 2000), 0);
+    BOOST_CHECK_EQUAL(shmFront.gateway->pendingResults(), 0);
+    BOOST_CHECK_EQUAL(shmFront.gateway->droppedFrames(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,294 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief deterministic network simulator connecting front services through virtual links
+ * @file SimGateway.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include "SimGateway.h"
+#include <bcos-front/Common.h>
+#include <cmath>
+
+using namespace bcos;
+using namespace bcos::front;
+using namespace bcos::front::test;
+
+namespace
+{
+// uniform in [0, 1) from the raw bits, the std distributions differ between standard libraries
+double uniform(std::mt19937_64& _random)
+{
+    return (_random() >> 11) * (1.0 / (1ULL << 53));
+}
+}  // namespace
+
+uint64_t SimStats::latencyQuantile(double _quantile) const
+{
+    if (latencies.empty())
+    {
+        return 0;
+    }
+    auto sorted = latencies;
+    auto index = std::min<size_t>(sorted.size() - 1, (size_t)(_quantile * sorted.size()));
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+SimGateway::Ptr SimNetwork::addNode(const bcos::crypto::NodeIDPtr& _nodeID)
+{
+    if (!m_index.count(_nodeID))
+    {
+        m_index.emplace(_nodeID, m_nodes.size());
+        m_nodes.emplace_back(Node{_nodeID, nullptr});
+    }
+    return std::make_shared<SimGateway>(weak_from_this(), _nodeID);
+}
+
+void SimNetwork::attach(
+    const bcos::crypto::NodeIDPtr& _nodeID, std::shared_ptr<FrontServiceInterface> _front)
+{
+    auto it = m_index.find(_nodeID);
+    if (it != m_index.end())
+    {
+        m_nodes[it->second].front = _front;
+    }
+}
+
+void SimNetwork::connectAll(const std::string& _groupID)
+{
+    for (auto const& node : m_nodes)
+    {
+        if (!node.front)
+        {
+            continue;
+        }
+        auto peers = std::make_shared<bcos::crypto::NodeIDs>();
+        for (auto const& peer : m_nodes)
+        {
+            if (peer.nodeID->data() != node.nodeID->data())
+            {
+                peers->emplace_back(peer.nodeID);
+            }
+        }
+        node.front->onReceiveNodeIDs(_groupID, peers, nullptr);
+    }
+}
+
+void SimNetwork::clear()
+{
+    // the front services hold the gateways, the timers hold the frames
+    m_clock = std::make_shared<VirtualClock>(m_clock->nowUs());
+    m_nodes.clear();
+    m_index.clear();
+    m_links.clear();
+}
+
+bcos::crypto::NodeIDs SimNetwork::nodeIDs() const
+{
+    bcos::crypto::NodeIDs nodeIDs;
+    for (auto const& node : m_nodes)
+    {
+        nodeIDs.emplace_back(node.nodeID);
+    }
+    return nodeIDs;
+}
+
+void SimNetwork::setLink(const bcos::crypto::NodeIDPtr& _src, const bcos::crypto::NodeIDPtr& _dst,
+    const LinkProfile& _profile)
+{
+    link(_src, _dst).profile = _profile;
+}
+
+SimNetwork::Link& SimNetwork::link(
+    const bcos::crypto::NodeIDPtr& _src, const bcos::crypto::NodeIDPtr& _dst)
+{
+    auto key = std::make_pair(m_index.at(_src), m_index.at(_dst));
+    auto it = m_links.find(key);
+    if (it == m_links.end())
+    {
+        Link link;
+        link.profile = m_defaultLink;
+        it = m_links.emplace(key, link).first;
+    }
+    return it->second;
+}
+
+uint64_t SimNetwork::sampleLatency(const LinkProfile& _profile)
+{
+    double jitter = 0;
+    switch (_profile.distribution)
+    {
+    case LinkProfile::Distribution::Constant:
+        break;
+    case LinkProfile::Distribution::Uniform:
+        jitter = uniform(m_random) * _profile.jitter;
+        break;
+    case LinkProfile::Distribution::Normal:
+    {
+        // Box-Muller
+        auto u1 = 1.0 - uniform(m_random);
+        auto u2 = uniform(m_random);
+        jitter = std::fabs(std::sqrt(-2 * std::log(u1)) * std::cos(2 * M_PI * u2)) *
+                 _profile.jitter;
+        break;
+    }
+    case LinkProfile::Distribution::Pareto:
+        jitter = _profile.jitter * (std::pow(1.0 - uniform(m_random), -1 / 1.5) - 1);
+        break;
+    }
+    return _profile.latency + (uint64_t)jitter;
+}
+
+void SimNetwork::send(const std::string& _groupID, const bcos::crypto::NodeIDPtr& _src,
+    const bcos::crypto::NodeIDPtr& _dst, bytesConstRef _payload)
+{
+    if (!m_index.count(_src) || !m_index.count(_dst))
+    {
+        return;
+    }
+    m_stats.sent++;
+    auto& link = this->link(_src, _dst);
+    auto const& profile = link.profile;
+    // serialized one after another at the bandwidth of the link
+    auto now = m_clock->nowUs();
+    auto departure = std::max(now, link.busyUntil);
+    if (profile.bandwidth > 0)
+    {
+        departure += (uint64_t)std::ceil(_payload.size() * 1e6 / profile.bandwidth);
+    }
+    link.busyUntil = departure;
+    if (profile.loss > 0 && uniform(m_random) < profile.loss)
+    {
+        m_stats.lost++;
+        return;
+    }
+    auto frame = std::make_shared<bytes>(_payload.begin(), _payload.end());
+    auto copies = (profile.duplicate > 0 && uniform(m_random) < profile.duplicate) ? 2 : 1;
+    m_stats.duplicated += copies - 1;
+    for (int i = 0; i < copies; ++i)
+    {
+        auto arrival = departure + sampleLatency(profile);
+        if (!profile.reorder)
+        {
+            arrival = std::max(arrival, link.lastArrival);
+            link.lastArrival = arrival;
+        }
+        deliver(_groupID, _src, _dst, frame, now, arrival);
+    }
+}
+
+void SimNetwork::deliver(const std::string& _groupID, const bcos::crypto::NodeIDPtr& _src,
+    const bcos::crypto::NodeIDPtr& _dst, std::shared_ptr<bytes> _frame, uint64_t _sendTime,
+    uint64_t _arrival)
+{
+    auto dst = m_index.at(_dst);
+    m_clock->schedule(
+        _arrival - m_clock->nowUs(), [this, _groupID, _src, dst, _frame, _sendTime]() {
+            m_stats.delivered++;
+            m_stats.bytes += _frame->size();
+            m_stats.latencies.push_back(m_clock->nowUs() - _sendTime);
+            auto front = m_nodes[dst].front;
+            if (front)
+            {
+                front->onReceiveMessage(
+                    _groupID, _src, bytesConstRef(_frame->data(), _frame->size()), nullptr);
+            }
+        });
+}
+
+void SimNetwork::schedule(uint64_t _delay, std::function<void()> _task)
+{
+    m_clock->schedule(_delay, std::move(_task));
+}
+
+size_t SimNetwork::runUntil(uint64_t _time)
+{
+    return m_clock->advanceTo(_time);
+}
+
+size_t SimNetwork::runUntilIdle(size_t _maxEvents)
+{
+    return m_clock->runUntilIdle(_maxEvents);
+}
+
+void SimGateway::asyncGetNodeIDs(const std::string&, GetNodeIDsFunc _getNodeIDsFunc)
+{
+    auto network = m_network.lock();
+    auto nodeIDs = std::make_shared<bcos::crypto::NodeIDs>();
+    if (network)
+    {
+        for (auto const& nodeID : network->nodeIDs())
+        {
+            if (nodeID->data() != m_nodeID->data())
+            {
+                nodeIDs->emplace_back(nodeID);
+            }
+        }
+    }
+    if (_getNodeIDsFunc)
+    {
+        _getNodeIDsFunc(nullptr, nodeIDs);
+    }
+}
+
+void SimGateway::asyncSendMessageByNodeID(const std::string& _groupID,
+    bcos::crypto::NodeIDPtr _srcNodeID, bcos::crypto::NodeIDPtr _dstNodeID, bytesConstRef _payload,
+    bcos::gateway::ErrorRespFunc _errorRespFunc)
+{
+    auto network = m_network.lock();
+    if (network)
+    {
+        network->send(_groupID, _srcNodeID, _dstNodeID, _payload);
+    }
+    // the frames are lost silently as on a real network
+    if (_errorRespFunc)
+    {
+        _errorRespFunc(nullptr);
+    }
+}
+
+void SimGateway::asyncSendMessageByNodeIDs(const std::string& _groupID,
+    bcos::crypto::NodeIDPtr _srcNodeID, const bcos::crypto::NodeIDs& _dstNodeIDs,
+    bytesConstRef _payload)
+{
+    auto network = m_network.lock();
+    if (!network)
+    {
+        return;
+    }
+    for (auto const& dstNodeID : _dstNodeIDs)
+    {
+        network->send(_groupID, _srcNodeID, dstNodeID, _payload);
+    }
+}
+
+void SimGateway::asyncSendBroadcastMessage(
+    const std::string& _groupID, bcos::crypto::NodeIDPtr _srcNodeID, bytesConstRef _payload)
+{
+    auto network = m_network.lock();
+    if (!network)
+    {
+        return;
+    }
+    for (auto const& dstNodeID : network->nodeIDs())
+    {
+        if (dstNodeID->data() != _srcNodeID->data())
+        {
+            network->send(_groupID, _srcNodeID, dstNodeID, _payload);
+        }
+    }
+}
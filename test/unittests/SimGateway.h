@@ -0,0 +1,205 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief deterministic network simulator connecting front services through virtual links
+ * @file SimGateway.h
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/front/FrontServiceInterface.h>
+#include <bcos-framework/interfaces/gateway/GatewayInterface.h>
+#include <bcos-framework/libutilities/Common.h>
+#include <bcos-front/FrontClock.h>
+#include <bcos-front/NodeIDsSnapshot.h>
+#include <limits>
+#include <map>
+#include <random>
+
+namespace bcos
+{
+namespace front
+{
+namespace test
+{
+/// the behaviour of the frames sent from one node to another, times in microseconds
+struct LinkProfile
+{
+    enum class Distribution : uint8_t
+    {
+        // always latency
+        Constant = 0,
+        // latency + [0, jitter)
+        Uniform = 1,
+        // latency + |N(0, jitter)|
+        Normal = 2,
+        // latency + a Pareto tail of scale jitter and shape 1.5, the WAN stragglers
+        Pareto = 3,
+    };
+
+    uint64_t latency = 0;
+    uint64_t jitter = 0;
+    Distribution distribution = Distribution::Constant;
+    // bytes per second the link serializes the frames at, 0 for unlimited
+    double bandwidth = 0;
+    // probability of a frame being dropped
+    double loss = 0;
+    // probability of a frame being delivered twice
+    double duplicate = 0;
+    // let the jitter reorder the frames, FIFO delivery otherwise
+    bool reorder = true;
+};
+
+struct SimStats
+{
+    uint64_t sent = 0;
+    uint64_t delivered = 0;
+    uint64_t lost = 0;
+    uint64_t duplicated = 0;
+    uint64_t bytes = 0;
+    // delivery latency of every delivered frame, queueing on the link included
+    std::vector<uint64_t> latencies;
+
+    // _quantile in [0, 1] of the delivery latencies, 0 if none
+    uint64_t latencyQuantile(double _quantile) const;
+};
+
+class SimGateway;
+
+/**
+ * the virtual time network: every frame becomes a timer of the virtual clock at its arrival
+ * time, the timers run in (time, sequence) order on the thread calling run*, so that a seed
+ * always reproduces the same run whatever the wall clock does; the front services built with
+ * clock() time out their requests in the same virtual time
+ */
+class SimNetwork : public std::enable_shared_from_this<SimNetwork>
+{
+public:
+    using Ptr = std::shared_ptr<SimNetwork>;
+
+    explicit SimNetwork(uint64_t _seed) : m_random(_seed) {}
+
+    // the virtual time in microseconds
+    uint64_t now() const { return m_clock->nowUs(); }
+    // the clock the front services must be built with
+    VirtualClock::Ptr clock() const { return m_clock; }
+
+    /**
+     * @brief: add _nodeID to the network, attach its front service once built
+     * @return the gateway the front service of _nodeID must be built with
+     */
+    std::shared_ptr<SimGateway> addNode(const bcos::crypto::NodeIDPtr& _nodeID);
+    void attach(
+        const bcos::crypto::NodeIDPtr& _nodeID, std::shared_ptr<FrontServiceInterface> _front);
+    // push the other nodes to every front service
+    void connectAll(const std::string& _groupID);
+    void clear();
+
+    void setDefaultLink(const LinkProfile& _profile) { m_defaultLink = _profile; }
+    // the link from _src to _dst, the reverse direction is another link
+    void setLink(const bcos::crypto::NodeIDPtr& _src, const bcos::crypto::NodeIDPtr& _dst,
+        const LinkProfile& _profile);
+
+    void send(const std::string& _groupID, const bcos::crypto::NodeIDPtr& _src,
+        const bcos::crypto::NodeIDPtr& _dst, bytesConstRef _payload);
+    // run _task at now() + _delay
+    void schedule(uint64_t _delay, std::function<void()> _task);
+
+    // run the events up to _time and advance the clock to it, return the events run
+    size_t runUntil(uint64_t _time);
+    // run the events until none is left or _maxEvents are run
+    size_t runUntilIdle(size_t _maxEvents = std::numeric_limits<size_t>::max());
+    size_t pendingEvents() const { return m_clock->pending(); }
+
+    const SimStats& stats() const { return m_stats; }
+    bcos::crypto::NodeIDs nodeIDs() const;
+
+private:
+    struct Link
+    {
+        LinkProfile profile;
+        // the time the link finishes serializing the frames already sent
+        uint64_t busyUntil = 0;
+        // the arrival time of the last frame, for the FIFO links
+        uint64_t lastArrival = 0;
+    };
+    struct Node
+    {
+        bcos::crypto::NodeIDPtr nodeID;
+        std::shared_ptr<FrontServiceInterface> front;
+    };
+
+    Link& link(const bcos::crypto::NodeIDPtr& _src, const bcos::crypto::NodeIDPtr& _dst);
+    uint64_t sampleLatency(const LinkProfile& _profile);
+    void deliver(const std::string& _groupID, const bcos::crypto::NodeIDPtr& _src,
+        const bcos::crypto::NodeIDPtr& _dst, std::shared_ptr<bytes> _frame, uint64_t _sendTime,
+        uint64_t _arrival);
+
+    std::mt19937_64 m_random;
+    VirtualClock::Ptr m_clock = std::make_shared<VirtualClock>();
+    LinkProfile m_defaultLink;
+    // in the order added, for the deterministic node lists
+    std::vector<Node> m_nodes;
+    std::unordered_map<bcos::crypto::NodeIDPtr, size_t, NodeIDHasher, NodeIDEqual> m_index;
+    std::map<std::pair<size_t, size_t>, Link> m_links;
+    SimStats m_stats;
+};
+
+class SimGateway : public gateway::GatewayInterface
+{
+public:
+    using Ptr = std::shared_ptr<SimGateway>;
+
+    SimGateway(std::weak_ptr<SimNetwork> _network, bcos::crypto::NodeIDPtr _nodeID)
+      : m_network(_network), m_nodeID(_nodeID)
+    {}
+
+    void start() override {}
+    void stop() override {}
+    void asyncGetPeers(std::function<void(
+            Error::Ptr, bcos::gateway::GatewayInfo::Ptr, bcos::gateway::GatewayInfosPtr)>) override
+    {}
+    void asyncGetNodeIDs(const std::string& _groupID, GetNodeIDsFunc _getNodeIDsFunc) override;
+    void asyncSendMessageByNodeID(const std::string& _groupID, bcos::crypto::NodeIDPtr _srcNodeID,
+        bcos::crypto::NodeIDPtr _dstNodeID, bytesConstRef _payload,
+        bcos::gateway::ErrorRespFunc _errorRespFunc) override;
+    void asyncSendMessageByNodeIDs(const std::string& _groupID,
+        bcos::crypto::NodeIDPtr _srcNodeID, const bcos::crypto::NodeIDs& _dstNodeIDs,
+        bytesConstRef _payload) override;
+    void asyncSendBroadcastMessage(const std::string& _groupID,
+        bcos::crypto::NodeIDPtr _srcNodeID, bytesConstRef _payload) override;
+    void asyncNotifyGroupInfo(
+        bcos::group::GroupInfo::Ptr, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncSendMessageByTopic(const std::string&, bcos::bytesConstRef,
+        std::function<void(bcos::Error::Ptr&&, int16_t, bytesPointer)>) override
+    {}
+    void asyncSendBroadbastMessageByTopic(const std::string&, bcos::bytesConstRef) override {}
+    void asyncSubscribeTopic(
+        std::string const&, std::string const&, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncRemoveTopic(std::string const&, std::vector<std::string> const&,
+        std::function<void(Error::Ptr&&)>) override
+    {}
+
+private:
+    std::weak_ptr<SimNetwork> m_network;
+    bcos::crypto::NodeIDPtr m_nodeID;
+};
+}  // namespace test
+}  // namespace front
+}  // namespace bcos
@@ -0,0 +1,261 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the deterministic network simulator
+ * @file SimGatewayTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include "SimGateway.h"
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/interfaces/protocol/CommonError.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/FrontService.h>
+#include <bcos-front/FrontServiceFactory.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+using namespace bcos::front::test;
+
+namespace
+{
+const static std::string g_groupID = "front.sim.group";
+
+bcos::crypto::NodeIDPtr createKey(const std::string& _strNodeID)
+{
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    return keyFactory->createKey(bytesConstRef((byte*)_strNodeID.data(), _strNodeID.size()));
+}
+
+// without a thread pool, the messages are dispatched on the thread running the network, the
+// request timeouts fire in the virtual time
+FrontService::Ptr addFront(SimNetwork::Ptr _network, const std::string& _strNodeID)
+{
+    auto nodeID = createKey(_strNodeID);
+    auto factory = std::make_shared<FrontServiceFactory>();
+    factory->setGatewayInterface(_network->addNode(nodeID));
+    factory->setClock(_network->clock());
+    auto frontService = factory->buildFrontService(g_groupID, nodeID);
+    frontService->start();
+    _network->attach(nodeID, frontService);
+    return frontService;
+}
+
+SimStats runLossyNetwork(uint64_t _seed)
+{
+    auto network = std::make_shared<SimNetwork>(_seed);
+    auto src = createKey("sim.src");
+    auto dst = createKey("sim.dst");
+    network->addNode(src);
+    network->addNode(dst);
+    LinkProfile profile;
+    profile.latency = 1000;
+    profile.jitter = 500;
+    profile.distribution = LinkProfile::Distribution::Pareto;
+    profile.loss = 0.1;
+    profile.duplicate = 0.05;
+    network->setDefaultLink(profile);
+    std::string data(64, 'x');
+    for (int i = 0; i < 1000; ++i)
+    {
+        network->send(g_groupID, src, dst, bytesConstRef((byte*)data.data(), data.size()));
+    }
+    network->runUntilIdle();
+    return network->stats();
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(SimGatewayTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testSimNetwork_deterministic)
+{
+    auto stats = runLossyNetwork(7);
+    auto again = runLossyNetwork(7);
+    BOOST_CHECK_EQUAL(stats.lost, again.lost);
+    BOOST_CHECK_EQUAL(stats.duplicated, again.duplicated);
+    BOOST_CHECK(stats.latencies == again.latencies);
+
+    auto other = runLossyNetwork(8);
+    BOOST_CHECK(stats.latencies != other.latencies);
+
+    BOOST_CHECK_EQUAL(stats.sent, 1000);
+    BOOST_CHECK_EQUAL(stats.delivered, stats.sent - stats.lost + stats.duplicated);
+    BOOST_CHECK(stats.lost > 50 && stats.lost < 150);
+    BOOST_CHECK(stats.duplicated > 10 && stats.duplicated < 100);
+    BOOST_CHECK(stats.latencyQuantile(0) >= 1000);
+    BOOST_CHECK(stats.latencyQuantile(0.5) <= stats.latencyQuantile(0.99));
+}
+
+BOOST_AUTO_TEST_CASE(testSimNetwork_latencyAndBandwidth)
+{
+    auto network = std::make_shared<SimNetwork>(1);
+    auto src = createKey("sim.src");
+    auto dst = createKey("sim.dst");
+    network->addNode(src);
+    network->addNode(dst);
+    LinkProfile profile;
+    profile.latency = 1000;
+    // 1000 bytes take 1ms to serialize
+    profile.bandwidth = 1000000;
+    network->setLink(src, dst, profile);
+
+    std::string data(1000, 'x');
+    for (int i = 0; i < 10; ++i)
+    {
+        network->send(g_groupID, src, dst, bytesConstRef((byte*)data.data(), data.size()));
+    }
+    // the default link of the reverse direction is neither delayed nor limited
+    network->send(g_groupID, dst, src, bytesConstRef((byte*)data.data(), data.size()));
+    BOOST_CHECK_EQUAL(network->pendingEvents(), 11);
+
+    BOOST_CHECK_EQUAL(network->runUntil(0), 1);
+    BOOST_CHECK_EQUAL(network->runUntil(1999), 0);
+    BOOST_CHECK_EQUAL(network->runUntil(2000), 1);
+    BOOST_CHECK_EQUAL(network->now(), 2000);
+    BOOST_CHECK_EQUAL(network->runUntil(5999), 3);
+    BOOST_CHECK_EQUAL(network->runUntilIdle(), 6);
+    BOOST_CHECK_EQUAL(network->now(), 11000);
+    BOOST_CHECK_EQUAL(network->stats().bytes, 11000);
+    BOOST_CHECK_EQUAL(network->stats().latencyQuantile(1), 11000);
+
+    // the scheduled tasks run in the virtual time too
+    uint64_t firedAt = 0;
+    network->schedule(500, [&]() { firedAt = network->now(); });
+    network->runUntilIdle();
+    BOOST_CHECK_EQUAL(firedAt, 11500);
+}
+
+BOOST_AUTO_TEST_CASE(testSimNetwork_order)
+{
+    for (auto reorder : {false, true})
+    {
+        auto network = std::make_shared<SimNetwork>(42);
+        auto src = addFront(network, "sim.src");
+        auto dst = addFront(network, "sim.dst");
+        network->connectAll(g_groupID);
+        LinkProfile profile;
+        profile.latency = 1000;
+        profile.jitter = 10000;
+        profile.distribution = LinkProfile::Distribution::Uniform;
+        profile.reorder = reorder;
+        network->setDefaultLink(profile);
+
+        int moduleID = 5001;
+        std::vector<int> received;
+        dst->registerModuleMessageDispatcher(moduleID,
+            [&received](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef _data) {
+                received.push_back(std::stoi(_data.toString()));
+            });
+        for (int i = 0; i < 100; ++i)
+        {
+            auto data = std::to_string(i);
+            src->asyncSendMessageByNodeID(moduleID, dst->nodeID(),
+                bytesConstRef((byte*)data.data(), data.size()), 0, CallbackFunc());
+        }
+        network->runUntilIdle();
+        BOOST_CHECK_EQUAL(received.size(), 100);
+        BOOST_CHECK_EQUAL(std::is_sorted(received.begin(), received.end()), !reorder);
+        network->clear();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSimNetwork_requestResponse)
+{
+    auto network = std::make_shared<SimNetwork>(3);
+    auto client = addFront(network, "sim.client");
+    auto server = addFront(network, "sim.server");
+    network->connectAll(g_groupID);
+    LinkProfile profile;
+    profile.latency = 5000;
+    network->setDefaultLink(profile);
+
+    int moduleID = 5002;
+    // echo the requests back
+    std::weak_ptr<FrontService> weakServer = server;
+    server->registerModuleMessageDispatcher(moduleID,
+        [weakServer, moduleID](bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid,
+            bytesConstRef _data) {
+            if (auto server = weakServer.lock())
+            {
+                server->asyncSendResponse(_uuid, moduleID, _nodeID, _data, nullptr);
+            }
+        });
+
+    std::string data = "ping";
+    uint64_t respondedAt = 0;
+    std::string response;
+    client->asyncSendMessageByNodeID(moduleID, server->nodeID(),
+        bytesConstRef((byte*)data.data(), data.size()), 0,
+        [&](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef _data, const std::string&,
+            std::function<void(bytesConstRef)>) {
+            BOOST_CHECK(_error == nullptr);
+            response = _data.toString();
+            respondedAt = network->now();
+        });
+    network->runUntilIdle();
+    BOOST_CHECK_EQUAL(response, data);
+    BOOST_CHECK_EQUAL(respondedAt, 10000);
+    BOOST_CHECK(client->callback().empty());
+    network->clear();
+}
+
+BOOST_AUTO_TEST_CASE(testSimNetwork_timeouts)
+{
+    auto network = std::make_shared<SimNetwork>(5);
+    auto client = addFront(network, "sim.client");
+    auto server = addFront(network, "sim.server");
+    network->connectAll(g_groupID);
+    LinkProfile profile;
+    profile.latency = 1000;
+    profile.loss = 1;
+    network->setLink(client->nodeID(), server->nodeID(), profile);
+
+    // every request is lost and times out 10s later, without waiting for the wall clock
+    int moduleID = 5003;
+    size_t requests = 100000;
+    size_t timeouts = 0;
+    uint64_t timeoutAt = 0;
+    std::string data = "lost";
+    auto start = utcSteadyTime();
+    for (size_t i = 0; i < requests; ++i)
+    {
+        client->asyncSendMessageByNodeID(moduleID, server->nodeID(),
+            bytesConstRef((byte*)data.data(), data.size()), 10000,
+            [&](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef, const std::string&,
+                std::function<void(bytesConstRef)>) {
+                if (_error && _error->errorCode() == bcos::protocol::CommonError::TIMEOUT)
+                {
+                    timeouts++;
+                    timeoutAt = network->now();
+                }
+            });
+    }
+    BOOST_CHECK_EQUAL(network->runUntil(9999999), 0);
+    BOOST_CHECK_EQUAL(timeouts, 0);
+    BOOST_CHECK_EQUAL(network->runUntil(10000000), requests);
+    BOOST_CHECK_EQUAL(timeouts, requests);
+    BOOST_CHECK_EQUAL(timeoutAt, 10000000);
+    BOOST_CHECK(client->callback().empty());
+    BOOST_CHECK_EQUAL(network->stats().lost, requests);
+    BOOST_TEST_MESSAGE("timeouts of " << requests << " requests simulated in "
+                                      << utcSteadyTime() - start << "ms");
+    network->clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
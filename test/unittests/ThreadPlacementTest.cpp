@@ -0,0 +1,139 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the placement of the front threads
+ * @file ThreadPlacementTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include "FakeGateway.h"
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/libutilities/Exceptions.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/FrontServiceFactory.h>
+#include <bcos-front/ThreadPlacement.h>
+#include <boost/test/unit_test.hpp>
+#include <future>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+using namespace bcos::front::test;
+
+namespace
+{
+// the cpus the test process may run on
+CpuSet allowedCpus()
+{
+    CpuSet cpus;
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+    {
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpuSet))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(ThreadPlacementTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testParseCpuList)
+{
+    BOOST_CHECK(parseCpuList("").empty());
+    BOOST_CHECK(parseCpuList("3") == CpuSet({3}));
+    BOOST_CHECK(parseCpuList("0-3,8,10-11\n") == CpuSet({0, 1, 2, 3, 8, 10, 11}));
+    // sorted and deduplicated
+    BOOST_CHECK(parseCpuList("4,0-1,1") == CpuSet({0, 1, 4}));
+    BOOST_CHECK_THROW(parseCpuList("0-x"), InvalidParameter);
+}
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(testPlaceThreadPool)
+{
+    auto cpus = allowedCpus();
+    BOOST_REQUIRE(!cpus.empty());
+    CpuSet lastCpu = {cpus.back()};
+
+    std::thread thread([&lastCpu]() {
+        BOOST_CHECK(pinCurrentThread(lastCpu));
+        BOOST_CHECK(sched_getcpu() == (int)lastCpu.front());
+        // best effort, no NUMA topology in some containers
+        placeCurrentThread(lastCpu, true);
+    });
+    thread.join();
+    BOOST_CHECK(!pinCurrentThread(CpuSet()));
+
+    auto threadPool = std::make_shared<ThreadPool>("placement", 3);
+    BOOST_CHECK_EQUAL(placeThreadPool(threadPool, 3, lastCpu, false), 3);
+    for (int i = 0; i < 10; ++i)
+    {
+        std::promise<int> cpu;
+        threadPool->enqueue([&cpu]() { cpu.set_value(sched_getcpu()); });
+        BOOST_CHECK_EQUAL(cpu.get_future().get(), (int)lastCpu.front());
+    }
+    // fewer workers than requested, the placement gives up after the timeout
+    auto smallPool = std::make_shared<ThreadPool>("placement", 1);
+    BOOST_CHECK_EQUAL(placeThreadPool(smallPool, 2, lastCpu, false, 50), 1);
+    smallPool->stop();
+    threadPool->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testFrontServiceFactory_placement)
+{
+    auto cpus = allowedCpus();
+    BOOST_REQUIRE(!cpus.empty());
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto gateway = std::make_shared<FakeGateway>();
+    auto factory = std::make_shared<FrontServiceFactory>();
+    factory->setGatewayInterface(gateway);
+    ThreadPlacementPolicy placement;
+    placement.ioCpus = {cpus.front()};
+    placement.workerCpus = {cpus.back()};
+    placement.workerThreads = 2;
+    factory->setThreadPlacement(placement);
+    auto frontService = factory->buildFrontService(
+        "group", keyFactory->createKey(bytesConstRef((const byte*)"a", 1)));
+    // the factory created the dispatch workers
+    BOOST_REQUIRE(factory->threadPool());
+    BOOST_CHECK(frontService->threadPool() == factory->threadPool());
+    BOOST_CHECK(frontService->threadPlacement().ioCpus == placement.ioCpus);
+
+    std::promise<int> cpu;
+    factory->threadPool()->enqueue([&cpu]() { cpu.set_value(sched_getcpu()); });
+    BOOST_CHECK_EQUAL(cpu.get_future().get(), (int)cpus.back());
+
+    // the io thread runs the timers
+    frontService->start();
+    std::promise<int> ioCpu;
+    frontService->ioService()->post([&ioCpu]() { ioCpu.set_value(sched_getcpu()); });
+    BOOST_CHECK_EQUAL(ioCpu.get_future().get(), (int)cpus.front());
+    frontService->stop();
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
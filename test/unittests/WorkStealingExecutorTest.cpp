@@ -0,0 +1,190 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the work stealing executor
+ * @file WorkStealingExecutorTest.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include "FakeGateway.h"
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/testutils/TestPromptFixture.h>
+#include <bcos-front/FrontServiceFactory.h>
+#include <bcos-front/WorkStealingExecutor.h>
+#include <boost/test/unit_test.hpp>
+#include <future>
+
+using namespace bcos;
+using namespace bcos::test;
+using namespace bcos::front;
+using namespace bcos::front::test;
+
+BOOST_FIXTURE_TEST_SUITE(WorkStealingExecutorTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(testWorkStealingExecutor_fanIn)
+{
+    auto executor = std::make_shared<WorkStealingExecutor>(4);
+    BOOST_CHECK_EQUAL(executor->workerThreads(), 4);
+    BOOST_CHECK_EQUAL(executor->currentWorker(), -1);
+
+    size_t producers = 4;
+    size_t tasks = 10000;
+    std::atomic<size_t> executed(0);
+    std::promise<void> done;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producers; ++i)
+    {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < tasks; ++j)
+            {
+                executor->enqueue([&]() {
+                    if (++executed == producers * tasks)
+                    {
+                        done.set_value();
+                    }
+                });
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    done.get_future().get();
+    BOOST_CHECK_EQUAL(executed, producers * tasks);
+    executor->stop();
+    BOOST_CHECK_EQUAL(executor->executed(), producers * tasks);
+}
+
+BOOST_AUTO_TEST_CASE(testWorkStealingExecutor_continuation)
+{
+    auto executor = std::make_shared<WorkStealingExecutor>(2);
+    std::promise<std::pair<int64_t, int64_t>> workers;
+    executor->enqueue([&]() {
+        auto worker = executor->currentWorker();
+        BOOST_CHECK(worker >= 0);
+        // runs right after this task on this worker
+        executor->enqueueContinuation([&, worker]() {
+            workers.set_value(std::make_pair(worker, executor->currentWorker()));
+        });
+    });
+    auto result = workers.get_future().get();
+    BOOST_CHECK_EQUAL(result.first, result.second);
+    BOOST_CHECK_EQUAL(executor->continued(), 1);
+
+    // outside the workers it is a plain task
+    std::promise<void> plain;
+    executor->enqueueContinuation([&plain]() { plain.set_value(); });
+    plain.get_future().get();
+    BOOST_CHECK_EQUAL(executor->continued(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testWorkStealingExecutor_steal)
+{
+    auto executor = std::make_shared<WorkStealingExecutor>(2);
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> executed(0);
+    std::promise<void> done;
+    // this task itself may be stolen
+    std::atomic<uint64_t> stolen(0);
+    executor->enqueue([&]() {
+        stolen = executor->stolen();
+        // queued on the deque of this worker, which blocks until the other one ran them all
+        for (int i = 0; i < 10; ++i)
+        {
+            executor->enqueue([&]() {
+                if (++executed == 10)
+                {
+                    done.set_value();
+                }
+            });
+        }
+        released.wait();
+    });
+    done.get_future().get();
+    BOOST_CHECK_EQUAL(executor->stolen() - stolen, 10);
+    release.set_value();
+    executor->stop();
+}
+
+BOOST_AUTO_TEST_CASE(testWorkStealingExecutor_stopByTask)
+{
+    // stopped by a task, the worker is joined by the destructor
+    auto executor = std::make_shared<WorkStealingExecutor>(2);
+    std::promise<void> stopped;
+    executor->enqueue([&]() {
+        executor->stop();
+        stopped.set_value();
+    });
+    stopped.get_future().get();
+    executor.reset();
+
+    // destroyed by the last reference, released by a task
+    executor = std::make_shared<WorkStealingExecutor>(2);
+    std::promise<void> released;
+    auto future = released.get_future();
+    executor->enqueue([executor, &released]() mutable {
+        executor.reset();
+        released.set_value();
+    });
+    executor.reset();
+    future.get();
+}
+
+BOOST_AUTO_TEST_CASE(testWorkStealingExecutor_frontService)
+{
+    auto executor = std::make_shared<WorkStealingExecutor>(2);
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    auto gateway = std::make_shared<FakeGateway>();
+    auto factory = std::make_shared<FrontServiceFactory>();
+    factory->setGatewayInterface(gateway);
+    factory->setExecutor(executor);
+    auto frontService =
+        factory->buildFrontService("group", keyFactory->createKey(bytesConstRef((byte*)"ws", 2)));
+    frontService->start();
+    gateway->setFrontService(frontService);
+    BOOST_CHECK(frontService->executor() == executor);
+
+    int moduleID = 1019;
+    std::weak_ptr<FrontService> weakFront = frontService;
+    frontService->registerModuleMessageDispatcher(moduleID,
+        [&, weakFront](
+            bcos::crypto::NodeIDPtr _nodeID, const std::string& _uuid, bytesConstRef _data) {
+            BOOST_CHECK(executor->currentWorker() >= 0);
+            if (auto front = weakFront.lock())
+            {
+                front->asyncSendResponse(_uuid, moduleID, _nodeID, _data, nullptr);
+            }
+        });
+    std::promise<int64_t> responded;
+    std::string data = "ping";
+    frontService->asyncSendMessageByNodeID(moduleID,
+        keyFactory->createKey(bytesConstRef((byte*)"peer", 4)),
+        bytesConstRef((byte*)data.data(), data.size()), 10000,
+        [&](Error::Ptr _error, bcos::crypto::NodeIDPtr, bytesConstRef _data, const std::string&,
+            std::function<void(bytesConstRef)>) {
+            BOOST_CHECK(_error == nullptr);
+            BOOST_CHECK_EQUAL(_data.toString(), data);
+            responded.set_value(executor->currentWorker());
+        });
+    // the response sent by the dispatch task continues on its worker
+    BOOST_CHECK(responded.get_future().get() >= 0);
+    BOOST_CHECK_EQUAL(executor->continued(), 1);
+    frontService->stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief decode a flight recorder dump into per-request timelines
+ * @file flight-record-decoder.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-front/FlightRecorder.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace bcos;
+using namespace bcos::front;
+
+static const char* eventName(FlightEvent _event)
+{
+    switch (_event)
+    {
+    case FlightEvent::Send:
+        return "send";
+    case FlightEvent::Receive:
+        return "receive";
+    case FlightEvent::DispatchStart:
+        return "dispatch-start";
+    case FlightEvent::DispatchEnd:
+        return "dispatch-end";
+    case FlightEvent::Response:
+        return "response";
+    case FlightEvent::Timeout:
+        return "timeout";
+    case FlightEvent::Expired:
+        return "expired";
+    case FlightEvent::Shed:
+        return "shed";
+    case FlightEvent::Cancel:
+        return "cancel";
+    default:
+        return "unknown";
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <dump file> [min duration in us]" << std::endl;
+        return 1;
+    }
+    std::ifstream in(argv[1], std::ios::binary);
+    FlightDump dump;
+    if (!in || !FlightRecorder::load(in, dump))
+    {
+        std::cerr << "invalid flight recorder dump: " << argv[1] << std::endl;
+        return 1;
+    }
+    double minDuration = argc > 2 ? std::stod(argv[2]) : 0;
+    auto ticksPerUs = dump.ticksPerSecond > 0 ? dump.ticksPerSecond / 1e6 : 1;
+
+    auto timelines = FlightRecorder::buildTimelines(dump.records);
+    std::cout << "records: " << dump.records.size() << ", requests: " << timelines.size()
+              << ", ticks/s: " << std::fixed << std::setprecision(0) << dump.ticksPerSecond
+              << std::endl;
+    for (auto const& timeline : timelines)
+    {
+        auto const& records = timeline.second;
+        auto begin = records.front().timestamp;
+        auto duration = (records.back().timestamp - begin) / ticksPerUs;
+        if (duration < minDuration)
+        {
+            continue;
+        }
+        std::cout << "request " << std::hex << timeline.first << std::dec << " duration(us) "
+                  << std::setprecision(1) << duration << std::endl;
+        for (auto const& record : records)
+        {
+            std::cout << "  +" << std::setw(12) << std::setprecision(1)
+                      << (record.timestamp - begin) / ticksPerUs << "us " << std::setw(15)
+                      << eventName(record.event) << " module=" << record.moduleID
+                      << " peer=" << record.peerIndex << " size=" << record.size << std::endl;
+        }
+    }
+    return 0;
+}
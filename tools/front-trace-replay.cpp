@@ -0,0 +1,159 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief replay a captured trace into a front service through a stand-in gateway
+ * @file front-trace-replay.cpp
+ * @author: octopus
+ * @date 2026-10-18
+ */
+
+#include <bcos-crypto/signature/key/KeyFactoryImpl.h>
+#include <bcos-framework/interfaces/gateway/GatewayInterface.h>
+#include <bcos-front/FrontMessage.h>
+#include <bcos-front/FrontServiceFactory.h>
+#include <bcos-front/TraceReplayer.h>
+#include <iostream>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::front;
+
+// swallow everything the front sends, the responses of the replayed requests included
+class StandInGateway : public gateway::GatewayInterface
+{
+public:
+    void start() override {}
+    void stop() override {}
+    void asyncGetPeers(std::function<void(
+            Error::Ptr, bcos::gateway::GatewayInfo::Ptr, bcos::gateway::GatewayInfosPtr)>) override
+    {}
+    void asyncGetNodeIDs(const std::string&, GetNodeIDsFunc) override {}
+    void asyncSendMessageByNodeID(const std::string&, bcos::crypto::NodeIDPtr,
+        bcos::crypto::NodeIDPtr, bytesConstRef _payload,
+        bcos::gateway::ErrorRespFunc _errorRespFunc) override
+    {
+        m_sentFrames++;
+        m_sentBytes += _payload.size();
+        if (_errorRespFunc)
+        {
+            _errorRespFunc(nullptr);
+        }
+    }
+    void asyncSendMessageByNodeIDs(const std::string&, bcos::crypto::NodeIDPtr,
+        const bcos::crypto::NodeIDs& _dstNodeIDs, bytesConstRef _payload) override
+    {
+        m_sentFrames += _dstNodeIDs.size();
+        m_sentBytes += _payload.size() * _dstNodeIDs.size();
+    }
+    void asyncSendBroadcastMessage(
+        const std::string&, bcos::crypto::NodeIDPtr, bytesConstRef _payload) override
+    {
+        m_sentFrames++;
+        m_sentBytes += _payload.size();
+    }
+    void asyncNotifyGroupInfo(
+        bcos::group::GroupInfo::Ptr, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncSendMessageByTopic(const std::string&, bcos::bytesConstRef,
+        std::function<void(bcos::Error::Ptr&&, int16_t, bytesPointer)>) override
+    {}
+    void asyncSendBroadbastMessageByTopic(const std::string&, bcos::bytesConstRef) override {}
+    void asyncSubscribeTopic(
+        std::string const&, std::string const&, std::function<void(Error::Ptr&&)>) override
+    {}
+    void asyncRemoveTopic(std::string const&, std::vector<std::string> const&,
+        std::function<void(Error::Ptr&&)>) override
+    {}
+
+    std::atomic<uint64_t> m_sentFrames = {0};
+    std::atomic<uint64_t> m_sentBytes = {0};
+};
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <trace file> [speed, 0 as fast as possible]"
+                  << " [thread count]" << std::endl;
+        return 1;
+    }
+    double speed = argc > 2 ? std::stod(argv[2]) : 1;
+    size_t threadCount = argc > 3 ? std::stoul(argv[3]) : 4;
+
+    auto trace = std::make_shared<FrameTrace>(argv[1]);
+    auto keyFactory = std::make_shared<bcos::crypto::KeyFactoryImpl>();
+    TraceReplayer replayer(
+        trace, [keyFactory](bytesConstRef _nodeID) { return keyFactory->createKey(_nodeID); });
+
+    // a dispatcher counting the messages of every module found in the trace
+    std::map<uint16_t, std::atomic<uint64_t>> dispatched;
+    uint64_t expected = 0;
+    FrontMessage message;
+    for (auto const& frame : trace->frames())
+    {
+        if (message.decode(frame.frame) == MessageDecodeStatus::MESSAGE_COMPLETE &&
+            !message.isResponse())
+        {
+            dispatched.emplace(message.moduleID(), 0);
+            expected++;
+        }
+    }
+
+    auto gateway = std::make_shared<StandInGateway>();
+    auto factory = std::make_shared<FrontServiceFactory>();
+    factory->setGatewayInterface(gateway);
+    factory->setThreadPool(std::make_shared<ThreadPool>("replay", threadCount));
+    auto frontService = factory->buildFrontService(
+        "replay", keyFactory->createKey(bytesConstRef((const byte*)"replay", 6)));
+    for (auto& entry : dispatched)
+    {
+        auto& counter = entry.second;
+        frontService->registerModuleMessageDispatcher(entry.first,
+            [&counter](bcos::crypto::NodeIDPtr, const std::string&, bytesConstRef) {
+                counter++;
+            });
+    }
+    frontService->start();
+
+    auto result = replayer.replay(frontService, "replay", speed);
+    // wait for the dispatchers to drain the queued messages
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        uint64_t total = 0;
+        for (auto const& entry : dispatched)
+        {
+            total += entry.second;
+        }
+        if (total >= expected)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    frontService->stop();
+
+    std::cout << "frames: " << result.frames << ", trace span(us): " << result.traceSpan
+              << ", elapsed(us): " << result.elapsed << ", frames/s: "
+              << (result.elapsed ? result.frames * 1e6 / result.elapsed : 0) << std::endl;
+    std::cout << "sent by the front: " << gateway->m_sentFrames << " frames, "
+              << gateway->m_sentBytes << " bytes" << std::endl;
+    for (auto const& entry : dispatched)
+    {
+        std::cout << "  module " << entry.first << ": " << entry.second << " dispatched"
+                  << std::endl;
+    }
+    return 0;
+}